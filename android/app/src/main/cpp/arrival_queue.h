@@ -0,0 +1,106 @@
+#ifndef ARRIVAL_QUEUE_H
+#define ARRIVAL_QUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+
+#include "audio_config.h"
+
+// Single-producer, single-consumer queue of inbound VoiceFrames for one
+// peer: (seq, senderTsMs, local arrival time, Opus payload), copied into
+// fixed slots.
+//
+// **Why.** The receive thread used to push straight into the peer's jitter
+// buffer under PeerState::mutex — the same lock the mixer tick holds across
+// Opus decode, FEC, PLC and the VAD RMS — so a burst of arrivals could stall
+// a receive thread for the length of a decode. Now the receive thread only
+// enqueues here, without locking, and the mixer tick drains the queue into
+// the jitter buffer at the start of the peer's decode step. The jitter
+// buffer is touched by one side only.
+//
+// **Producer.** A link has one receive thread, but a reconnect can briefly
+// overlap the old link's thread with the new one's, so push() takes a
+// spin flag. It is uncontended outside that overlap, and never shared with
+// the consumer.
+//
+// **Consumer.** Whoever holds PeerState::mutex — the mixer tick, or a
+// receive thread in decode-on-arrival mode (which drains its own frame
+// immediately so it can decode it). The mutex serializes them.
+class ArrivalQueue {
+public:
+    static constexpr size_t kCapacity = audio_config::kArrivalQueueSlots;
+    static constexpr size_t kMaxPayloadBytes = audio_config::kArrivalMaxPayloadBytes;
+    static_assert((kCapacity & (kCapacity - 1)) == 0,
+                  "kCapacity must be a power of two so we can use a mask");
+
+    struct Arrival {
+        uint32_t seq;
+        uint32_t senderTsMs;
+        int64_t recvMs;
+        size_t size;
+        uint8_t payload[kMaxPayloadBytes];
+    };
+
+    // Copy one frame in. Lock-free against the consumer; allocates nothing.
+    // False (and counted) if the queue is full — the mixer has fallen
+    // kCapacity frames behind — or the payload won't fit a slot.
+    bool push(uint32_t seq, uint32_t senderTsMs, int64_t recvMs,
+              const uint8_t* payload, size_t size) {
+        if (size == 0 || size > kMaxPayloadBytes) {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        while (pushing_.test_and_set(std::memory_order_acquire)) {
+            std::this_thread::yield();
+        }
+        const size_t w = writeIdx_.load(std::memory_order_relaxed);
+        const size_t r = readIdx_.load(std::memory_order_acquire);
+        bool ok = false;
+        if (w - r < kCapacity) {
+            Arrival& a = slots_[w & (kCapacity - 1)];
+            a.seq = seq;
+            a.senderTsMs = senderTsMs;
+            a.recvMs = recvMs;
+            a.size = size;
+            std::memcpy(a.payload, payload, size);
+            writeIdx_.store(w + 1, std::memory_order_release);
+            ok = true;
+        }
+        pushing_.clear(std::memory_order_release);
+        if (!ok) dropped_.fetch_add(1, std::memory_order_relaxed);
+        return ok;
+    }
+
+    // Oldest queued frame, or nullptr when empty. Valid until pop().
+    const Arrival* front() const {
+        const size_t r = readIdx_.load(std::memory_order_relaxed);
+        if (r == writeIdx_.load(std::memory_order_acquire)) return nullptr;
+        return &slots_[r & (kCapacity - 1)];
+    }
+
+    void pop() {
+        readIdx_.store(readIdx_.load(std::memory_order_relaxed) + 1,
+                       std::memory_order_release);
+    }
+
+    // Discard everything queued so far (consumer side).
+    void clear() {
+        readIdx_.store(writeIdx_.load(std::memory_order_acquire),
+                       std::memory_order_release);
+    }
+
+    // Frames refused by push(): queue full or oversized payload.
+    uint64_t droppedCount() const { return dropped_.load(std::memory_order_relaxed); }
+
+private:
+    Arrival slots_[kCapacity];
+    std::atomic<size_t> writeIdx_{0};
+    std::atomic<size_t> readIdx_{0};
+    std::atomic_flag pushing_ = ATOMIC_FLAG_INIT;
+    std::atomic<uint64_t> dropped_{0};
+};
+
+#endif  // ARRIVAL_QUEUE_H
@@ -47,18 +47,165 @@ static_assert(kPlayoutSampleRate % kCodecSampleRate == 0,
               "playout rate must be an integer multiple of codec rate");
 constexpr int kResampleRatio = kPlayoutSampleRate / kCodecSampleRate;  // 2
 
-// Default Opus parameters. The three operating points are what the dynamic
-// bitrate scaler picks between based on link telemetry — a future PR wires
-// LinkQuality reports to this; today the encoder starts at kBitrateMid and
-// nothing adjusts it yet. BLE L2CAP CoC sustains well over 100 kbps, so these
-// are sized for quality first: even kBitrateHigh (48 kbps) is a fraction of
-// the link budget. Opus at 24 kHz / 32 kbps is transparent for speech.
+// Default Opus parameters. The encoder starts at kBitrateMid and the per-peer
+// BitrateController (bitrate_controller.h) moves it within
+// [kBitrateLow, kBitrateHigh]. BLE L2CAP CoC sustains well over 100 kbps, so
+// these are sized for quality first: even kBitrateHigh (48 kbps) is a
+// fraction of the link budget. Opus at 24 kHz / 32 kbps is transparent for
+// speech.
 constexpr int kBitrateLow = 16000;    // degraded link
 constexpr int kBitrateMid = 32000;    // default — transparent super-wideband
 constexpr int kBitrateHigh = 48000;   // best link, fullband-grade voice
 constexpr int kDefaultBitrate = kBitrateMid;
 constexpr int kMaxOpusPacketSize = 4000;
 
+// L2CAP voice stream framing (docs/protocol.md, "VoiceFrame"; mirrors
+// LENGTH_PREFIX_SIZE / MAX_FRAME_SIZE in L2capVoiceTransport.kt). A 2-byte
+// big-endian length prefix, then a VoiceFrame of that many bytes: 8-byte
+// header (seq, senderTsMs) plus the Opus payload.
+constexpr size_t kVoiceFrameLengthPrefixBytes = 2;
+constexpr size_t kVoiceFrameHeaderBytes = 8;
+constexpr size_t kVoiceFrameMaxBytes = 4096;
+static_assert(kVoiceFrameMaxBytes >= kVoiceFrameHeaderBytes + kMaxOpusPacketSize,
+              "a VoiceFrame must fit the largest Opus packet");
+
+// Per-peer outbound ring (outbound_frame_ring.h): wire-ready VoiceFrames
+// waiting for the peer's L2CAP writer thread.
+//   - kOutboundSlotBytes=512 → prefix + header + up to 502 bytes of Opus,
+//     ~200 kbps at 20 ms; the encoder is capped to the slot, and even
+//     kBitrateHigh peaks nowhere near it.
+//   - kOutboundRingSlots=8 slots; the writer keeps only the newest
+//     kOutboundQueueFrames=6 (~120 ms) of them, so a stalled link can't
+//     turn the ring into a latency backlog.
+//   - kOutboundStaleBudgetMs=200 → a frame that waited longer than this for
+//     the wire is shed rather than sent.
+constexpr size_t kOutboundSlotBytes = 512;
+constexpr size_t kOutboundRingSlots = 8;
+constexpr size_t kOutboundQueueFrames = 6;
+constexpr int64_t kOutboundStaleBudgetMs = 200;
+static_assert(kOutboundQueueFrames <= kOutboundRingSlots,
+              "the writer's backlog cap must fit in the ring");
+static_assert(kOutboundSlotBytes <= kVoiceFrameLengthPrefixBytes + kVoiceFrameMaxBytes,
+              "an outbound slot must hold no more than one legal VoiceFrame");
+
+// Multi-frame VoiceFrames ("bundles", voice_bundle.h): up to kMaxBundleFrames
+// consecutive 20 ms frames in one VoiceFrame, so one SDU, one ring slot and
+// one socket write carry 40 or 60 ms of audio. Payload layout:
+//   [0xFF 0x00] [count] [len uint16 BE] × (count - 1) [frame] × count
+// 0xFF 0x00 is a code-3 Opus TOC with a frame count of zero, which RFC 6716
+// forbids, so a bundle can never be mistaken for an Opus packet. The header's
+// seq and senderTsMs are the first frame's; frame i is seq + i, encoded
+// kFrameDurationMs × i later (the frames' own durations, from their TOCs,
+// under the low-latency profile).
+//
+// A peer only sends bundles after the other end has offered to unpack them,
+// in-band: a link-control frame — a header-only VoiceFrame, which receivers
+// that predate it drop (see the protocol doc) — whose seq field is
+// kLinkControlBundleOffer and whose senderTsMs is the most frames per bundle
+// it accepts. Each side re-offers every kBundleOfferIntervalTicks (5 s), so
+// an offer shed from a backed-up ring costs a few seconds, not the link.
+//
+// How many frames to bundle is the link's BitrateController's call: more on
+// congestion (fewer, fuller SDUs), fewer when the link is clean, and never
+// more than the inbound lag leaves room for under kBundleLagBudgetMs — each
+// extra frame per bundle is 20 ms of added latency.
+constexpr size_t kMaxBundleFrames = 3;
+constexpr uint8_t kBundleMagic0 = 0xFF;
+constexpr uint8_t kBundleMagic1 = 0x00;
+constexpr size_t kBundleHeaderBytes = 3;  // magic + count
+constexpr size_t kBundleLengthBytes = 2;  // per frame but the last
+constexpr uint32_t kLinkControlBundleOffer = 1;
+constexpr int kBundleOfferIntervalTicks = 250;
+constexpr int64_t kBundleLagBudgetMs = 80;
+// Each frame of a bundle is encoded into its share of one ring slot.
+constexpr size_t kBundleFrameMaxBytes =
+    (kOutboundSlotBytes - kVoiceFrameLengthPrefixBytes - kVoiceFrameHeaderBytes -
+     kBundleHeaderBytes - kBundleLengthBytes * (kMaxBundleFrames - 1)) /
+    kMaxBundleFrames;
+static_assert(kMaxBundleFrames >= 2 && kMaxBundleFrames <= 255,
+              "a bundle's frame count is one byte, and bundling needs two");
+static_assert(kBundleFrameMaxBytes * 8 * 1000 / kFrameDurationMs >=
+                  static_cast<size_t>(kBitrateHigh),
+              "a bundled frame's share of the slot must carry kBitrateHigh");
+
+// Compact VoiceFrame header (voice_header.h). The 8-byte header costs 20 %
+// of a 40-byte frame at kBitrateLow, and almost all of it is predictable:
+// seq steps by one and senderTsMs by kFrameDurationMs. Once the peer has
+// offered to decode them — link-control opcode kLinkControlCompactHeaderOffer,
+// argument the highest header version it reads — a sender may replace the
+// header with kCompactHeaderBytes:
+//   [seq low 8 bits] [senderTsMs low 16 bits, BE]
+// flagged by kCompactHeaderFlag in the length prefix (a legal frame length
+// never reaches it). The receiver extends both back to 32 bits from the last
+// frame it got: seq to the nearest value with those low bits, senderTsMs to
+// the nearest one to that frame's + kFrameDurationMs per seq step. That
+// holds while a frame is within ±127 seqs and ±32 s of its predecessor, so
+// the sender sends a full header whenever a frame strays past
+// kCompactMaxSeqStep or kCompactMaxTsSkewMs (a pause, a bundle), whenever
+// the receiver may have missed frames (a drop, a new writer), and at least
+// every kCompactResyncFrames frames.
+constexpr uint16_t kCompactHeaderFlag = 0x8000;
+constexpr size_t kCompactHeaderBytes = 3;
+constexpr uint32_t kLinkControlCompactHeaderOffer = 2;
+constexpr uint32_t kCompactHeaderVersion = 1;
+constexpr uint32_t kCompactResyncFrames = 50;
+constexpr uint32_t kCompactMaxSeqStep = 64;
+constexpr int64_t kCompactMaxTsSkewMs = 8000;
+static_assert(kVoiceFrameMaxBytes < kCompactHeaderFlag,
+              "the compact flag must sit above every legal frame length");
+static_assert(kCompactMaxSeqStep < 128 && kCompactMaxTsSkewMs < 32768,
+              "the sender's limits must sit inside the receiver's window");
+
+// Outbound backpressure. Before encoding for a peer, the mixer tick reads its
+// outbound ring. With kOutboundCongestedFrames (60 ms) or more still queued,
+// or the oldest queued frame kOutboundCongestedAgeMs old, the writer isn't
+// keeping up: the tick skips that peer's encode — a frame it would only queue
+// behind the backlog, or shed — and turns its inband FEC off, since LBRR
+// bits are a luxury on a link that can't carry the primary stream. The seq
+// doesn't advance over a skip, so the receiver sees a short underrun rather
+// than network loss. Encoding resumes once the queue is down to
+// kOutboundDecongestedFrames with nothing that old in it.
+constexpr size_t kOutboundCongestedFrames = 3;
+constexpr int64_t kOutboundCongestedAgeMs = 60;
+constexpr size_t kOutboundDecongestedFrames = 1;
+static_assert(kOutboundDecongestedFrames < kOutboundCongestedFrames &&
+                  kOutboundCongestedFrames < kOutboundQueueFrames,
+              "backpressure must engage before the writer trims its backlog");
+static_assert(kOutboundCongestedAgeMs < kOutboundStaleBudgetMs,
+              "backpressure must engage before frames go stale");
+
+// Per-peer bitrate control (bitrate_controller.h), run from the mixer tick
+// every kBitrateControlTicks (300 ms) — a few BLE connection intervals, so a
+// backlog is answered while it is still a handful of frames.
+//   - Overuse: the outbound ring congested or skipping encodes, smoothed
+//     loss above kBitrateBackoffLossPct, or playout lag rising by
+//     kBitrateLagRiseMs or more over one interval. The bitrate drops to
+//     kBitrateBackoffPercent of itself, at most once per
+//     kBitrateBackoffSpacingIntervals (the backlog needs that long to clear
+//     before the next look means anything).
+//   - Increase: smoothed loss under kBitrateIncreaseMaxLossPct with frames
+//     flowing and kBitrateIncreaseHoldIntervals (3 s) since the last
+//     backoff: +kBitrateIncreaseStepBps per interval, so Low → High takes
+//     ~10 s of clean link.
+//   - Loss is smoothed by 1/kBitrateLossSmoothing per interval; the same
+//     figure is the encoder's expected-loss hint.
+constexpr int kBitrateControlTicks = 15;
+constexpr int kBitrateBackoffPercent = 75;
+constexpr int kBitrateBackoffSpacingIntervals = 2;
+constexpr int kBitrateIncreaseHoldIntervals = 10;
+constexpr int kBitrateIncreaseStepBps = 1000;
+constexpr double kBitrateBackoffLossPct = 10.0;
+constexpr double kBitrateIncreaseMaxLossPct = 2.0;
+constexpr int kBitrateLossSmoothing = 4;
+constexpr int64_t kBitrateLagRiseMs = 20;
+static_assert(kBitrateBackoffPercent > 0 && kBitrateBackoffPercent < 100,
+              "a backoff must lower the bitrate without zeroing it");
+static_assert(kBitrateBackoffSpacingIntervals <= kBitrateIncreaseHoldIntervals,
+              "a backoff must hold off increases at least as long as the "
+              "next backoff");
+static_assert(kBitrateIncreaseMaxLossPct < kBitrateBackoffLossPct,
+              "the increase and backoff loss thresholds need a dead zone");
+
 // Adaptive jitter buffer bounds. Depth is measured in 20 ms frames.
 //   - kJitterMinDepth=2 → 40 ms playout latency floor (one tick of slack)
 //   - kJitterInitialDepth=3 → 60 ms, the BLE CE-jitter sweet spot
@@ -89,6 +236,17 @@ static_assert(kJitterMinDepth <= kJitterInitialDepth &&
               "jitter thresholds must be ordered: "
               "min <= init <= maxTarget < highWatermark < maxDepth");
 
+// Per-peer inbound queue (arrival_queue.h) between the receive thread and
+// the mixer tick, which drains it every kFrameDurationMs.
+//   - kArrivalQueueSlots=16 → 320 ms of frames: well past one tick's worth
+//     of burst, and past kJitterMaxDepth, so the queue is never what sheds.
+//   - kArrivalMaxPayloadBytes=1275 → the largest single-frame Opus packet
+//     (RFC 6716 §3.2.1).
+constexpr size_t kArrivalQueueSlots = 16;
+constexpr size_t kArrivalMaxPayloadBytes = 1275;
+static_assert(kArrivalQueueSlots > kJitterMaxDepth,
+              "the arrival queue must not shed before the jitter buffer does");
+
 // How often the jitter buffer reviews its target depth, in adapt() calls.
 // adapt() is invoked from the mixer tick (every kFrameDurationMs ms), so
 // 50 calls ≈ 1 second between adaptation decisions.
@@ -99,6 +257,90 @@ constexpr size_t kJitterAdaptIntervalTicks = 50;
 // buffer right back into the ground.
 constexpr size_t kJitterShrinkAfterStableTicks = 500;
 
+// Peer handle table (PeerAudioManager). A peer's device ID doubles as its
+// JNI handle and resolves lock-free through a fixed table indexed by
+// `id % kPeerHandleSlots`; this bounds the number of simultaneously
+// registered peers. Twice the mixer's kMaxDevices, so a free slot is always
+// near the next ID. Power of two, so the index is a mask.
+constexpr size_t kPeerHandleSlots = 16;
+static_assert((kPeerHandleSlots & (kPeerHandleSlots - 1)) == 0,
+              "kPeerHandleSlots must be a power of two");
+
+// Warm pool (PeerAudioManager, AudioMixer). A join used to build its peer's
+// state from scratch under the registry lock: an Opus encoder and decoder,
+// a jitter buffer and an outbound ring, and in the mixer a device buffer
+// whose ring is zeroed — the last under the lock the playout callback takes.
+// Now a join takes a ready-built spare, leaving only the registry maps'
+// bookkeeping under the lock, and the spare is replaced once the lock is
+// let go. That covers the first kPeerWarmSpares joins in quick succession:
+// one more before the spares are rebuilt builds its state under the lock,
+// as before. The spares are ordinary heap objects, not slots of a
+// contiguous arena. Two cover a reconnect racing a join; more would sit
+// idle in a two-phone room.
+constexpr size_t kPeerWarmSpares = 2;
+
+// How far the drift resampler may move a peer's playout speed off 1.0,
+// everything it does counted: 3 %, about half a semitone, past which the
+// pitch shift is heard. Anything that needs to move audio faster than that
+// (the high-watermark drain, pre-roll catch-up) compresses time by
+// crossfade-merging frames instead, which keeps pitch.
+constexpr double kResamplerMaxSpeedDeviation = 0.03;
+
+// Fast first audio. A cold-started jitter buffer (new peer, reconnect, idle
+// park) releases its first frame once kJitterFastStartDepth frames are queued
+// instead of waiting for the full target, then ramps up to the target while
+// playing: until the buffer first reaches the target, the peer's drift
+// resampler consumes at kJitterRampStretchStep input samples per output, so
+// each tick plays ~2.5 % more audio than it takes in and the buffer gains one
+// frame roughly every 40 ticks (800 ms) — under half a semitone of pitch for
+// a second and a half or so, instead of 40 ms of silence before the first
+// word. With drift correction on top it stays inside
+// kResamplerMaxSpeedDeviation. Setting the start depth to
+// kJitterInitialDepth turns fast start off.
+constexpr size_t kJitterFastStartDepth = 1;
+constexpr double kJitterRampStretchStep = 0.975;
+
+static_assert(kJitterFastStartDepth >= 1 &&
+                  kJitterFastStartDepth <= kJitterInitialDepth,
+              "fast start must release no later than a normal cold start");
+static_assert(kJitterRampStretchStep < 1.0 &&
+                  kJitterRampStretchStep >= 1.0 - kResamplerMaxSpeedDeviation,
+              "the ramp stretch must stay inside the resampler's speed limit");
+
+// Warm start after a reconnect. When a peer unregisters (or re-registers over
+// itself), what its link taught us — the jitter buffer's adapted target and
+// stability streak, and the lag estimator's transit baseline — is kept in a
+// small cache keyed by MAC and seeded into the next registration of the same
+// address, so a BLE blip doesn't throw away tens of seconds of adaptation.
+//   - kWarmStartCacheEntries: peers remembered; the oldest entry is evicted.
+//   - kWarmStartMaxAgeMs: a profile older than this is from a different
+//     session in all but name, and is ignored. 2 min.
+//   - kWarmStartLagToleranceMs: the cached baseline is only adopted if the
+//     first frame of the new link sits within this of it. A sender reboot
+//     moves its monotonic epoch by far more; a TX backlog draining after the
+//     blip (exactly what the baseline should expose) by far less.
+constexpr size_t kWarmStartCacheEntries = 8;
+constexpr int64_t kWarmStartMaxAgeMs = 120000;
+constexpr int64_t kWarmStartLagToleranceMs = 5000;
+
+// PLC tail for a peer that stopped sending (muted, between talkspurts, dead
+// link). The first concealed frame plays as Opus synthesised it, so a single
+// lost packet sounds exactly as before; the following frames fade linearly to
+// silence, ending at zero on frame kPlcTailFrames (80 ms of tail, 60 ms of
+// fade). After that the peer goes dormant: no decode, no VAD, no ring writes
+// until its jitter buffer has real frames again.
+constexpr int kPlcTailFrames = 4;
+static_assert(kPlcTailFrames >= 2,
+              "the tail needs at least one faded frame after the first");
+
+// Decode-on-arrival default (PeerAudioManager::setDecodeOnArrival). When on,
+// in-order frames are Opus-decoded on the peer's receive thread as they land
+// in the jitter buffer, and the mixer tick only picks up ready PCM; PLC and
+// FEC still run on the tick, at playout time. Off by default: it moves
+// decode CPU onto the receive threads, which is a win on multi-core devices
+// with several peers and a wash with one.
+constexpr bool kDecodeOnArrival = false;
+
 // Playout anti-bloat (latency catch-up). The per-device mixer ring is the
 // rendezvous between the producer (decode / mic feed, ~50 Hz on a steady_clock)
 // and the consumer (the Oboe playout callback, on the audio *hardware* clock).
@@ -121,6 +363,144 @@ constexpr size_t kPlayoutMaxRingFillSamples =
 // Mixer tick.
 constexpr int kMixerTickIntervalMs = kFrameDurationMs;
 
+// Idle-room handling for the mixer tick. "Quiet" means no peer's decoded
+// audio is over the VAD threshold and the local mic has reported no activity.
+//   - kIdleSuppressAfterTicks: after this many quiet ticks (500 ms — past the
+//     VAD's 300 ms off-hysteresis, so a breath pause doesn't trip it) the
+//     tick stops sending mix-minus frames. The last frames on the wire are
+//     the silent ones that led up to it, so a peer's decoder conceals toward
+//     silence, not toward the last syllable.
+//   - kIdleParkAfterTicks: after this many quiet ticks with no frame arriving
+//     either (2 s), the tick thread parks on a condition variable instead of
+//     waking every 20 ms. It wakes on the next arriving frame, local mic
+//     activity, a registry change, or stop.
+constexpr int kIdleSuppressAfterTicks = 25;
+constexpr int kIdleParkAfterTicks = 100;
+static_assert(kIdleSuppressAfterTicks < kIdleParkAfterTicks,
+              "the tick must stop sending before it parks");
+
+// Silence suppression (PeerAudioManager::setSilenceSuppression; on by
+// default). Idle-room suppression above only stops sending once *nobody* is
+// talking; in a walkie-talkie room someone usually is, and everyone else's
+// mix-minus is then silence they'd decode for nothing. With suppression on,
+// the tick gates each peer's outbound stream on its own mix: a frame over the
+// VAD threshold opens the gate at once (no onset clipping), and
+// kTalkspurtHangoverTicks quiet frames (500 ms, past the VAD's off
+// hysteresis) close it. Inside the hangover Opus DTX codes the background as
+// 1–2 byte packets. When the gate closes the tick sends a link-control frame
+// — opcode kLinkControlTalkspurtEnd, argument the next seq — so the receiver
+// knows the gap is a pause, not jitter or loss (JitterBuffer::expectGap),
+// and fills it with comfort noise instead of silence (comfort_noise.h).
+//   - kComfortNoiseMaxRms: the loudest background comfort noise will copy
+//     (-46 dBFS), safely under the VAD threshold so it never reads as talk.
+//   - kComfortNoiseSmoothing: the background-level EMA, in frames.
+//   - kComfortNoiseHoldFrames / kComfortNoiseFadeFrames: full level for 1 s
+//     of pause, then a 500 ms fade out, finished before an all-quiet room
+//     parks the tick (which would otherwise cut it off).
+constexpr bool kSilenceSuppression = true;
+constexpr int kTalkspurtHangoverTicks = 25;
+constexpr uint32_t kLinkControlTalkspurtEnd = 3;
+constexpr double kComfortNoiseMaxRms = 0.005;
+constexpr double kComfortNoiseSmoothing = 8.0;
+constexpr int kComfortNoiseHoldFrames = 50;
+constexpr int kComfortNoiseFadeFrames = 25;
+static_assert(kComfortNoiseHoldFrames + kComfortNoiseFadeFrames < kIdleParkAfterTicks,
+              "comfort noise must fade out before the tick parks");
+
+// Compressed-domain silence (opus_silence.h). An Opus frame of 0 or 1 bytes
+// after the TOC carries nothing to decode — libopus itself runs concealment
+// for it, which is how DTX reaches a decoder — so a single-frame packet of
+// up to kOpusSilentMaxBytes is silence, known without decoding. The receive
+// path skips the decode, the RMS and the VAD's PCM for it.
+constexpr size_t kOpusSilentMaxBytes = 2;
+
+// Mixer tick scheduling. The tick sleeps to an absolute CLOCK_MONOTONIC
+// deadline, so wake-up latency never accumulates into the cadence.
+//   - kMixerTickNice: the thread's nice value. -16 is Android's
+//     THREAD_PRIORITY_AUDIO, which an ordinary app may set on its own threads.
+//   - kMixerTickFifoPriority: if > 0, first try SCHED_FIFO at this priority
+//     (falls back to the nice value when the kernel refuses, as it does for
+//     untrusted apps). 0 = don't ask.
+constexpr int kMixerTickNice = -16;
+constexpr int kMixerTickFifoPriority = 0;
+
+// Tick-jitter instrumentation (see tick_histogram.h). Wake lateness and tick
+// work are binned at kTickHistBucketUs resolution into kTickHistBuckets
+// buckets (6.4 ms of range — a third of a tick — plus an overflow bucket).
+// Every kTickStatsWindowTicks ticks (5 s) the window's percentiles are
+// published for telemetry and the buckets cleared, so a readout reflects
+// recent scheduling rather than the session's lifetime.
+constexpr uint32_t kTickHistBucketUs = 100;
+constexpr size_t kTickHistBuckets = 64;
+constexpr int kTickStatsWindowTicks = 250;
+
+// Tick CPU governor (tick_governor.h). The tick's work — decode pass, mixing,
+// encode pass — is averaged over kGovernorIntervalTicks (500 ms). Over
+// kGovernorBudgetPct of the tick interval the governor steps one level down
+// the ladder below; under kGovernorRecoverPct for kGovernorRecoverIntervals
+// intervals in a row (2 s) it steps one back up. Between the two it holds.
+//   - kGovernorComplexity: Opus encoder complexity at each level, from the
+//     full 10 the encoder is created with down to 2.
+//   - kGovernorFecOffLevel: from this level on, inband FEC is off.
+//   - kGovernorRmsStrideLevel / kGovernorRmsStride: from this level on, the
+//     per-peer VAD and silence-gate RMS read every kGovernorRmsStride-th
+//     sample — a level estimate, which is all a threshold needs.
+//   - kGovernorProtectLevels: how many levels a protected peer — one that's
+//     talking, or on a weak link (smoothed loss over kGovernorWeakLinkLossPct,
+//     or congested) — trails the rest, so it is the last to be degraded.
+constexpr int kGovernorIntervalTicks = 25;
+constexpr int kGovernorBudgetPct = 50;
+constexpr int kGovernorRecoverPct = 25;
+constexpr int kGovernorRecoverIntervals = 4;
+constexpr int kGovernorComplexity[] = {10, 8, 6, 4, 2};
+constexpr int kGovernorMaxLevel =
+    static_cast<int>(sizeof(kGovernorComplexity) / sizeof(kGovernorComplexity[0])) - 1;
+constexpr int kGovernorFecOffLevel = 3;
+constexpr int kGovernorRmsStrideLevel = 2;
+constexpr int kGovernorRmsStride = 4;
+constexpr int kGovernorProtectLevels = 2;
+constexpr double kGovernorWeakLinkLossPct = 5.0;
+static_assert(kGovernorRecoverPct < kGovernorBudgetPct,
+              "the governor needs a dead band between stepping down and up");
+static_assert(kGovernorMaxLevel - kGovernorProtectLevels < kGovernorFecOffLevel,
+              "a protected peer must keep FEC at every level");
+static_assert(kCodecFrameSize % kGovernorRmsStride == 0,
+              "the RMS stride must divide the frame");
+
+// Low-latency profile (PeerAudioManager::setLowLatencyProfile; off by
+// default). The tick runs on kLowLatencyFrameDurationMs frames instead of
+// kFrameDurationMs: half the Opus framing delay, half the mixer tick, half
+// the playout ring cap — and half the jitter buffer, whose depths are counted
+// in frames. That last is the point and the price: for same-room groups on a
+// clean link, where mouth-to-ear latency is what users notice, and nowhere
+// else, so it is decided per room. Every tick that wants it checks that every
+// peer has offered it — opcode kLinkControlLowLatencyOffer, argument the
+// frame duration in ms the peer wants — and runs on kFrameDurationMs the
+// moment one hasn't. Receivers need no switch: an Opus packet names its own
+// duration (opus_toc.h), so a peer's frames decode whatever length they are.
+// Counts of ticks that stand for wall-clock time (idle, hangover, rate
+// control, telemetry) stretch by kFrameDurationMs / the frame in use.
+constexpr bool kLowLatencyProfile = false;
+constexpr int kLowLatencyFrameDurationMs = 10;
+constexpr int kLowLatencyCodecFrameSize =
+    (kCodecSampleRate * kLowLatencyFrameDurationMs) / 1000;  // 240
+constexpr size_t kLowLatencyPlayoutMaxRingFillSamples =
+    kPlayoutMaxRingFillFrames * static_cast<size_t>(kLowLatencyCodecFrameSize);  // 720
+constexpr uint32_t kLinkControlLowLatencyOffer = 4;
+static_assert(kFrameDurationMs % kLowLatencyFrameDurationMs == 0,
+              "a low-latency frame must divide the default frame");
+static_assert(kLowLatencyCodecFrameSize % kGovernorRmsStride == 0,
+              "the RMS stride must divide the low-latency frame");
+
+// Telemetry board (see telemetry_board.h). The mixer republishes every peer's
+// LinkTelemetry, marshaled to kTelemetryFieldCount ints, once per
+// kTelemetryPublishTicks ticks (100 ms) — ten times finer than the ~1 s
+// pollers, at a tenth of the cost of publishing every tick. The field count
+// is kept in lockstep with PeerAudioManager.TELEMETRY_FIELDS (Kotlin) and
+// LinkTelemetrySnapshot.fieldCount (Dart); new fields are appended.
+constexpr int kTelemetryFieldCount = 26;
+constexpr int kTelemetryPublishTicks = 5;
+
 // End-to-end staleness (Kevin's timestamp-drop). The receiver derives a frame's
 // staleness from the VoiceFrame `senderTsMs` versus local arrival, baselined
 // against a sliding-window minimum to cancel the unknown cross-device clock
@@ -137,6 +517,85 @@ constexpr int kMixerTickIntervalMs = kFrameDurationMs;
 constexpr uint32_t kLagBaselineWindowMs = 5000;
 constexpr uint32_t kStaleDropBudgetMs = 200;
 
+// Clock-drift correction (see clock_drift_estimator.h). The receiver fits the
+// slope of per-block minimum transit against arrival time to learn how many
+// ppm the sender's 50 Hz clock runs off ours, and the decode path resamples
+// that peer's PCM by the same ratio so the jitter buffer stays flat.
+//   - kDriftBlockMs: one minimum-transit sample per second. Long enough that
+//     a block almost always contains a frame that rode an uncongested CE.
+//   - kDriftWindowBlocks: 30 s of history in the fit. With 1 ms timestamp
+//     resolution that resolves the slope to a few ppm.
+//   - kDriftMinBlocks: no correction until 10 s of blocks are in; until then
+//     the crossfade drain / PLC stretch are the only drift handling.
+//   - kDriftMaxCorrectionPpm: real crystals sit within ~±100 ppm; anything
+//     beyond ±500 is a broken timestamp stream, not drift.
+//   - kDriftSmoothing: one-pole weight for each new fit, so a noisy block
+//     nudges the ratio instead of stepping it.
+constexpr uint32_t kDriftBlockMs = 1000;
+constexpr size_t kDriftWindowBlocks = 30;
+constexpr size_t kDriftMinBlocks = 10;
+constexpr double kDriftMaxCorrectionPpm = 500.0;
+constexpr double kDriftSmoothing = 0.2;
+
+static_assert(kDriftMinBlocks >= 2 && kDriftMinBlocks <= kDriftWindowBlocks,
+              "drift fit needs at least two blocks and fits inside the window");
+static_assert(1.0 - kJitterRampStretchStep + kDriftMaxCorrectionPpm * 1e-6 <=
+                  kResamplerMaxSpeedDeviation,
+              "ramp and drift correction together must stay inside the speed limit");
+
+// Push-to-talk pre-roll (PeerAudioManager::setPreRoll; pre_roll_ring.h).
+// With it on, the audio callback keeps the last moments of mic audio, muted
+// or not, and when a talkspurt opens on local voice with the mic keyed, the
+// tick encodes up to kPreRollFrames frames of it ahead of the live frame —
+// the syllable spoken as the key went down, or under the gate's threshold
+// before the first loud frame. The frames carry their capture timestamps
+// and seqs run on into the live stream, so the receiver sees a burst of
+// late audio, which it sheds (below). A sender with the mode on
+// says so with its other offers — opcode kLinkControlPreRollOffer, argument
+// kPreRollFrames, 0 once it turns the mode off.
+//   - kPreRollFrames: 6 frames, 120 ms. Bounded by the receiver: the burst
+//     plus the live frame stays under kJitterHighWatermark (past it the
+//     crossfade drain would merge pre-roll away) and its oldest frame inside
+//     kStaleDropBudgetMs. Sent in the biggest bundles the peer takes, in
+//     no more packets than leave kOutboundQueueFrames room for the live
+//     frame and a control frame; the backpressure gate allows for those
+//     packets, one fewer each tick. A link without bundles so gets at most
+//     kOutboundQueueFrames - 2 frames (80 ms), fewer behind a queue.
+//   - kPreRollRingSamples: the capture ring, room for the pre-roll, the
+//     mixer's own mic backlog it sits behind, and a capture burst landing
+//     mid-copy. Power of two.
+//   - kPreRollOnsetTicks: local voice at most this many ticks before the
+//     talkspurt opens makes it ours to pre-roll. The voice flag reaches the
+//     tick through a 20 ms poll.
+// Receiver catch-up: only for a peer that has offered pre-roll, and only
+// when the first tick of its talkspurt finds the jitter buffer past its
+// target — the burst, not BLE bunching or a stall's backlog, which play as
+// before. While the buffer stays past its target, every
+// kPreRollCatchUpIntervalTicks ticks the decode crossfade-merges one extra
+// frame into the one it plays — the high-watermark drain's time
+// compression, which keeps pitch — until the announced frames (at most
+// the excess over the target) are shed: a 6-frame burst is gone in under
+// a second.
+constexpr bool kPreRoll = false;
+constexpr size_t kPreRollFrames = 6;
+constexpr size_t kPreRollRingSamples = 8192;
+constexpr int kPreRollOnsetTicks = 3;
+constexpr uint32_t kLinkControlPreRollOffer = 5;
+constexpr int kPreRollCatchUpIntervalTicks = 8;
+static_assert(kPreRollFrames + 1 < kJitterHighWatermark,
+              "a pre-roll burst must not reach the crossfade drain");
+static_assert(kPreRollFrames * kFrameDurationMs < kStaleDropBudgetMs,
+              "the oldest pre-roll frame must not be dropped as stale");
+static_assert(kPreRollFrames <= (kOutboundQueueFrames - 2) * kMaxBundleFrames,
+              "a bundled pre-roll must fit in the writer's queue beside the live frame");
+static_assert(kPreRollFrames * kCodecFrameSize + kPlayoutMaxRingFillSamples +
+                      4 * kCodecFrameSize <=
+                  kPreRollRingSamples,
+              "the capture ring must hold the pre-roll behind the mic backlog");
+static_assert(kPreRollCatchUpIntervalTicks >= 1 &&
+                  kPreRollFrames * kPreRollCatchUpIntervalTicks * kFrameDurationMs <= 1000,
+              "catch-up must shed an announced pre-roll within a second");
+
 }  // namespace audio_config
 
 #endif  // AUDIO_CONFIG_H
@@ -14,6 +14,7 @@
 
 #include "audio_config.h"
 #include "audio_mixer.h"
+#include "peer_audio_manager.h"
 #include "playback_stream_config.h"
 #include "resampler.h"
 #include "talking_event_queue.h"
@@ -27,8 +28,8 @@
 // in the class body) can reference it without a forward declaration.
 static std::atomic<bool> g_muted{false};
 
-// Audio-focus pause flag. When true, mic frames are zeroed before reaching
-// the mixer / transport, mirroring the mute path. Streams themselves are
+// Audio-focus pause flag. When true, the audio callback plays silence and
+// leaves the mic unread, so nothing reaches the mixer / transport. Streams themselves are
 // also requestPause()'d (see pauseStreams()) — the flag is a belt-and-braces
 // guard for the brief window where a callback is already in flight when
 // pause is issued.
@@ -38,11 +39,11 @@ static std::atomic<bool> g_focusPaused{false};
 // 1.0 = full volume; 0.3 ≈ -10 dB which is what most media apps duck to.
 static std::atomic<float> g_duckingVolume{1.0f};
 
-// Single-device validation mode. When enabled, the input callback mirrors the
+// Single-device validation mode. When enabled, the audio callback mirrors the
 // local mic into this synthetic mixer device, then the normal mix-minus path
 // for device 0 writes that signal to the playback stream.
 static std::atomic<bool> g_loopbackTestMode{false};
-static constexpr int kLocalMicDeviceId = 0;
+static constexpr int kLocalMicDeviceId = AudioMixer::kLocalMicDeviceId;
 static constexpr int kLoopbackTestDeviceId = -1;
 
 // Global JNI references for voice activity callbacks
@@ -145,6 +146,16 @@ static void emitAudioErrorEvent(oboe::Result error) {
 // close, so an in-flight audio callback cannot push to a dead queue.
 static TalkingEventQueue g_talkingQueue;
 static std::atomic<bool> g_talkingWorkerStop{false};
+
+// Raw (pre-hysteresis) mic activity: set by the audio callback on any
+// unmuted burst over the VAD threshold, consumed by the worker below, which
+// forwards it to PeerAudioManager so the mixer tick stays awake — or wakes
+// from its idle park — while the local user is talking. The un-debounced
+// signal fires on the first loud burst, ~100 ms before the VAD's rising
+// edge, so the opening syllable is still in the mic ring when the tick
+// resumes. The callback only does a relaxed store; the wake itself takes a
+// mutex and must stay off the audio thread.
+static std::atomic<bool> g_micActivity{false};
 static std::thread g_talkingWorkerThread;
 
 // JNI dispatch for a single VAD edge. Called only from the worker thread,
@@ -235,6 +246,9 @@ static void talkingEventWorkerLoop() {
 
     while (!g_talkingWorkerStop.load(std::memory_order_acquire)) {
         drainQueue();
+        if (g_micActivity.exchange(false, std::memory_order_acq_rel)) {
+            peerAudioManagerNoteLocalActivity();
+        }
         std::this_thread::sleep_for(std::chrono::milliseconds(20));
     }
     // Final drain so any events queued just before the stop flag was set
@@ -352,9 +366,22 @@ private:
         audio_config::kPlayoutFrameSize * 4;  // 80 ms @ 48 kHz = 3840
     static constexpr int kMaxBurstCodecFrames =
         audio_config::kCodecFrameSize * 4;  // 80 ms @ 24 kHz = 1920
+    int16_t inputScratch_[kMaxBurstPlayoutFrames]{};
     int16_t codecScratch_[kMaxBurstCodecFrames]{};
     int16_t playoutScratch_[kMaxBurstPlayoutFrames]{};
 
+    // Playout samples interpolated past the end of the last burst; they
+    // open the next one (see renderPlayout).
+    int16_t playoutCarry_[audio_config::kResampleRatio]{};
+    int32_t playoutCarryCount_ = 0;
+
+    // Xrun counts, copied out of Oboe every kXRunPollCallbacks callbacks
+    // (about once a second at 20 ms bursts) for the JNI side.
+    static constexpr int kXRunPollCallbacks = 50;
+    int xRunPollCallbacks_ = kXRunPollCallbacks;
+    std::atomic<int32_t> inputXRuns_{0};
+    std::atomic<int32_t> outputXRuns_{0};
+
     // Compute RMS (Root Mean Square) of audio samples
     double computeRms(const int16_t* samples, int32_t numFrames) {
         if (numFrames == 0) return 0.0;
@@ -388,6 +415,13 @@ public:
         LOGI("Starting audio engine (playout %d Hz, codec %d Hz)...", kSampleRate,
              audio_config::kCodecSampleRate);
 
+        // Full duplex, output-clocked: the playback stream's data callback
+        // reads the mic without blocking and renders the playout in the same
+        // call, so output timing no longer follows the input clock and a
+        // full playout buffer can't drop audio. The recording stream has no
+        // callback of its own — its buffer is the input FIFO, and it only
+        // needs to hold what arrives between two output callbacks (a
+        // PerformanceMode::None output can burst larger than the mic does).
         oboe::AudioStreamBuilder recordingBuilder;
         recordingBuilder.setDirection(oboe::Direction::Input)
             ->setPerformanceMode(oboe::PerformanceMode::LowLatency)
@@ -395,7 +429,7 @@ public:
             ->setFormat(kFormat)
             ->setChannelCount(kChannelCount)
             ->setSampleRate(kSampleRate)
-            ->setDataCallback(this)
+            ->setBufferCapacityInFrames(kMaxBurstPlayoutFrames)
             ->setErrorCallback(errorCallback.get());
 
         // Bluetooth SCO/A2DP routes have no exclusive low-latency (MMAP) path,
@@ -432,6 +466,7 @@ public:
             ->setFormat(kFormat)
             ->setChannelCount(kChannelCount)
             ->setSampleRate(kSampleRate)
+            ->setDataCallback(this)
             ->setErrorCallback(errorCallback.get());
 
         result = playbackBuilder.openStream(playbackStream);
@@ -445,17 +480,35 @@ public:
             return false;
         }
 
+        // Run the playout at the smallest buffer the device allows without
+        // glitching, kPlaybackBufferBursts bursts deep, so output latency is
+        // that and nothing more — a write()-driven stream drifted to
+        // whatever depth the input clock left it at.
+        const int32_t burst = playbackStream->getFramesPerBurst();
+        if (burst > 0) {
+            playbackStream->setBufferSizeInFrames(
+                burst * audio_engine_config::kPlaybackBufferBursts);
+        }
+        LOGI("Playout buffer %d frames (burst %d), mic burst %d",
+             playbackStream->getBufferSizeInFrames(), burst,
+             recordingStream->getFramesPerBurst());
+
         // Reset resampler history and VAD state on every (re)start so
         // transients and stale hysteresis counts from a prior session
         // don't carry over into the new one.
         micResampler_.reset();
         playbackResampler_.reset();
         vad_.reset();
+        playoutCarryCount_ = 0;
+        xRunPollCallbacks_ = kXRunPollCallbacks;
+        inputXRuns_.store(0, std::memory_order_relaxed);
+        outputXRuns_.store(0, std::memory_order_relaxed);
 
         // Bring the worker thread up before starting the streams so any
         // VAD edge from the very first callback finds a draining consumer.
         startTalkingEventWorker();
 
+        // Mic first, so the first output callback has something to read.
         result = recordingStream->requestStart();
         if (result != oboe::Result::OK) {
             LOGE("Failed to start recording stream: %s",
@@ -477,37 +530,41 @@ public:
 
     void stop() {
         // Close streams first so no more audio callbacks can run — close()
-        // blocks until any in-flight callback returns. After both close
-        // calls return, the audio thread is guaranteed quiescent and no new
-        // events can be pushed onto the talking queue.
-        if (recordingStream) {
-            recordingStream->requestStop();
-            recordingStream->close();
-        }
+        // blocks until any in-flight callback returns. Playback goes first:
+        // its callback reads the recording stream, which must outlive it.
+        // After both close calls return, the audio thread is guaranteed
+        // quiescent and no new events can be pushed onto the talking queue.
         if (playbackStream) {
             playbackStream->requestStop();
+            pollXRuns();
             playbackStream->close();
         }
+        if (recordingStream) {
+            recordingStream->requestStop();
+            recordingStream->close();
+        }
         // Now stop the worker. It will drain any remaining queued events
         // (including ones pushed during the close() drain above) and exit.
         stopTalkingEventWorker();
-        LOGI("Audio engine stopped");
+        LOGI("Audio engine stopped (xruns: mic %d, playout %d)", inputXRuns(),
+             outputXRuns());
     }
 
     bool pauseStreams() {
+        // Playback first, as in stop(): it drives the mic reads.
         bool ok = true;
-        if (recordingStream) {
-            oboe::Result r = recordingStream->requestPause();
+        if (playbackStream) {
+            oboe::Result r = playbackStream->requestPause();
             if (r != oboe::Result::OK) {
-                LOGE("Failed to pause recording stream: %s",
+                LOGE("Failed to pause playback stream: %s",
                      oboe::convertToText(r));
                 ok = false;
             }
         }
-        if (playbackStream) {
-            oboe::Result r = playbackStream->requestPause();
+        if (recordingStream) {
+            oboe::Result r = recordingStream->requestPause();
             if (r != oboe::Result::OK) {
-                LOGE("Failed to pause playback stream: %s",
+                LOGE("Failed to pause recording stream: %s",
                      oboe::convertToText(r));
                 ok = false;
             }
@@ -538,118 +595,168 @@ public:
         return ok;
     }
 
+    // The output stream's data callback, and the engine's only one: it
+    // drains the mic (captureMic) and then renders the playout burst
+    // (renderPlayout), so input and output run on one clock, the output's.
     oboe::DataCallbackResult onAudioReady(oboe::AudioStream* audioStream,
                                            void* audioData,
                                            int32_t numFrames) override {
-        if (audioStream->getDirection() != oboe::Direction::Input) {
+        if (audioStream->getDirection() != oboe::Direction::Output) {
             return oboe::DataCallbackResult::Continue;
         }
 
-        auto* inputData = static_cast<int16_t*>(audioData);
+        auto* outputData = static_cast<int16_t*>(audioData);
 
         // Focus-pause short-circuit: a callback already in flight when
-        // requestPause() ran still gets one final delivery. Drop it.
+        // requestPause() ran still gets one final delivery. Play silence and
+        // leave the mic unread.
         if (g_focusPaused.load(std::memory_order_relaxed)) {
-            std::memset(inputData, 0, numFrames * sizeof(int16_t));
+            std::memset(outputData, 0, numFrames * sizeof(int16_t));
             return oboe::DataCallbackResult::Continue;
         }
 
+        // Snapshot the mixer singleton into an owning local shared_ptr.
+        // Holding this strong reference for the rest of the callback rules
+        // out the use-after-free that the bare-pointer global allowed:
+        // nativeClear can run concurrently and reset the global, but the
+        // underlying AudioMixer cannot be destroyed until this local ref
+        // drops at the end of the callback.
+        auto mixer = std::atomic_load(&g_audioMixer);
+
+        captureMic(mixer.get());
+        renderPlayout(mixer.get(), outputData, numFrames);
+
+        if (--xRunPollCallbacks_ <= 0) {
+            xRunPollCallbacks_ = kXRunPollCallbacks;
+            pollXRuns();
+        }
+        return oboe::DataCallbackResult::Continue;
+    }
+
+    // Xruns since the streams last opened: mic overruns, playout underruns.
+    int32_t inputXRuns() const { return inputXRuns_.load(std::memory_order_relaxed); }
+    int32_t outputXRuns() const { return outputXRuns_.load(std::memory_order_relaxed); }
+
+private:
+    // Read everything the mic captured since the last callback — with a
+    // zero timeout, so the output clock never waits on the input — and feed
+    // it to the mixer. Reading it all keeps the input buffer at its minimum
+    // depth: the mic is at most one output burst behind.
+    void captureMic(AudioMixer* mixer) {
+        if (!recordingStream) return;
+        for (;;) {
+            auto rd = recordingStream->read(inputScratch_, kMaxBurstPlayoutFrames, 0);
+            // An error is only the input not started yet (or stopping).
+            if (!rd || rd.value() <= 0) return;
+            onMicFrames(mixer, inputScratch_, rd.value());
+            if (rd.value() < kMaxBurstPlayoutFrames) return;
+        }
+    }
+
+    void onMicFrames(AudioMixer* mixer, const int16_t* inputData, int32_t numFrames) {
         const bool isMuted = g_muted.load(std::memory_order_relaxed);
 
         // VAD on the raw 48 kHz mic signal — pre-mute so the UI shows
         // "talking" feedback even when transmit is muted.
         const double rms = computeRms(inputData, numFrames);
-        if (auto edge = vad_.update(rms > vad_.threshold(), numFrames)) {
+        const bool loud = rms > vad_.threshold();
+        if (auto edge = vad_.update(loud, numFrames)) {
             emitTalkingEvent(*edge);
         }
+        // Muted speech never reaches the wire, so it shouldn't keep the
+        // mixer tick awake either.
+        if (loud && !isMuted) {
+            g_micActivity.store(true, std::memory_order_relaxed);
+        }
 
-        // Mute zeros the mic signal before resampling so the wire path sees
+        // Mic 48 kHz → codec 24 kHz. The decimator carries phase across
+        // calls; reads are capped at kMaxBurstPlayoutFrames, so the output
+        // always fits codecScratch_, and it tolerates non-multiple-of-ratio
+        // counts.
+        const int codecFrames =
+            micResampler_.process(inputData, numFrames, codecScratch_);
+        if (!mixer || codecFrames <= 0) return;
+
+        // The push-to-talk pre-roll keeps the mic as it was, keyed or not
+        // (pre_roll_ring.h); only a keyed talkspurt ever sends any of it.
+        mixer->localPreRoll().write(codecScratch_, static_cast<size_t>(codecFrames),
+                                    !isMuted);
+        // Mute zeros the mic signal everywhere else, so the wire path sees
         // pure silence (Opus then DTX'es the frame and saves bandwidth).
         if (isMuted) {
-            std::memset(inputData, 0, numFrames * sizeof(int16_t));
+            std::memset(codecScratch_, 0, codecFrames * sizeof(int16_t));
         }
 
-        // Burst-size guard. Oboe is allowed to deliver more than the typical
-        // 960 samples on stream open or after a buffer growth. If the burst
-        // would overflow our scratch we'd corrupt memory; clamp instead.
-        // Under normal operation this branch never fires.
-        if (numFrames > kMaxBurstPlayoutFrames) {
-            LOGE("Oboe burst %d > scratch %d; truncating", numFrames,
-                 kMaxBurstPlayoutFrames);
-            numFrames = kMaxBurstPlayoutFrames;
+        // Local mic occupies device id 0 in the mix-minus matrix.
+        mixer->updateDeviceAudio(kLocalMicDeviceId, codecScratch_, codecFrames);
+        if (g_loopbackTestMode.load(std::memory_order_relaxed)) {
+            mixer->updateDeviceAudio(kLoopbackTestDeviceId, codecScratch_, codecFrames);
         }
+    }
 
-        // Mic 48 kHz → codec 24 kHz. The decimator carries phase across
-        // calls; for the typical 960-sample burst we get exactly 480 codec
-        // samples back, but it tolerates non-multiple-of-ratio callbacks.
-        const int codecFrames =
-            micResampler_.process(inputData, numFrames, codecScratch_);
-
-        // Snapshot the mixer singleton into an owning local shared_ptr.
-        // Holding this strong reference for the rest of the callback rules
-        // out the use-after-free that the bare-pointer global allowed:
-        // nativeClear can run concurrently and reset the global, but the
-        // underlying AudioMixer cannot be destroyed until this local ref
-        // drops at the end of the callback.
-        auto mixer = std::atomic_load(&g_audioMixer);
-        if (mixer && codecFrames > 0) {
-            // Local mic occupies device id 0 in the mix-minus matrix.
-            mixer->updateDeviceAudio(kLocalMicDeviceId, codecScratch_, codecFrames);
-            if (g_loopbackTestMode.load(std::memory_order_relaxed)) {
-                mixer->updateDeviceAudio(
-                    kLoopbackTestDeviceId, codecScratch_, codecFrames);
-            }
+    // Fill the whole output burst with this device's mix-minus (everyone
+    // but us). The interpolator makes kResampleRatio samples per codec
+    // sample, so a burst that isn't a multiple of the ratio leaves a few
+    // over; they open the next burst.
+    void renderPlayout(AudioMixer* mixer, int16_t* outputData, int32_t numFrames) {
+        // Burst-size guard. Oboe is allowed to ask for more than the typical
+        // burst on stream open or after a buffer growth; past our scratch,
+        // the rest of the burst is silence. Under normal operation this
+        // never happens.
+        const int32_t frames = std::min(numFrames, kMaxBurstPlayoutFrames);
+        if (frames < numFrames) {
+            std::memset(outputData + frames, 0, (numFrames - frames) * sizeof(int16_t));
+        }
+        if (!mixer) {
+            std::memset(outputData, 0, frames * sizeof(int16_t));
+            playoutCarryCount_ = 0;
+            return;
+        }
 
-            // Pull this device's mix-minus (everyone but us) back from the
-            // mixer. The buffer it returns is at the codec rate.
+        int32_t filled = std::min(frames, playoutCarryCount_);
+        std::memcpy(outputData, playoutCarry_, filled * sizeof(int16_t));
+        playoutCarryCount_ = 0;
+        const int32_t wanted = frames - filled;
+        const int codecFrames =
+            (wanted + audio_config::kResampleRatio - 1) / audio_config::kResampleRatio;
+        if (codecFrames > 0) {
             int16_t mixedCodec[kMaxBurstCodecFrames];
-            if (codecFrames > kMaxBurstCodecFrames) {
-                // Defensive: should be unreachable since the resampler can
-                // never expand its input, but the static-array indexing
-                // below is too dangerous to leave un-asserted.
-                LOGE("codecFrames %d > scratch %d", codecFrames,
-                     kMaxBurstCodecFrames);
-                return oboe::DataCallbackResult::Continue;
-            }
-            mixer->getMixedAudioForDevice(
-                kLocalMicDeviceId, mixedCodec, codecFrames);
+            mixer->getMixedAudioForDevice(kLocalMicDeviceId, mixedCodec, codecFrames);
 
-            // Codec 24 kHz → playout 48 kHz. Always 2:1, so output count is
-            // exactly `codecFrames * kResampleRatio`.
+            // Codec 24 kHz → playout 48 kHz: exactly codecFrames *
+            // kResampleRatio samples, at most kResampleRatio - 1 over.
             const int playoutFrames = playbackResampler_.process(
                 mixedCodec, codecFrames, playoutScratch_);
 
             // Apply ducking on the playout-rate buffer so the multiplier
             // hits every output sample (not every other).
-            const float duckVol =
-                g_duckingVolume.load(std::memory_order_relaxed);
+            const float duckVol = g_duckingVolume.load(std::memory_order_relaxed);
             if (duckVol < 1.0f) {
                 for (int32_t i = 0; i < playoutFrames; ++i) {
-                    playoutScratch_[i] = static_cast<int16_t>(
-                        playoutScratch_[i] * duckVol);
+                    playoutScratch_[i] = static_cast<int16_t>(playoutScratch_[i] * duckVol);
                 }
             }
+            std::memcpy(outputData + filled, playoutScratch_, wanted * sizeof(int16_t));
+            playoutCarryCount_ = playoutFrames - wanted;
+            std::memcpy(playoutCarry_, playoutScratch_ + wanted,
+                        playoutCarryCount_ * sizeof(int16_t));
+        }
+    }
 
-            if (playbackStream &&
-                playbackStream->getState() == oboe::StreamState::Started) {
-                // Non-blocking write (timeout=0). The result is a
-                // ResultWithValue<int32_t>: a positive value is the count of
-                // frames written, a negative value is an error. We don't
-                // bubble the error up to the caller (we're inside the
-                // input-direction callback), but we log it so a stuck
-                // playback stream is visible in logcat. A persistent
-                // negative result here indicates the stream needs to be
-                // restarted by the engine owner — that's tracked separately
-                // and isn't fixable from inside the callback.
-                auto wr = playbackStream->write(playoutScratch_, playoutFrames, 0);
-                if (!wr) {
-                    LOGE("playbackStream->write failed: %s",
-                         oboe::convertToText(wr.error()));
-                }
+    // Oboe keeps the counts; we only copy them out where the JNI side can
+    // read them. AAudio's getter is a plain read, and OpenSL ES has none
+    // (the counts then stay 0).
+    void pollXRuns() {
+        if (recordingStream) {
+            if (auto n = recordingStream->getXRunCount()) {
+                inputXRuns_.store(n.value(), std::memory_order_relaxed);
+            }
+        }
+        if (playbackStream) {
+            if (auto n = playbackStream->getXRunCount()) {
+                outputXRuns_.store(n.value(), std::memory_order_relaxed);
             }
         }
-
-        return oboe::DataCallbackResult::Continue;
     }
 };
 
@@ -825,6 +932,24 @@ Java_com_elodin_walkie_1talkie_AudioEngineManager_nativeSetDuckingVolume(
     g_duckingVolume.store(clamped, std::memory_order_relaxed);
 }
 
+JNIEXPORT jintArray JNICALL
+Java_com_elodin_walkie_1talkie_AudioEngineManager_nativeGetXRunCounts(
+    JNIEnv* env, jobject thiz) {
+    jint counts[2] = {0, 0};
+    {
+        std::lock_guard<std::mutex> lock(g_engineMutex);
+        if (g_audioEngine != nullptr) {
+            counts[0] = g_audioEngine->inputXRuns();
+            counts[1] = g_audioEngine->outputXRuns();
+        }
+    }
+    jintArray result = env->NewIntArray(2);
+    if (result != nullptr) {
+        env->SetIntArrayRegion(result, 0, 2, counts);
+    }
+    return result;
+}
+
 JNIEXPORT jboolean JNICALL
 Java_com_elodin_walkie_1talkie_AudioEngineManager_nativeSetLoopbackTestMode(
     JNIEnv* env, jobject thiz, jboolean enabled) {
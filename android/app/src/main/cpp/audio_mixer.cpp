@@ -6,19 +6,43 @@
 #define LOGI(...) __android_log_print(ANDROID_LOG_INFO, LOG_TAG, __VA_ARGS__)
 #define LOGW(...) __android_log_print(ANDROID_LOG_WARN, LOG_TAG, __VA_ARGS__)
 
-AudioMixer::AudioMixer() = default;
+AudioMixer::AudioMixer() {
+    spareDevices.reserve(audio_config::kPeerWarmSpares);
+    refillSpareDevices();
+}
 
-bool AudioMixer::addDevice(int deviceId) {
-    std::lock_guard<std::mutex> lock(deviceRegistryMutex);
-    if (devices.size() >= kMaxDevices) {
-        LOGI("Maximum devices reached (%d)", kMaxDevices);
-        return false;
+void AudioMixer::refillSpareDevices() {
+    for (;;) {
+        {
+            std::lock_guard<std::mutex> lock(deviceRegistryMutex);
+            if (spareDevices.size() >= audio_config::kPeerWarmSpares) return;
+        }
+        auto spare = std::make_shared<DeviceAudioBuffer>();
+        std::lock_guard<std::mutex> lock(deviceRegistryMutex);
+        if (spareDevices.size() >= audio_config::kPeerWarmSpares) return;
+        spareDevices.push_back(std::move(spare));
     }
-    if (devices.find(deviceId) != devices.end()) {
-        LOGI("Device %d already exists", deviceId);
-        return false;
+}
+
+bool AudioMixer::addDevice(int deviceId) {
+    {
+        std::lock_guard<std::mutex> lock(deviceRegistryMutex);
+        if (devices.size() >= kMaxDevices) {
+            LOGI("Maximum devices reached (%d)", kMaxDevices);
+            return false;
+        }
+        if (devices.find(deviceId) != devices.end()) {
+            LOGI("Device %d already exists", deviceId);
+            return false;
+        }
+        if (spareDevices.empty()) {
+            devices[deviceId] = std::make_shared<DeviceAudioBuffer>();
+        } else {
+            devices[deviceId] = std::move(spareDevices.back());
+            spareDevices.pop_back();
+        }
     }
-    devices[deviceId] = std::make_shared<DeviceAudioBuffer>();
+    refillSpareDevices();
     LOGI("Device %d added to mixer", deviceId);
     return true;
 }
@@ -153,6 +177,8 @@ void AudioMixer::getMixedAudioForDevice(int deviceId, int16_t* outputBuffer, int
     // Allocate temp mix buffer on the stack to avoid data races and heap allocations
     int16_t tempMix[kMaxFrames];
 
+    const size_t ringCap = playoutRingCap_.load(std::memory_order_relaxed);
+
     // Mix all other devices using stack-allocated temp buffer
     for (size_t d = 0; d < deviceCount; d++) {
         const auto& [id, device] = deviceSnapshot[d];
@@ -169,8 +195,7 @@ void AudioMixer::getMixedAudioForDevice(int deviceId, int16_t* outputBuffer, int
         // Latency catch-up: fast-forward past any backlog so we mix the
         // freshest audio instead of replaying a ring that drifted full (see
         // audio_config::kPlayoutMaxRingFillSamples). Consumer-side, SPSC-safe.
-        const size_t fillCap =
-            std::max(audio_config::kPlayoutMaxRingFillSamples, readCount);
+        const size_t fillCap = std::max(ringCap, readCount);
         device->ringBuffer.dropOldestToFill(fillCap);
 
         // Skip mixing if the device is muted, but read to discard samples so they don't accumulate
@@ -234,6 +259,18 @@ std::vector<int> AudioMixer::getActiveDevices() {
     return activeDevices;
 }
 
+size_t AudioMixer::bufferedSamples(int deviceId) {
+    std::shared_ptr<DeviceAudioBuffer> device;
+    {
+        std::lock_guard<std::mutex> lock(deviceRegistryMutex);
+        auto it = devices.find(deviceId);
+        if (it != devices.end()) {
+            device = it->second;
+        }
+    }
+    return device ? device->ringBuffer.availableToRead() : 0;
+}
+
 uint64_t AudioMixer::getRingUnderReadCount(int deviceId) {
     std::shared_ptr<DeviceAudioBuffer> device;
     {
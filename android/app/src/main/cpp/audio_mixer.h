@@ -9,6 +9,7 @@
 #include <cstring>
 #include <algorithm>
 #include "audio_config.h"
+#include "pre_roll_ring.h"
 #include "ring_buffer.h"
 
 // Per-device audio buffer with lock-free ring buffer for real-time safety.
@@ -44,14 +45,31 @@ private:
     // Device registry protected by mutex (rare changes: peer join/leave)
     std::mutex deviceRegistryMutex;
     std::map<int, std::shared_ptr<DeviceAudioBuffer>> devices;  // shared_ptr for safe concurrent access
+    // Ready-built buffers for the next addDevice() (audio_config::
+    // kPeerWarmSpares), so a join that finds one doesn't zero a ring under
+    // the lock the playout callback takes. Under deviceRegistryMutex;
+    // capacity reserved.
+    std::vector<std::shared_ptr<DeviceAudioBuffer>> spareDevices;
+
+    // Top spareDevices up, building outside deviceRegistryMutex.
+    void refillSpareDevices();
 
     static constexpr int kMaxFrames = 1024;
 
+    // Playout ring cap in samples (see setPlayoutRingCap).
+    std::atomic<size_t> playoutRingCap_{audio_config::kPlayoutMaxRingFillSamples};
+
+    // Local mic history for the push-to-talk pre-roll (see localPreRoll()).
+    PreRollRing localPreRoll_;
+
 public:
     // Hard cap on concurrently mixed devices (peers). Public so callers can
     // size per-peer scratch against the real peer-count ceiling.
     static constexpr int kMaxDevices = 8;
 
+    // The local mic's device. Peers' device IDs start after it.
+    static constexpr int kLocalMicDeviceId = 0;
+
     // Stuck-producer prune threshold. A frame whose forward delta from the
     // last accepted seq exceeds this value is dropped and the peer is marked
     // poisoned. Recovery happens on the next frame whose forward delta from
@@ -102,6 +120,14 @@ public:
     // Lock-free: reads from ring buffers without blocking.
     void getMixedAudioForDevice(int deviceId, int16_t* outputBuffer, int numFrames);
 
+    // Cap each device ring at `samples` before mixing it (the latency
+    // catch-up, audio_config::kPlayoutMaxRingFillSamples). The mixer tick
+    // lowers it under the low-latency profile, whose frames are half as
+    // long. Lock-free; takes effect on the next mix.
+    void setPlayoutRingCap(size_t samples) {
+        playoutRingCap_.store(samples, std::memory_order_relaxed);
+    }
+
     // Set volume/mute settings for a device
     void setDeviceVolume(int deviceId, float volume);
     void setDeviceMuted(int deviceId, bool muted);
@@ -112,6 +138,14 @@ public:
     // Get list of active device IDs (for mixer tick thread)
     std::vector<int> getActiveDevices();
 
+    // Samples waiting in a device's ring (before the playout cap trims it),
+    // or 0 if unknown.
+    size_t bufferedSamples(int deviceId);
+
+    // The local mic's pre-roll history: written by the audio callback with
+    // every capture burst, read by the mixer tick when a talkspurt opens.
+    PreRollRing& localPreRoll() { return localPreRoll_; }
+
     // Return lifetime ring-under-read count for a device, or 0 if unknown.
     uint64_t getRingUnderReadCount(int deviceId);
 
@@ -0,0 +1,166 @@
+#ifndef BITRATE_CONTROLLER_H
+#define BITRATE_CONTROLLER_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+#include "audio_config.h"
+
+// Closed-loop AIMD controller for one peer's outbound encoder: bitrate, the
+// Opus expected-loss hint and frames per VoiceFrame, decided from what this
+// side can measure about the link every audio_config::kBitrateControlTicks.
+//
+// **Why.** Adaptation used to live in Dart: LinkQualityReporter polled
+// telemetry every 2 s, BitrateAdapter held a step for 4 s down / 30 s up, and
+// the answer came back through setPeerBitrate. A BLE link that stops keeping
+// up builds its backlog in 20 ms steps, so by the time Dart stepped down the
+// queue had long since overflowed. Here the loop closes in the mixer tick.
+//
+// **Signals.** Per interval:
+//   - backpressure — the outbound ring is congested, or skipped encodes
+//     since the last interval (outbound_frame_ring.h). Direct evidence that
+//     our uplink to this peer can't carry the stream.
+//   - loss — true network loss on the inbound stream from the same peer
+//     (JitterBuffer::lostFrameCount over lost + received), smoothed. BLE
+//     links fade in both directions at once, so it stands in for loss on our
+//     uplink, as it already did for the FEC hint.
+//   - delay gradient — the interval's change in PlayoutLagEstimator's
+//     staleness. A queue building anywhere on the link shows up as lag that
+//     keeps rising before any frame is lost.
+//
+// **Policy.** Any overuse signal backs the bitrate off multiplicatively (at
+// most once per kBitrateBackoffSpacingIntervals) and holds off increases for
+// kBitrateIncreaseHoldIntervals; a clean interval after the hold adds
+// kBitrateIncreaseStepBps. Loss in between holds. The result never exceeds
+// the ceiling the caller passes in — Dart's BitrateHint, the peer's own view
+// of the link — and never leaves [kBitrateLow, kBitrateHigh].
+//
+// **Packetization.** A backoff also bundles one more frame per VoiceFrame
+// (voice_bundle.h) and a clean interval one fewer, within what the peer offered
+// to unpack and what the latency headroom allows: one frame, plus one per
+// frame duration (kFrameDurationMs, or the low-latency profile's) the
+// inbound lag sits under kBundleLagBudgetMs.
+//
+// **Threading.** Not thread-safe; the mixer tick owns it (under the per-peer
+// mutex, alongside the encoder it drives).
+class BitrateController {
+public:
+    // Lifetime counters and current state, sampled once per interval.
+    struct Sample {
+        uint64_t lostFrames{0};       // inbound true loss (lostFrameCount)
+        uint64_t recvFrames{0};       // inbound frames accepted
+        int64_t lagMs{0};             // latest playout staleness
+        uint64_t congestionSkips{0};  // outbound encodes skipped
+        bool congested{false};        // outbound ring congested right now
+        int ceilingBps{audio_config::kBitrateHigh};
+        int maxFramesPerPacket{1};    // most the peer has offered to unpack
+        int frameMs{audio_config::kFrameDurationMs};  // frame duration in use
+    };
+
+    enum class Decision { kHold, kIncrease, kBackoff };
+
+    struct Output {
+        int bitrateBps;
+        // Smoothed loss, rounded, for OpusEncoder::setExpectedLossPct; -1
+        // when no frames arrived this interval (nothing new to say).
+        int expectedLossPct;
+        Decision decision;
+        int framesPerPacket;
+    };
+
+    explicit BitrateController(int startBps = audio_config::kDefaultBitrate)
+        : bitrateBps_(clampBps(startBps)) {}
+
+    Output update(const Sample& s) {
+        if (!primed_) {
+            primed_ = true;
+            prev_ = s;
+            bitrateBps_ = std::min(bitrateBps_, clampBps(s.ceilingBps));
+            return {bitrateBps_, -1, Decision::kHold, framesPerPacket_};
+        }
+        // A counter that went backwards was reset under us; count nothing.
+        const uint64_t lost = delta(s.lostFrames, prev_.lostFrames);
+        const uint64_t recv = delta(s.recvFrames, prev_.recvFrames);
+        const uint64_t skips = delta(s.congestionSkips, prev_.congestionSkips);
+        const bool flowing = lost + recv > 0;
+
+        int expectedLossPct = -1;
+        if (flowing) {
+            const double pct = 100.0 * static_cast<double>(lost) /
+                               static_cast<double>(lost + recv);
+            lossPct_ += (pct - lossPct_) / audio_config::kBitrateLossSmoothing;
+            expectedLossPct = static_cast<int>(std::lround(lossPct_));
+        }
+        // Lag is only fresh while frames arrive.
+        const bool lagRising =
+            recv > 0 && s.lagMs - prev_.lagMs >= audio_config::kBitrateLagRiseMs;
+        prev_ = s;
+
+        if (sinceBackoff_ < audio_config::kBitrateIncreaseHoldIntervals) {
+            ++sinceBackoff_;
+        }
+        const bool overuse = s.congested || skips > 0 || lagRising ||
+                             lossPct_ > audio_config::kBitrateBackoffLossPct;
+
+        const bool clean = !overuse && flowing &&
+                           lossPct_ < audio_config::kBitrateIncreaseMaxLossPct &&
+                           sinceBackoff_ >= audio_config::kBitrateIncreaseHoldIntervals;
+        Decision decision = Decision::kHold;
+        int next = bitrateBps_;
+        if (overuse) {
+            if (sinceBackoff_ >= audio_config::kBitrateBackoffSpacingIntervals) {
+                next = bitrateBps_ * audio_config::kBitrateBackoffPercent / 100;
+                sinceBackoff_ = 0;
+                ++backoffCount_;
+                decision = Decision::kBackoff;
+            }
+        } else if (clean) {
+            next = bitrateBps_ + audio_config::kBitrateIncreaseStepBps;
+            decision = Decision::kIncrease;
+        }
+        next = std::min(clampBps(next), clampBps(s.ceilingBps));
+        if (next == bitrateBps_ && decision == Decision::kIncrease) {
+            decision = Decision::kHold;  // already at the ceiling
+        }
+        bitrateBps_ = next;
+
+        if (decision == Decision::kBackoff) {
+            ++framesPerPacket_;
+        } else if (clean) {
+            --framesPerPacket_;
+        }
+        const int64_t headroomMs = audio_config::kBundleLagBudgetMs - s.lagMs;
+        const int byHeadroom =
+            1 + static_cast<int>(std::max<int64_t>(headroomMs, 0) /
+                                 std::max(s.frameMs, 1));
+        framesPerPacket_ = std::clamp(
+            framesPerPacket_, 1, std::max(1, std::min(s.maxFramesPerPacket, byHeadroom)));
+        return {bitrateBps_, expectedLossPct, decision, framesPerPacket_};
+    }
+
+    int bitrateBps() const { return bitrateBps_; }
+    double lossPct() const { return lossPct_; }
+    uint32_t backoffCount() const { return backoffCount_; }
+    int framesPerPacket() const { return framesPerPacket_; }
+
+private:
+    static int clampBps(int bps) {
+        return std::clamp(bps, audio_config::kBitrateLow, audio_config::kBitrateHigh);
+    }
+    static uint64_t delta(uint64_t now, uint64_t before) {
+        return now >= before ? now - before : 0;
+    }
+
+    Sample prev_{};
+    bool primed_{false};
+    int bitrateBps_;
+    double lossPct_{0.0};
+    // Intervals since the last backoff, saturating at the increase hold.
+    // Starts saturated: a fresh link may climb as soon as it's clean.
+    int sinceBackoff_{audio_config::kBitrateIncreaseHoldIntervals};
+    uint32_t backoffCount_{0};
+    int framesPerPacket_{1};
+};
+
+#endif  // BITRATE_CONTROLLER_H
@@ -0,0 +1,194 @@
+#ifndef CLOCK_DRIFT_ESTIMATOR_H
+#define CLOCK_DRIFT_ESTIMATOR_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+#include "audio_config.h"
+
+// Estimates the per-peer frequency skew between the sender's encode clock and
+// our mixer-tick clock, in parts per million, from the same
+// (`senderTsMs`, local arrival) pairs that feed PlayoutLagEstimator.
+//
+// **Why.** Each guest encodes on its own 50 Hz tick, timed by its own crystal;
+// we consume on ours. Two crystals are always a few tens of ppm apart, so the
+// producer slowly out- or under-runs the consumer: the jitter buffer creeps up
+// until `kJitterHighWatermark` fires the crossfade drain, or creeps down until
+// it underruns into PLC. Knowing the skew lets the decode path consume the
+// peer's audio at *its* rate (see VariableRatioResampler in resampler.h), so
+// buffer depth stays flat at the target instead of sawtoothing.
+//
+// **Method.** `rawDelay = arrival - senderTsMs` carries an unknown constant
+// clock offset plus transit; its *slope* against arrival time is the skew
+// (sender fast → senderTsMs advances faster than arrival → rawDelay falls).
+// BLE connection-event jitter (7.5–50 ms) is huge next to a ppm slope, but it
+// is one-sided — queuing only ever adds delay — so instead of regressing every
+// frame we take the minimum rawDelay per `kDriftBlockMs` block (the "best
+// transit" of that second, like PlayoutLagEstimator's baseline) and
+// least-squares fit a line through the last `kDriftWindowBlocks` block minima.
+// The fitted slope is smoothed block-to-block and clamped to
+// ±`kDriftMaxCorrectionPpm` so a pathological stream can't drive the
+// resampler off a cliff.
+//
+// **Wraparound.** rawDelay is a signed int32 modular difference (as in
+// PlayoutLagEstimator) and block minima are stored relative to the first
+// sample's rawDelay, so neither the uint32 senderTsMs wrap nor a large offset
+// between the two clock epochs costs precision in the fit.
+//
+// **Threading.** Not thread-safe; the caller serialises feeds under the
+// per-peer mutex (same as PlayoutLagEstimator). O(1) per feed; O(window) once
+// per closed block.
+class ClockDriftEstimator {
+public:
+    ClockDriftEstimator() = default;
+
+    // Record a frame arrival. `recvMs` must be non-decreasing across calls
+    // (steady_clock ms).
+    void feed(uint32_t senderTsMs, int64_t recvMs) {
+        const int32_t rawDelay = static_cast<int32_t>(
+            static_cast<uint32_t>(recvMs) - senderTsMs);
+        if (!anchored_) {
+            anchored_ = true;
+            anchorRawDelay_ = rawDelay;
+            anchorRecvMs_ = recvMs;
+            openBlock(recvMs);
+        }
+        // Relative to the anchor, in modular int32 so an epoch gap near the
+        // int32 boundary can't flip sign between blocks.
+        const int32_t relDelay =
+            static_cast<int32_t>(static_cast<uint32_t>(rawDelay) -
+                                 static_cast<uint32_t>(anchorRawDelay_));
+
+        if (recvMs - blockStartMs_ >=
+            static_cast<int64_t>(audio_config::kDriftBlockMs)) {
+            closeBlock();
+            openBlock(recvMs);
+        }
+        if (!blockHasSample_ || relDelay < blockMinDelay_) {
+            blockMinDelay_ = relDelay;
+            blockMinRecvMs_ = recvMs;
+            blockHasSample_ = true;
+        }
+    }
+
+    // True once enough block minima span the window for the slope to mean
+    // something. Until then skewPpm() reads 0.
+    bool converged() const {
+        return fittedBlocks_ > 0 &&
+               blockCount_ >= audio_config::kDriftMinBlocks;
+    }
+
+    // Sender-clock skew relative to ours, in ppm. Positive means the sender's
+    // clock runs fast (it produces more than 50 frames per one of our
+    // seconds). 0 until converged().
+    double skewPpm() const { return converged() ? skewPpm_ : 0.0; }
+
+    // Input samples the consumer should eat per output sample to track the
+    // sender's rate: 1 + skew. Feed straight into
+    // VariableRatioResampler::setStep().
+    double consumeStep() const { return 1.0 + skewPpm() * 1e-6; }
+
+    void reset() {
+        anchored_ = false;
+        anchorRawDelay_ = 0;
+        anchorRecvMs_ = 0;
+        blockStartMs_ = 0;
+        blockHasSample_ = false;
+        blockMinDelay_ = 0;
+        blockMinRecvMs_ = 0;
+        blockHead_ = 0;
+        blockCount_ = 0;
+        fittedBlocks_ = 0;
+        skewPpm_ = 0.0;
+    }
+
+private:
+    struct Block {
+        double xMs;     // arrival time of the block's best frame, rel. anchor
+        double yMs;     // its rawDelay, rel. anchor
+    };
+
+    void openBlock(int64_t recvMs) {
+        blockStartMs_ = recvMs;
+        blockHasSample_ = false;
+    }
+
+    void closeBlock() {
+        if (!blockHasSample_) return;
+        blocks_[blockHead_] = {
+            static_cast<double>(blockMinRecvMs_ - anchorRecvMs_),
+            static_cast<double>(blockMinDelay_)};
+        blockHead_ = (blockHead_ + 1) % audio_config::kDriftWindowBlocks;
+        if (blockCount_ < audio_config::kDriftWindowBlocks) ++blockCount_;
+
+        // Evict blocks that fell out of the time window. A talkspurt gap (or
+        // a reconnect that kept state) longer than the window would otherwise
+        // fit a line across two unrelated stretches of the stream.
+        const double newestX = static_cast<double>(blockMinRecvMs_ - anchorRecvMs_);
+        const double windowMs = static_cast<double>(
+            audio_config::kDriftBlockMs * audio_config::kDriftWindowBlocks);
+        while (blockCount_ > 1) {
+            const size_t oldest =
+                (blockHead_ + audio_config::kDriftWindowBlocks - blockCount_) %
+                audio_config::kDriftWindowBlocks;
+            if (newestX - blocks_[oldest].xMs <= windowMs) break;
+            --blockCount_;
+        }
+        if (blockCount_ < audio_config::kDriftMinBlocks) return;
+
+        // Ordinary least squares over the live blocks. Centre on the means so
+        // the sums stay small regardless of session length.
+        double mx = 0.0, my = 0.0;
+        for (size_t i = 0; i < blockCount_; ++i) {
+            const Block& b = blockAt(i);
+            mx += b.xMs;
+            my += b.yMs;
+        }
+        mx /= static_cast<double>(blockCount_);
+        my /= static_cast<double>(blockCount_);
+        double sxx = 0.0, sxy = 0.0;
+        for (size_t i = 0; i < blockCount_; ++i) {
+            const Block& b = blockAt(i);
+            sxx += (b.xMs - mx) * (b.xMs - mx);
+            sxy += (b.xMs - mx) * (b.yMs - my);
+        }
+        if (sxx <= 0.0) return;
+        // rawDelay slope is -skew (sender fast → delay shrinks).
+        const double fitPpm = std::clamp(-(sxy / sxx) * 1e6,
+                                         -audio_config::kDriftMaxCorrectionPpm,
+                                         audio_config::kDriftMaxCorrectionPpm);
+        // The first fit seeds directly; after that a one-pole smoother keeps a
+        // single noisy block from stepping the resampler ratio.
+        if (fittedBlocks_ == 0) {
+            skewPpm_ = fitPpm;
+        } else {
+            skewPpm_ += audio_config::kDriftSmoothing * (fitPpm - skewPpm_);
+        }
+        ++fittedBlocks_;
+    }
+
+    // i = 0 is the oldest live block.
+    const Block& blockAt(size_t i) const {
+        return blocks_[(blockHead_ + audio_config::kDriftWindowBlocks -
+                        blockCount_ + i) %
+                       audio_config::kDriftWindowBlocks];
+    }
+
+    bool anchored_{false};
+    int32_t anchorRawDelay_{0};
+    int64_t anchorRecvMs_{0};
+
+    int64_t blockStartMs_{0};
+    bool blockHasSample_{false};
+    int32_t blockMinDelay_{0};
+    int64_t blockMinRecvMs_{0};
+
+    Block blocks_[audio_config::kDriftWindowBlocks] = {};
+    size_t blockHead_{0};   // next slot to write
+    size_t blockCount_{0};  // live blocks, <= kDriftWindowBlocks
+    size_t fittedBlocks_{0};
+    double skewPpm_{0.0};
+};
+
+#endif  // CLOCK_DRIFT_ESTIMATOR_H
@@ -0,0 +1,85 @@
+#ifndef COMFORT_NOISE_H
+#define COMFORT_NOISE_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+#include "audio_config.h"
+#include "vad_detector.h"
+
+// Comfort noise for a peer's announced pauses (audio_config::
+// kSilenceSuppression): low-pass noise at the level of the background the
+// peer last sent, so its between-words silence doesn't drop to digital zero
+// and jump back on the next word.
+//
+// **Level.** observe() tracks the RMS of the peer's decoded frames the VAD
+// calls quiet — the hangover the sender keeps on the air before pausing is
+// exactly that background — capped at kComfortNoiseMaxRms.
+//
+// **Shape.** White noise through a one-pole low-pass, which tilts it toward
+// the low-frequency hum most rooms have. Cheap enough to run per peer per
+// tick: one xorshift and two multiplies a sample.
+//
+// **Threading.** Not thread-safe; owned by the peer's state and used under
+// its mutex on the mixer tick.
+class ComfortNoise {
+public:
+    static_assert(audio_config::kComfortNoiseMaxRms < VadDetector::kDefaultThreshold,
+                  "comfort noise must never trip the VAD");
+
+    // Fold a decoded frame's RMS (normalised, as the VAD sees it) into the
+    // background level, unless the peer is talking.
+    void observe(double rms, bool talking) {
+        if (talking) return;
+        const double capped = std::min(rms, audio_config::kComfortNoiseMaxRms);
+        levelRms_ = haveLevel_ ? levelRms_ + (capped - levelRms_) /
+                                                 audio_config::kComfortNoiseSmoothing
+                               : capped;
+        haveLevel_ = true;
+    }
+
+    // A pause is starting: play from full level again.
+    void restart() { frames_ = 0; }
+
+    // Write `n` samples of noise, faded per the hold/fade schedule. Returns
+    // `n`, or 0 (nothing written) once the fade is over or before any
+    // background has been observed.
+    int generate(int16_t* pcm, int n) {
+        const int fadeAt = audio_config::kComfortNoiseHoldFrames;
+        const int end = fadeAt + audio_config::kComfortNoiseFadeFrames;
+        if (!haveLevel_ || levelRms_ <= 0.0 || frames_ >= end) return 0;
+        double gain = levelRms_ * 32768.0 / kShapedRms;
+        if (frames_ >= fadeAt) {
+            gain *= static_cast<double>(end - frames_) /
+                    audio_config::kComfortNoiseFadeFrames;
+        }
+        ++frames_;
+        for (int i = 0; i < n; ++i) {
+            rng_ ^= rng_ << 13;
+            rng_ ^= rng_ >> 17;
+            rng_ ^= rng_ << 5;
+            const double white = static_cast<int32_t>(rng_) / 2147483648.0;
+            lowPass_ += kLowPassAlpha * (white - lowPass_);
+            pcm[i] = static_cast<int16_t>(std::lround(
+                std::clamp(lowPass_ * gain, -32768.0, 32767.0)));
+        }
+        return n;
+    }
+
+    double levelRms() const { return levelRms_; }
+
+private:
+    // y += a·(x − y) on uniform white noise in [-1, 1) (RMS 1/√3) leaves RMS
+    // √(a / (2 − a)) of that.
+    static constexpr double kLowPassAlpha = 0.5;
+    static constexpr double kShapedRms = 0.3333333333333333;  // √(1/3)·√(1/3)
+
+    double levelRms_{0.0};
+    bool haveLevel_{false};
+    int frames_{0};
+    uint32_t rng_{0x9E3779B9u};
+    double lowPass_{0.0};
+};
+
+#endif  // COMFORT_NOISE_H
@@ -1,5 +1,6 @@
 #include "jitter_buffer.h"
 
+#include <iterator>
 #include <utility>
 
 bool JitterBuffer::push(uint32_t seq, const uint8_t* data, size_t size) {
@@ -17,6 +18,9 @@ bool JitterBuffer::push(uint32_t seq, const uint8_t* data, size_t size) {
         playhead_ = seq;
         playheadInit_ = true;
     }
+    if (gapExpected_ && !seqLess(seq, gapSeq_)) {
+        gapExpected_ = false;
+    }
 
     // Insert in modular-sorted order. Working window is small (<= kMaxDepth
     // = 10 frames) so a linear scan is faster than a tree. We do the dup
@@ -72,18 +76,34 @@ bool JitterBuffer::push(uint32_t seq, const uint8_t* data, size_t size) {
         }
     }
 
+    // Hole tracking for lookahead FEC. If seq - 1 is neither queued nor
+    // already behind the playhead, it's a hole this frame's LBRR can fill;
+    // and if this arrival is itself the missing predecessor of the next
+    // queued frame, that frame's hole is gone.
+    const uint32_t prevSeq = seq - 1;
+    const bool prevQueued = it != frames_.begin() && std::prev(it)->seq == prevSeq;
+    const bool prevPlayed = !playheadInit_ || seqLess(prevSeq, playhead_);
+    if (it != frames_.end() && it->seq == seq + 1) {
+        it->recoversPrev = false;
+    }
+
     Frame f;
     f.seq = seq;
     f.opusData.assign(data, data + size);
+    f.recoversPrev = !prevQueued && !prevPlayed;
     frames_.insert(it, std::move(f));
     return true;
 }
 
 std::optional<JitterBuffer::Frame> JitterBuffer::pop() {
-    if (frames_.size() < targetDepth_) {
+    lastPopHole_ = false;
+    if (ramping_ && frames_.size() >= targetDepth_) {
+        ramping_ = false;
+    }
+    if (frames_.size() < releaseDepth()) {
         // Buffer-underrun: too few frames to release. Count only after
         // priming, and only on the *transition* into starvation. This
-        // prevents two failure modes:
+        // prevents three failure modes:
         //   1. Cold-start: pop() loops on an empty buffer for many ticks
         //      before the first frame arrives — we shouldn't ratchet the
         //      target depth up because of those, since they're a fact of
@@ -91,11 +111,14 @@ std::optional<JitterBuffer::Frame> JitterBuffer::pop() {
         //   2. Talkspurt gap: a peer goes silent (DTX) for several ticks;
         //      every tick is technically an underrun but it's one episode,
         //      so it counts once.
-        if (primed_ && !inUnderrun_) {
+        //   3. Announced pause (expectGap()): the sender stopped on purpose.
+        //      The episode is marked so the refill after it doesn't count
+        //      either.
+        if (primed_ && !inUnderrun_ && !gapExpected_) {
             ++underrunCount_;
             ++underrunsThisInterval_;
-            inUnderrun_ = true;
         }
+        if (primed_) inUnderrun_ = true;
         return std::nullopt;
     }
 
@@ -122,6 +145,8 @@ std::optional<JitterBuffer::Frame> JitterBuffer::pop() {
             ++underrunsThisInterval_;
             inUnderrun_ = true;
         }
+        lastPopHole_ = true;
+        lastHoleSeq_ = playhead_;
         ++playhead_;
         return std::nullopt;
     }
@@ -138,6 +163,7 @@ std::optional<JitterBuffer::Frame> JitterBuffer::pop() {
 }
 
 std::optional<JitterBuffer::Frame> JitterBuffer::popAny() {
+    lastPopHole_ = false;
     if (frames_.empty()) {
         return std::nullopt;
     }
@@ -150,6 +176,46 @@ std::optional<JitterBuffer::Frame> JitterBuffer::popAny() {
     return f;
 }
 
+void JitterBuffer::setStartDepth(size_t depth) {
+    if (depth < 1) depth = 1;
+    if (depth > audio_config::kJitterInitialDepth) {
+        depth = audio_config::kJitterInitialDepth;
+    }
+    startDepth_ = depth;
+}
+
+size_t JitterBuffer::releaseDepth() const {
+    if (ramping_ && startDepth_ < targetDepth_) {
+        return startDepth_;
+    }
+    return targetDepth_;
+}
+
+void JitterBuffer::seedAdaptState(const AdaptState& state) {
+    size_t target = state.targetDepth;
+    if (target < audio_config::kJitterMinDepth) {
+        target = audio_config::kJitterMinDepth;
+    }
+    if (target > audio_config::kJitterMaxTargetDepth) {
+        target = audio_config::kJitterMaxTargetDepth;
+    }
+    targetDepth_ = target;
+    stableIntervalsCount_ = state.stableIntervals;
+}
+
+const JitterBuffer::Frame* JitterBuffer::fecSourceForHole() const {
+    if (!lastPopHole_ || frames_.empty()) {
+        return nullptr;
+    }
+    // The queue is sorted and lastHoleSeq_ is missing, so the successor, if
+    // queued, is the front.
+    const Frame& front = frames_.front();
+    if (front.seq != lastHoleSeq_ + 1 || !front.recoversPrev) {
+        return nullptr;
+    }
+    return &front;
+}
+
 void JitterBuffer::tick() {
     ++ticksThisInterval_;
     if (ticksThisInterval_ < audio_config::kJitterAdaptIntervalTicks) {
@@ -209,6 +275,11 @@ void JitterBuffer::resyncPlayheadIfEmpty(uint32_t seq) {
     playheadInit_ = true;
 }
 
+void JitterBuffer::expectGap(uint32_t nextSeq) {
+    gapExpected_ = true;
+    gapSeq_ = nextSeq;
+}
+
 void JitterBuffer::resetAdaptCounters() {
     ticksThisInterval_ = 0;
     underrunsThisInterval_ = 0;
@@ -222,6 +293,9 @@ void JitterBuffer::reset() {
     targetDepth_ = audio_config::kJitterInitialDepth;
     primed_ = false;
     inUnderrun_ = false;
+    gapExpected_ = false;
+    lastPopHole_ = false;
+    ramping_ = true;
     resetAdaptCounters();
     // Lifetime counters intentionally retained for telemetry continuity
     // across a peer re-register.
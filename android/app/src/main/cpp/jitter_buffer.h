@@ -41,6 +41,13 @@
 // one underrun (not one per tick), so an idle peer or a long talkspurt gap
 // doesn't ratchet target depth upward in the absence of real network jitter.
 //
+// **Fast start.** With `setStartDepth()` below the target, a cold-started
+// buffer releases its first frame at the start depth instead of waiting for
+// the target, and keeps releasing down to the start depth until it first
+// reaches the target (`ramping()`); the owner plays slightly slow during the
+// ramp so the depth grows. After that, normal target-depth rules apply until
+// the next `reset()`.
+//
 // **Bounded memory + freshness bias.** `push()` enforces `kJitterMaxDepth`:
 // at the cap it evicts the OLDEST queued frame to admit a newer arrival
 // (advancing the playhead past the dropped seq so the skip isn't miscounted
@@ -66,6 +73,23 @@ public:
     struct Frame {
         uint32_t seq{0};
         std::vector<uint8_t> opusData;
+        // Decoded PCM, filled ahead of playout when the owner decodes on
+        // arrival (see PeerAudioManager::decodeAhead). Empty = not decoded
+        // yet; the buffer itself never reads or writes it.
+        std::vector<int16_t> pcm;
+        // Set by push() when this frame arrived with its predecessor
+        // (seq - 1) missing but still ahead of the playhead: the hole can be
+        // recovered from this frame's Opus LBRR side-channel when it reaches
+        // the head. Cleared if the predecessor turns up after all.
+        bool recoversPrev{false};
+    };
+
+    // What adaptation has learned about the link: the target depth and the
+    // underrun-free streak that gates shrinking it. Saved across a peer's
+    // reconnect to warm-start the next buffer (see PeerAudioManager).
+    struct AdaptState {
+        size_t targetDepth{audio_config::kJitterInitialDepth};
+        size_t stableIntervals{0};
     };
 
     JitterBuffer() = default;
@@ -87,6 +111,10 @@ public:
     // increments the underrun counter if the buffer hasn't filled to the
     // current target depth — caller should run PLC on the decoder.
     //
+    // Also returns nullopt when the playhead seq is a hole (lost in transit);
+    // the playhead then steps past it and fecSourceForHole() names the frame,
+    // if any, that can reconstruct it.
+    //
     // On success, advances the playhead so subsequent push()es of older
     // seqs are rejected as late.
     std::optional<Frame> pop();
@@ -123,13 +151,52 @@ public:
 
     // Peek at the front frame without consuming it. Returns nullptr when empty.
     // The pointer is valid only until the next push/pop/reset call; the caller
-    // must not store it across any mutation. Used by the decode path to attempt
-    // Opus inband FEC (decodeFec) before falling back to PLC: the next in-order
-    // packet's LBRR side-channel can reconstruct a lost frame without popping.
+    // must not store it across any mutation.
     const Frame* peekFront() const {
         return frames_.empty() ? nullptr : &frames_.front();
     }
 
+    // The frame whose in-band FEC reconstructs the hole the last pop() just
+    // stepped over, or nullptr. Non-null only right after a hole-at-head
+    // pop(), and only when the frame immediately after the lost seq is
+    // queued and marked `recoversPrev` — so in a multi-frame hole the earlier
+    // seqs get nullptr (PLC) and only the last one is recovered, from the
+    // packet that actually carries its LBRR. Same lifetime rule as
+    // peekFront().
+    const Frame* fecSourceForHole() const;
+
+    // Mutable access to the i-th queued frame in playout order (0 = front),
+    // or nullptr past the end. Same lifetime rule as peekFront(). For the
+    // owner to attach decoded PCM to queued frames; callers must not change
+    // `seq`.
+    Frame* frameAt(size_t i) {
+        return i < frames_.size() ? &frames_[i] : nullptr;
+    }
+
+    // True once a pop() / popAny() has released a frame since construction
+    // or reset().
+    bool primed() const { return primed_; }
+
+    // Cold-start release depth (fast start). Defaults to kJitterInitialDepth,
+    // i.e. off; survives reset().
+    void setStartDepth(size_t depth);
+
+    // The depth pop() currently needs to release a frame: the start depth
+    // until the buffer first reaches its target, the target after.
+    size_t releaseDepth() const;
+
+    // True while a primed buffer is still ramping from its start depth up to
+    // the target.
+    bool ramping() const {
+        return ramping_ && primed_ && startDepth_ < targetDepth_;
+    }
+
+    AdaptState adaptState() const { return {targetDepth_, stableIntervalsCount_}; }
+
+    // Adopt a previously learned AdaptState (clamped to the adaptive range).
+    // Call right after construction or reset(), before the first push.
+    void seedAdaptState(const AdaptState& state);
+
     // Resync the playhead to `seq` when (and only when) the buffer is empty.
     //
     // Used by the caller after it has *intentionally* shed frames before they
@@ -143,6 +210,13 @@ public:
     // gated to the shed path, so genuine packet loss is still counted normally.
     void resyncPlayheadIfEmpty(uint32_t seq);
 
+    // The sender has paused on purpose (a talkspurt-end link-control frame):
+    // its next frame will be `nextSeq`, whenever it comes. Until a frame at
+    // or past `nextSeq` is pushed, running dry is the pause, not jitter — it
+    // doesn't count as an underrun or grow the target depth.
+    void expectGap(uint32_t nextSeq);
+    bool gapExpected() const { return gapExpected_; }
+
     // Reset the rolling counters used by adapt(). Stats above continue to
     // accumulate for telemetry; this only affects adaptation decisions.
     void resetAdaptCounters();
@@ -165,6 +239,10 @@ private:
 
     size_t targetDepth_{audio_config::kJitterInitialDepth};
 
+    // Fast start: release depth before the buffer first reaches its target.
+    size_t startDepth_{audio_config::kJitterInitialDepth};
+    bool ramping_{true};
+
     // Priming + episode tracking. `primed_` flips to true on the first
     // successful `pop()` and never resets (a real client doesn't unprime
     // mid-session; on `reset()` we explicitly clear it). `inUnderrun_` flips
@@ -173,6 +251,15 @@ private:
     bool primed_{false};
     bool inUnderrun_{false};
 
+    // expectGap(): the sender's announced pause, and the seq that ends it.
+    bool gapExpected_{false};
+    uint32_t gapSeq_{0};
+
+    // Seq the last pop() reported as a hole-at-head; valid until the next
+    // pop() / popAny() / reset().
+    bool lastPopHole_{false};
+    uint32_t lastHoleSeq_{0};
+
     // Lifetime stats.
     size_t underrunCount_{0};
     size_t lateCount_{0};
@@ -33,9 +33,10 @@ OpusEncoder::OpusEncoder() : encoder_(nullptr) {
 
     APPLY_ENC_CTL(OPUS_SET_BITRATE(currentBitrate_));
 
-    // Max encoder complexity. The quality/CPU tradeoff is irrelevant on a
-    // modern phone encoding one 20 ms mono frame per tick — spend the cycles.
-    APPLY_ENC_CTL(OPUS_SET_COMPLEXITY(10));
+    // Max encoder complexity. One 20 ms mono frame per tick is cheap on a
+    // modern phone — spend the cycles, until the tick governor says the
+    // room's worth of encoders can't afford them (setComplexity()).
+    APPLY_ENC_CTL(OPUS_SET_COMPLEXITY(audio_config::kGovernorComplexity[0]));
 
     // Inband FEC (LBRR): embed a low-bitrate copy of the previous frame in
     // each packet so the decoder can reconstruct a lost frame from the next
@@ -47,9 +48,10 @@ OpusEncoder::OpusEncoder() : encoder_(nullptr) {
     APPLY_ENC_CTL(OPUS_SET_INBAND_FEC(1));
     APPLY_ENC_CTL(OPUS_SET_PACKET_LOSS_PERC(20));
 
-    // DTX off: continuous transmission. DTX saves bandwidth by suppressing
-    // silence, but the comfort-noise/restart transitions clip word onsets and
-    // add artifacts. L2CAP has bandwidth to spare, so favour clean audio.
+    // DTX off until setDtx(): continuous transmission. Silence suppression
+    // (PeerAudioManager) turns it on, for the hangover before its own gate
+    // closes; the gate, not DTX, decides when a talkspurt starts, so onsets
+    // aren't left to the DTX restart.
     APPLY_ENC_CTL(OPUS_SET_DTX(0));
 
 #undef APPLY_ENC_CTL
@@ -72,13 +74,15 @@ int OpusEncoder::encode(const int16_t* pcm, int numSamples, uint8_t* output,
         LOGE("Encoder not initialized");
         return -1;
     }
-    if (numSamples != audio_config::kCodecFrameSize) {
-        LOGE("Invalid frame size: %d (expected %d)", numSamples,
-             audio_config::kCodecFrameSize);
+    if (numSamples != audio_config::kCodecFrameSize &&
+        numSamples != audio_config::kLowLatencyCodecFrameSize) {
+        LOGE("Invalid frame size: %d (expected %d or %d)", numSamples,
+             audio_config::kCodecFrameSize,
+             audio_config::kLowLatencyCodecFrameSize);
         return -1;
     }
-    int encodedSize = opus_encode(encoder_, pcm, audio_config::kCodecFrameSize,
-                                  output, maxOutputBytes);
+    int encodedSize = opus_encode(encoder_, pcm, numSamples, output,
+                                  maxOutputBytes);
     if (encodedSize < 0) {
         LOGE("Opus encode error: %s", opus_strerror(encodedSize));
     }
@@ -121,6 +125,23 @@ void OpusEncoder::setInbandFec(bool enabled) {
     }
 }
 
+void OpusEncoder::setComplexity(int complexity) {
+    if (!encoder_) return;
+    const int clamped = std::max(0, std::min(10, complexity));
+    int err = opus_encoder_ctl(encoder_, OPUS_SET_COMPLEXITY(clamped));
+    if (err != OPUS_OK) {
+        LOGE("OPUS_SET_COMPLEXITY(%d) failed: %s", clamped, opus_strerror(err));
+    }
+}
+
+void OpusEncoder::setDtx(bool enabled) {
+    if (!encoder_) return;
+    int err = opus_encoder_ctl(encoder_, OPUS_SET_DTX(enabled ? 1 : 0));
+    if (err != OPUS_OK) {
+        LOGE("OPUS_SET_DTX(%d) failed: %s", enabled ? 1 : 0, opus_strerror(err));
+    }
+}
+
 OpusDecoder::OpusDecoder() : decoder_(nullptr) {
     int error = OPUS_OK;
     decoder_ = opus_decoder_create(audio_config::kCodecSampleRate,
@@ -166,6 +187,14 @@ int OpusDecoder::decodeMissing(int16_t* pcm, int frameSize) {
     return numSamples;
 }
 
+void OpusDecoder::reset() {
+    if (!decoder_) return;
+    int err = opus_decoder_ctl(decoder_, OPUS_RESET_STATE);
+    if (err != OPUS_OK) {
+        LOGE("OPUS_RESET_STATE failed: %s", opus_strerror(err));
+    }
+}
+
 int OpusDecoder::decodeFec(const uint8_t* nextPacket, int nextSize,
                            int16_t* pcm, int frameSize) {
     if (!decoder_) return -1;
@@ -38,7 +38,9 @@ public:
     OpusEncoder& operator=(const OpusEncoder&) = delete;
 
     // Encode 16-bit PCM samples to Opus. Returns encoded size, or negative
-    // on error. `numSamples` must be exactly audio_config::kCodecFrameSize.
+    // on error. `numSamples` must be exactly audio_config::kCodecFrameSize,
+    // or kLowLatencyCodecFrameSize under the low-latency profile; Opus takes
+    // the frame size per call, so the two can alternate on one encoder.
     int encode(const int16_t* pcm, int numSamples, uint8_t* output,
                int maxOutputBytes);
 
@@ -55,6 +57,16 @@ public:
     // mode can disable it explicitly.
     void setInbandFec(bool enabled);
 
+    // Set encoder complexity, clamped to [0, 10]. 10 at construction; the
+    // tick governor (tick_governor.h) lowers it when the tick runs short of
+    // CPU.
+    void setComplexity(int complexity);
+
+    // Toggle DTX. Off at construction. On, a frame Opus judges to be
+    // background comes out as a 1–2 byte packet the decoder turns into
+    // comfort noise.
+    void setDtx(bool enabled);
+
     static constexpr int getFrameSize() {
         return audio_config::kCodecFrameSize;
     }
@@ -101,6 +113,12 @@ public:
     int decodeFec(const uint8_t* nextPacket, int nextSize, int16_t* pcm,
                   int frameSize);
 
+    // Return the decoder to its freshly-created state (OPUS_RESET_STATE)
+    // without reallocating. Use before resuming a stream after a long gap so
+    // the first frame isn't predicted from, or overlapped with, audio that
+    // ended seconds ago.
+    void reset();
+
     static constexpr int getFrameSize() {
         return audio_config::kCodecFrameSize;
     }
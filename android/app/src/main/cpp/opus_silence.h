@@ -0,0 +1,39 @@
+#ifndef OPUS_SILENCE_H
+#define OPUS_SILENCE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "audio_config.h"
+
+// Tells a silent Opus packet from one worth decoding, from its bytes alone
+// (audio_config::kOpusSilentMaxBytes).
+//
+// **Why.** The mixer tick decoded every packet it played and then ran a
+// double-precision RMS over the PCM, only to tell the peer's VAD "quiet".
+// With silence suppression the hangover before every pause is DTX packets
+// (audio_config::kSilenceSuppression), so in a big room most of what arrives
+// is a TOC byte or two: known silence, for which the decode is concealment
+// the listener doesn't want and the RMS a foregone conclusion.
+//
+// **What counts.** A code-0 (single-frame) packet whose frame is at most one
+// byte: exactly the frames libopus's decoder treats as missing. Larger
+// packets are never classified by size — their size tracks the bitrate the
+// link controller picks as much as the signal — so anything else decodes.
+//
+// Header-only arithmetic; no state.
+namespace opus_silence {
+
+inline bool isSilent(const uint8_t* packet, size_t len) {
+    if (len <= 1) return true;  // bare TOC: DTX
+    return len <= audio_config::kOpusSilentMaxBytes && (packet[0] & 0x3) == 0;
+}
+
+inline bool isSilent(const std::vector<uint8_t>& packet) {
+    return isSilent(packet.data(), packet.size());
+}
+
+}  // namespace opus_silence
+
+#endif  // OPUS_SILENCE_H
@@ -0,0 +1,57 @@
+#ifndef OPUS_TOC_H
+#define OPUS_TOC_H
+
+#include <cstddef>
+#include <cstdint>
+
+// How much audio an Opus packet holds, from its TOC byte (RFC 6716 §3.1)
+// and, for a code-3 packet, its frame-count byte.
+//
+// **Why.** With the low-latency profile (audio_config::kLowLatencyProfile) a
+// peer's frames may be 10 ms or 20 ms, and switch between the two at any
+// tick. libopus decodes either without being told, but the receive path
+// still has to know: a bundle (voice_bundle.h) carries one senderTsMs for
+// all its frames, so each later frame's timestamp is the first's plus the
+// duration of the frames before it.
+//
+// Header-only arithmetic; no state.
+namespace opus_toc {
+
+// Duration of one frame under the TOC's configuration, in microseconds
+// (CELT's shortest frames are 2.5 ms).
+inline uint32_t frameDurationUs(uint8_t toc) {
+    const int config = toc >> 3;
+    if (config < 12) {  // SILK-only: 10, 20, 40, 60 ms
+        static constexpr uint32_t kSilkUs[] = {10000, 20000, 40000, 60000};
+        return kSilkUs[config & 0x3];
+    }
+    if (config < 16) {  // hybrid: 10, 20 ms
+        return (config & 0x1) ? 20000 : 10000;
+    }
+    static constexpr uint32_t kCeltUs[] = {2500, 5000, 10000, 20000};
+    return kCeltUs[config & 0x3];
+}
+
+// Duration of the whole packet in microseconds, or 0 if it's too short to
+// say (empty, or code 3 without its frame-count byte).
+inline uint32_t packetDurationUs(const uint8_t* packet, size_t len) {
+    if (len == 0) return 0;
+    uint32_t frames = 1;
+    switch (packet[0] & 0x3) {
+        case 0:
+            break;
+        case 1:
+        case 2:
+            frames = 2;
+            break;
+        default:
+            if (len < 2) return 0;
+            frames = packet[1] & 0x3F;
+            break;
+    }
+    return frames * frameDurationUs(packet[0]);
+}
+
+}  // namespace opus_toc
+
+#endif  // OPUS_TOC_H
@@ -0,0 +1,249 @@
+#ifndef OUTBOUND_FRAME_RING_H
+#define OUTBOUND_FRAME_RING_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+#include "audio_config.h"
+
+// Single-producer, single-consumer ring of outbound VoiceFrames, already in
+// their L2CAP wire form: 2-byte big-endian length prefix, 8-byte VoiceFrame
+// header (seq, senderTsMs), Opus payload (docs/protocol.md, "VoiceFrame").
+//
+// **Why.** Every encoded packet used to cross into Kotlin through a
+// per-frame GetObjectClass + GetMethodID + NewStringUTF + NewByteArray +
+// CallVoidMethod, then got wrapped again in a VoiceFrame ByteArray and a
+// queue node before the writer thread saw it — 8 peers × 50 Hz of JNI
+// lookups and garbage. Now the mixer thread encodes straight into a slot
+// here, and the peer's L2CAP writer thread writes the slot to the socket
+// from a direct ByteBuffer over storage(). Nothing is allocated per frame.
+// A frame committed with a compact header (voice_header.h) is written flush
+// against its payload, so it starts a few bytes into its slot; peek() returns
+// where it starts.
+//
+// **Protocol.** Producer (mixer thread): writeSlot() for the payload area,
+// encode into it, commit(). Consumer (writer thread): acquire() (or peek())
+// for the offset of the next frame in storage(), write it, release().
+//
+// **Freshness** (favour the freshest audio, as the receiver does): the
+// consumer skips frames queued longer than kOutboundStaleBudgetMs, and trims
+// the backlog to the newest kOutboundQueueFrames — the drop-oldest policy,
+// applied from the consumer side because an SPSC producer can't pop. Only
+// when every slot is held (the writer stuck in a blocking socket write) does
+// the producer drop the new frame. Both drops are counted.
+//
+// **Backpressure.** depth() and oldestAgeMs() let the producer see the
+// backlog building before either drop happens, and stop encoding for the
+// peer until it clears (PeerAudioManager's mixer tick does).
+//
+// **Threading.** Lock-free between commit() and peek()/release(). acquire()
+// parks on a condition variable; commit() only takes its mutex when the
+// consumer is actually parked, so the mixer tick never contends with a busy
+// writer. claim()/unclaim() keep a reconnect's new writer off the ring until
+// the old one has let go, so there is only ever one consumer.
+class OutboundFrameRing {
+public:
+    static constexpr size_t kSlots = audio_config::kOutboundRingSlots;
+    static constexpr size_t kSlotBytes = audio_config::kOutboundSlotBytes;
+    static constexpr size_t kPrefixBytes = audio_config::kVoiceFrameLengthPrefixBytes;
+    static constexpr size_t kHeaderBytes = audio_config::kVoiceFrameHeaderBytes;
+    static constexpr size_t kCompactHeaderBytes = audio_config::kCompactHeaderBytes;
+    static constexpr size_t kMaxPayloadBytes = kSlotBytes - kPrefixBytes - kHeaderBytes;
+    static_assert((kSlots & (kSlots - 1)) == 0,
+                  "kSlots must be a power of two so we can use a mask");
+
+    // peek()/acquire() results other than a slot offset.
+    static constexpr int kEmpty = -1;   // nothing fresh to send (or timed out)
+    static constexpr int kClosed = -2;  // the peer is gone; detach
+
+    // ---- Producer (mixer thread) ----
+
+    // Payload area of the next free slot (kMaxPayloadBytes long), or nullptr
+    // when every slot is still held by the consumer.
+    uint8_t* writeSlot() {
+        const size_t w = head_.load(std::memory_order_relaxed);
+        const size_t r = tail_.load(std::memory_order_acquire);
+        if (w - r >= kSlots) return nullptr;
+        return slot(w) + kPrefixBytes + kHeaderBytes;
+    }
+
+    // Publish the slot writeSlot() returned, holding `payloadLen` bytes of
+    // payload. Fills in the length prefix and header — the compact form
+    // (audio_config::kCompactHeaderFlag) when `compactHeader` is set.
+    void commit(uint32_t seq, uint32_t senderTsMs, size_t payloadLen, int64_t nowMs,
+                bool compactHeader = false) {
+        const size_t w = head_.load(std::memory_order_relaxed);
+        const size_t start = compactHeader ? kHeaderBytes - kCompactHeaderBytes : 0;
+        uint8_t* s = slot(w) + start;
+        if (compactHeader) {
+            const size_t prefix =
+                (kCompactHeaderBytes + payloadLen) | audio_config::kCompactHeaderFlag;
+            s[0] = static_cast<uint8_t>(prefix >> 8);
+            s[1] = static_cast<uint8_t>(prefix);
+            s[kPrefixBytes] = static_cast<uint8_t>(seq);
+            s[kPrefixBytes + 1] = static_cast<uint8_t>(senderTsMs >> 8);
+            s[kPrefixBytes + 2] = static_cast<uint8_t>(senderTsMs);
+        } else {
+            const size_t frameLen = kHeaderBytes + payloadLen;
+            s[0] = static_cast<uint8_t>(frameLen >> 8);
+            s[1] = static_cast<uint8_t>(frameLen);
+            writeBe32(s + kPrefixBytes, seq);
+            writeBe32(s + kPrefixBytes + 4, senderTsMs);
+        }
+        frameStart_[w & (kSlots - 1)] = static_cast<uint8_t>(start);
+        enqueuedMs_[w & (kSlots - 1)] = nowMs;
+        head_.store(w + 1, std::memory_order_release);
+        if (consumerWaiting_.load()) {
+            std::lock_guard<std::mutex> lock(waitMutex_);
+            waitCv_.notify_one();
+        }
+    }
+
+    // Count a frame dropped because writeSlot() found the ring full.
+    void noteFullDrop() { fullDrops_.fetch_add(1, std::memory_order_relaxed); }
+
+    // Count a frame the producer didn't encode because the ring was
+    // congested (see audio_config::kOutboundCongestedFrames).
+    void noteCongestionSkip() { skips_.fetch_add(1, std::memory_order_relaxed); }
+
+    // How long the oldest frame still queued has waited, or 0 when empty.
+    // Producer side: the enqueue times are only ever written by commit().
+    int64_t oldestAgeMs(int64_t nowMs) const {
+        const size_t r = tail_.load(std::memory_order_acquire);
+        if (r == head_.load(std::memory_order_relaxed)) return 0;
+        return nowMs - enqueuedMs_[r & (kSlots - 1)];
+    }
+
+    // The peer is being unregistered: wake the consumer with kClosed.
+    void close() {
+        closed_.store(true);
+        std::lock_guard<std::mutex> lock(waitMutex_);
+        waitCv_.notify_all();
+    }
+
+    // ---- Consumer (writer thread) ----
+
+    // Take exclusive consumer rights. False if another writer holds them.
+    bool claim() {
+        bool expected = false;
+        if (!claimed_.compare_exchange_strong(expected, true)) return false;
+        claims_.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+    void unclaim() { claimed_.store(false); }
+
+    // Offset in storage() of the next frame to send (its length prefix), or
+    // kEmpty / kClosed. Sheds stale and over-backlog frames first. Does not
+    // consume the frame; release() does, once it's on the wire.
+    int peek(int64_t nowMs) {
+        if (closed_.load(std::memory_order_acquire)) return kClosed;
+        size_t r = tail_.load(std::memory_order_relaxed);
+        const size_t w = head_.load(std::memory_order_acquire);
+        size_t shed = 0;
+        while (w - r > audio_config::kOutboundQueueFrames ||
+               (r != w && nowMs - enqueuedMs_[r & (kSlots - 1)] >
+                              audio_config::kOutboundStaleBudgetMs)) {
+            ++r;
+            ++shed;
+        }
+        if (shed > 0) {
+            staleDrops_.fetch_add(shed, std::memory_order_relaxed);
+            tail_.store(r, std::memory_order_release);
+        }
+        if (r == w) return kEmpty;
+        return static_cast<int>((r & (kSlots - 1)) * kSlotBytes + frameStart_[r & (kSlots - 1)]);
+    }
+
+    // peek(), parking up to `timeoutMs` for the producer when there's
+    // nothing to send.
+    int acquire(int timeoutMs) {
+        const auto deadline =
+            std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+        for (;;) {
+            const int r = peek(nowMs());
+            if (r != kEmpty) return r;
+            std::unique_lock<std::mutex> lock(waitMutex_);
+            // Announce the wait before re-checking, so a commit() racing us
+            // either sees the flag (and notifies under the mutex) or has
+            // already published a frame the re-check finds.
+            consumerWaiting_.store(true);
+            if (empty() && !closed_.load()) {
+                if (waitCv_.wait_until(lock, deadline) == std::cv_status::timeout) {
+                    consumerWaiting_.store(false);
+                    lock.unlock();
+                    return peek(nowMs());
+                }
+            }
+            consumerWaiting_.store(false);
+        }
+    }
+
+    // The frame peek()/acquire() returned is on the wire; free its slot.
+    void release() {
+        const size_t r = tail_.load(std::memory_order_relaxed);
+        if (r != head_.load(std::memory_order_acquire)) {
+            tail_.store(r + 1, std::memory_order_release);
+        }
+    }
+
+    // ---- Either side ----
+
+    // The slots, back to back: what the consumer's direct ByteBuffer wraps.
+    uint8_t* storage() { return storage_; }
+    static constexpr size_t storageBytes() { return kSlots * kSlotBytes; }
+
+    size_t depth() const {
+        return head_.load(std::memory_order_acquire) - tail_.load(std::memory_order_acquire);
+    }
+    uint64_t staleDropCount() const { return staleDrops_.load(std::memory_order_relaxed); }
+    uint64_t fullDropCount() const { return fullDrops_.load(std::memory_order_relaxed); }
+    uint64_t congestionSkipCount() const { return skips_.load(std::memory_order_relaxed); }
+
+    // Changes whenever the receiver may have missed a frame committed here:
+    // a drop of either kind, or a new writer (a new stream) taking over.
+    uint64_t continuityEpoch() const {
+        return staleDropCount() + fullDropCount() + claims_.load(std::memory_order_relaxed);
+    }
+
+private:
+    static int64_t nowMs() {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(
+                   std::chrono::steady_clock::now().time_since_epoch())
+            .count();
+    }
+
+    static void writeBe32(uint8_t* p, uint32_t v) {
+        p[0] = static_cast<uint8_t>(v >> 24);
+        p[1] = static_cast<uint8_t>(v >> 16);
+        p[2] = static_cast<uint8_t>(v >> 8);
+        p[3] = static_cast<uint8_t>(v);
+    }
+
+    uint8_t* slot(size_t index) { return storage_ + (index & (kSlots - 1)) * kSlotBytes; }
+
+    bool empty() const {
+        return head_.load(std::memory_order_acquire) ==
+               tail_.load(std::memory_order_relaxed);
+    }
+
+    uint8_t storage_[kSlots * kSlotBytes];
+    int64_t enqueuedMs_[kSlots]{};
+    uint8_t frameStart_[kSlots]{};  // offset of the prefix within the slot
+    std::atomic<size_t> head_{0};  // next slot the producer commits
+    std::atomic<size_t> tail_{0};  // next slot the consumer sends
+    std::atomic<bool> closed_{false};
+    std::atomic<bool> claimed_{false};
+    std::atomic<bool> consumerWaiting_{false};
+    std::atomic<uint64_t> staleDrops_{0};
+    std::atomic<uint64_t> fullDrops_{0};
+    std::atomic<uint64_t> skips_{0};
+    std::atomic<uint64_t> claims_{0};
+    std::mutex waitMutex_;
+    std::condition_variable waitCv_;
+};
+
+#endif  // OUTBOUND_FRAME_RING_H
@@ -1,14 +1,25 @@
 #include "peer_audio_manager.h"
 
 #include <android/log.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/resource.h>
+#include <time.h>
+#include <unistd.h>
 
 #include <algorithm>
+#include <cerrno>
 #include <chrono>
+#include <climits>
 #include <cmath>
 #include <cstdint>
+#include <cstring>
+#include <iterator>
 #include <thread>
 #include <utility>
 
+#include "voice_frame_parser.h"
+
 #define LOG_TAG "PeerAudioManager"
 #define LOGI(...) __android_log_print(ANDROID_LOG_INFO, LOG_TAG, __VA_ARGS__)
 #define LOGW(...) __android_log_print(ANDROID_LOG_WARN, LOG_TAG, __VA_ARGS__)
@@ -49,9 +60,121 @@ int crossfadeMergeFrames(int16_t* a, int aLen, const int16_t* b, int bLen) {
     return n;
 }
 
+// Fade PLC frame `tailPos` (1-based position in a run of consecutive
+// concealed frames) in place. Frame 1 is untouched; frames 2..kPlcTailFrames
+// ramp linearly so the gain is continuous across frame boundaries and reaches
+// exactly zero at the end of the last one. Opus's own PLC decays too, but not
+// to silence on any fixed schedule — this bounds the tail.
+void fadePlcTail(int16_t* pcm, int n, int tailPos) {
+    if (tailPos <= 1 || n <= 0) return;
+    constexpr float kFadeFrames =
+        static_cast<float>(audio_config::kPlcTailFrames - 1);
+    const float startGain =
+        static_cast<float>(audio_config::kPlcTailFrames - tailPos + 1) /
+        kFadeFrames;
+    const float endGain = std::max(
+        0.0f, static_cast<float>(audio_config::kPlcTailFrames - tailPos) /
+                  kFadeFrames);
+    const float step = (endGain - startGain) / static_cast<float>(n);
+    for (int i = 0; i < n; ++i) {
+        const float g = std::max(0.0f, startGain + step * static_cast<float>(i + 1));
+        pcm[i] = static_cast<int16_t>(std::lround(static_cast<float>(pcm[i]) * g));
+    }
+}
+
+// RMS of `n` samples, normalised to [0, 1] as VadDetector's threshold is,
+// from every `stride`-th sample (the tick governor's cheaper estimate).
+double frameRms(const int16_t* pcm, int n, int stride = 1) {
+    double sum = 0.0;
+    int count = 0;
+    for (int j = 0; j < n; j += stride, ++count) {
+        const double s = pcm[j] / 32768.0;
+        sum += s * s;
+    }
+    return std::sqrt(sum / count);
+}
+
+// steady_clock in ms: the receive path's arrival clock, and the warm-start
+// cache's age clock.
+int64_t steadyNowMs() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+// CLOCK_BOOTTIME in ms, truncated to the VoiceFrame's 32-bit senderTsMs —
+// the native twin of SystemClock.elapsedRealtime(). Monotonic (immune to
+// NTP and manual clock changes, which would make every frame look stale to
+// the receiver's lag estimator) and still counting through deep sleep.
+uint32_t senderTimestampMs() {
+    timespec ts{};
+    clock_gettime(CLOCK_BOOTTIME, &ts);
+    return static_cast<uint32_t>(static_cast<int64_t>(ts.tv_sec) * 1000 +
+                                 ts.tv_nsec / 1000000);
+}
+
+// CLOCK_MONOTONIC in ns. The tick schedules against this clock directly
+// (rather than steady_clock) because it's the clock clock_nanosleep takes.
+int64_t monotonicNowNs() {
+    timespec ts{};
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<int64_t>(ts.tv_sec) * 1000000000LL + ts.tv_nsec;
+}
+
+// Sleep until an absolute CLOCK_MONOTONIC deadline. Returns immediately if
+// the deadline has passed. Unlike sleep_for(deadline - now), a late wake
+// doesn't push the next deadline back: the tick cadence can't accumulate
+// wake-up latency.
+void sleepUntilNs(int64_t deadlineNs) {
+    timespec ts{};
+    ts.tv_sec = static_cast<time_t>(deadlineNs / 1000000000LL);
+    ts.tv_nsec = static_cast<long>(deadlineNs % 1000000000LL);
+    // clock_nanosleep returns the error number rather than setting errno.
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr) ==
+           EINTR) {
+    }
+}
+
+// Saturating ns → µs for the tick histograms.
+uint32_t nsToUs(int64_t ns) {
+    if (ns <= 0) return 0;
+    return static_cast<uint32_t>(
+        std::min<int64_t>(ns / 1000, static_cast<int64_t>(UINT32_MAX)));
+}
+
+// Raise the calling (mixer) thread's scheduling priority. SCHED_FIFO is
+// tried only when configured, and is expected to fail with EPERM for an
+// ordinary app; the nice value is the fallback that does take effect.
+// Failure of either is logged and otherwise harmless — the tick still runs,
+// just with more wake lateness under load.
+void raiseMixerThreadPriority() {
+    if (audio_config::kMixerTickFifoPriority > 0) {
+        sched_param param{};
+        param.sched_priority = audio_config::kMixerTickFifoPriority;
+        const int err =
+            pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+        if (err == 0) {
+            LOGI("Mixer tick running SCHED_FIFO priority %d",
+                 audio_config::kMixerTickFifoPriority);
+            return;
+        }
+        LOGW("Mixer tick SCHED_FIFO refused (%s); falling back to nice %d",
+             strerror(err), audio_config::kMixerTickNice);
+    }
+    if (setpriority(PRIO_PROCESS, static_cast<id_t>(gettid()),
+                    audio_config::kMixerTickNice) != 0) {
+        LOGW("Mixer tick setpriority(%d) failed (%s)",
+             audio_config::kMixerTickNice, strerror(errno));
+    }
+}
+
 }  // namespace
 
-PeerAudioManager::PeerAudioManager() { LOGI("PeerAudioManager created"); }
+PeerAudioManager::PeerAudioManager() {
+    warmSpares_.reserve(audio_config::kPeerWarmSpares);
+    refillWarmSpares();
+    LOGI("PeerAudioManager created");
+}
 
 PeerAudioManager::~PeerAudioManager() {
     stopMixerThread();
@@ -66,12 +189,13 @@ PeerAudioManager::~PeerAudioManager() {
                 env->DeleteGlobalRef(callbackObject_);
             }
             callbackObject_ = nullptr;
+            talkingMaskMethod_ = nullptr;
         }
     }
 }
 
 int PeerAudioManager::registerPeer(const std::string& macAddress) {
-    std::lock_guard<std::mutex> lock(peerRegistryMutex_);
+    std::unique_lock<std::mutex> lock(peerRegistryMutex_);
 
     auto it = peers_.find(macAddress);
     if (it != peers_.end()) {
@@ -87,10 +211,18 @@ int PeerAudioManager::registerPeer(const std::string& macAddress) {
         // no path locks in reverse.
         {
             std::lock_guard<std::mutex> stateLock(it->second->mutex);
+            saveWarmStart(macAddress, *it->second);
+            // Frames queued from the old link are as stale as its buffer.
+            it->second->arrivals.clear();
             it->second->jitterBuffer->reset();
             it->second->peerVad.reset();
             it->second->sheddingStale = false;
             it->second->lagEstimator.reset();
+            // A new link may be a different device (or the same one after a
+            // reboot): its clock skew has to be re-learned from scratch, and
+            // the resampler must not replay the old link's tail.
+            it->second->driftEstimator.reset();
+            it->second->driftResampler.reset();
             // The jitter buffer was just emptied, so the first ticks of the
             // rejoin will underrun. Zero the underrun hysteresis too: a counter
             // left at >= 2 from the previous link would fire the popAny() drain
@@ -98,20 +230,77 @@ int PeerAudioManager::registerPeer(const std::string& macAddress) {
             // after the intended cold-start hysteresis — defeating the
             // cold-start playhead/depth this reset block exists to enforce.
             it->second->consecutiveUnderruns = 0;
+            it->second->plcDormant = false;
+            it->second->dormantHeldTicks = 0;
+            it->second->decodeSeqValid = false;
+            // Whatever the old link negotiated is renegotiated from the
+            // defaults, as for a new peer: bundling waits for the new
+            // link's offer, and rate control starts over. The tick resets
+            // what it owns, rate control included (linkRenewed).
+            it->second->peerBundleFrames.store(1, std::memory_order_relaxed);
+            it->second->framesPerPacket.store(1, std::memory_order_relaxed);
+            it->second->peerCompactHeaders.store(false, std::memory_order_relaxed);
+            // An end-of-talkspurt the old link announced doesn't apply to
+            // the new one, nor does the known-silence run it left off in.
+            it->second->talkspurtEnded.store(false, std::memory_order_relaxed);
+            it->second->silentRun = false;
+            // The new link offers pre-roll afresh, and its first voice opens
+            // a talkspurt.
+            it->second->peerPreRollFrames.store(0, std::memory_order_relaxed);
+            it->second->talkspurtPending = true;
+            it->second->catchUpFrames = 0;
+            it->second->catchUpMergeDue = false;
+            // A device back on a new link asks for 10 ms frames afresh, or
+            // not at all: it only withdraws an ask on the link it made it.
+            it->second->peerFrameMs.store(audio_config::kFrameDurationMs,
+                                          std::memory_order_relaxed);
+            it->second->linkRenewed.store(true, std::memory_order_release);
+            // ...except what the link taught us about its jitter and
+            // transit, which the same device is likely to repeat.
+            applyWarmStart(macAddress, *it->second);
         }
         // If the peer was previously talking, its VAD state just flipped to
-        // silent; mark dirty so the mixer tick emits a corrected talking set.
+        // silent; mark dirty so a parked mixer wakes to republish the set.
         talkingPeersDirty_.store(true, std::memory_order_release);
+        wakeMixer();
         LOGI("Peer %s already registered with device ID %d (state reset)",
              macAddress.c_str(), it->second->deviceId);
         return it->second->deviceId;
     }
 
-    auto state = std::make_shared<PeerState>();
-    state->deviceId = nextDeviceId_++;
-    state->encoder = std::make_unique<OpusEncoder>();
-    state->decoder = std::make_unique<OpusDecoder>();
-    state->jitterBuffer = std::make_unique<JitterBuffer>();
+    // The device ID doubles as the peer's handle, so it must land on a free
+    // slot of the handle table. IDs still only move forward — a stale handle
+    // from an unregistered peer can never resolve to a newer one, not even
+    // across clear() or a manager nativeInit built after nativeClear.
+    int deviceId = -1;
+    for (size_t tries = 0; tries < slots_.size(); ++tries) {
+        int candidate = nextDeviceId_.load(std::memory_order_relaxed);
+        while (!nextDeviceId_.compare_exchange_weak(
+            candidate, candidate == INT_MAX ? 1 : candidate + 1,
+            std::memory_order_relaxed)) {
+        }
+        if (!std::atomic_load(&slots_[slotFor(candidate)])) {
+            deviceId = candidate;
+            break;
+        }
+    }
+    if (deviceId < 0) {
+        LOGE("Peer %s not registered: all %zu handle slots in use",
+             macAddress.c_str(), slots_.size());
+        return -1;
+    }
+
+    std::shared_ptr<PeerState> state;
+    if (!warmSpares_.empty()) {
+        state = std::move(warmSpares_.back());
+        warmSpares_.pop_back();
+    } else {
+        LOGI("Peer %s: warm pool empty, building its state", macAddress.c_str());
+        state = buildPeerState();
+    }
+    state->deviceId = deviceId;
+    // Not yet published to the mixer thread, so no lock needed.
+    applyWarmStart(macAddress, *state);
     state->bitrate.store(audio_config::kDefaultBitrate,
                          std::memory_order_relaxed);
 
@@ -123,7 +312,11 @@ int PeerAudioManager::registerPeer(const std::string& macAddress) {
     LOGI("Peer %s registered with device ID %d", macAddress.c_str(),
          state->deviceId);
     int id = state->deviceId;
+    std::atomic_store(&slots_[slotFor(id)], state);
     peers_[macAddress] = std::move(state);
+    lock.unlock();
+    // The peer is live; replace its spare for the next join.
+    refillWarmSpares();
     return id;
 }
 
@@ -135,20 +328,122 @@ void PeerAudioManager::unregisterPeer(const std::string& macAddress) {
         return;
     }
     int deviceId = it->second->deviceId;
+    {
+        std::lock_guard<std::mutex> stateLock(it->second->mutex);
+        saveWarmStart(macAddress, *it->second);
+    }
 
     if (auto mixer = std::atomic_load(&g_audioMixer)) {
         mixer->removeDevice(deviceId);
     }
 
     deviceIdToMac_.erase(deviceId);
+    std::atomic_store(&slots_[slotFor(deviceId)], std::shared_ptr<PeerState>());
+    // Wake the peer's writer thread so it lets go of the ring.
+    it->second->outbound->close();
     peers_.erase(it);
-    // Signal the mixer tick to emit a fresh talkingPeers update even if no VAD
-    // edge fires on a surviving peer. Without this, a talking peer that leaves
-    // would remain in Flutter's last-known talking set indefinitely.
+    // Wake a parked mixer so it republishes the talking set without this
+    // peer. Without this, a talking peer that leaves would remain in
+    // Flutter's last-known talking set until the room next woke.
     talkingPeersDirty_.store(true, std::memory_order_release);
+    wakeMixer();
     LOGI("Peer %s (device ID %d) unregistered", macAddress.c_str(), deviceId);
 }
 
+size_t PeerAudioManager::warmSpareCount() {
+    std::lock_guard<std::mutex> lock(peerRegistryMutex_);
+    return warmSpares_.size();
+}
+
+std::shared_ptr<PeerAudioManager::PeerState> PeerAudioManager::buildPeerState() {
+    auto state = std::make_shared<PeerState>();
+    state->encoder = std::make_unique<OpusEncoder>();
+    state->decoder = std::make_unique<OpusDecoder>();
+    state->jitterBuffer = std::make_unique<JitterBuffer>();
+    state->jitterBuffer->setStartDepth(audio_config::kJitterFastStartDepth);
+    return state;
+}
+
+void PeerAudioManager::refillWarmSpares() {
+    for (;;) {
+        {
+            std::lock_guard<std::mutex> lock(peerRegistryMutex_);
+            if (warmSpares_.size() >= audio_config::kPeerWarmSpares) return;
+        }
+        std::shared_ptr<PeerState> spare = buildPeerState();
+        std::lock_guard<std::mutex> lock(peerRegistryMutex_);
+        // A concurrent refill may have filled the pool meanwhile.
+        if (warmSpares_.size() >= audio_config::kPeerWarmSpares) return;
+        warmSpares_.push_back(std::move(spare));
+    }
+}
+
+void PeerAudioManager::saveWarmStart(const std::string& macAddress,
+                                     PeerState& state) {
+    // A link that never played has learned nothing; keep any older profile.
+    if (!state.jitterBuffer->primed()) {
+        return;
+    }
+    WarmStartProfile profile;
+    profile.jitter = state.jitterBuffer->adaptState();
+    profile.hasLagBaseline = state.lagEstimator.hasBaseline();
+    profile.lagBaselineRawDelay = state.lagEstimator.baselineRawDelay();
+    profile.savedAtMs = steadyNowMs();
+    warmStart_[macAddress] = profile;
+
+    // Bounded: a long session meets many MACs (BLE address rotation alone
+    // guarantees it), and an old profile is worthless anyway.
+    while (warmStart_.size() > audio_config::kWarmStartCacheEntries) {
+        auto oldest = warmStart_.begin();
+        for (auto e = warmStart_.begin(); e != warmStart_.end(); ++e) {
+            if (e->second.savedAtMs < oldest->second.savedAtMs) oldest = e;
+        }
+        warmStart_.erase(oldest);
+    }
+}
+
+void PeerAudioManager::applyWarmStart(const std::string& macAddress,
+                                      PeerState& state) {
+    auto it = warmStart_.find(macAddress);
+    if (it == warmStart_.end()) {
+        return;
+    }
+    const WarmStartProfile profile = it->second;
+    warmStart_.erase(it);
+    if (steadyNowMs() - profile.savedAtMs > audio_config::kWarmStartMaxAgeMs) {
+        return;
+    }
+    // The buffer still cold-starts (fast start, fresh playhead); it just
+    // ramps to the target the link had earned rather than the default.
+    state.jitterBuffer->seedAdaptState(profile.jitter);
+    if (profile.hasLagBaseline) {
+        state.lagEstimator.seedBaseline(profile.lagBaselineRawDelay);
+    }
+    LOGI("Peer %s warm-started (target depth %zu)", macAddress.c_str(),
+         state.jitterBuffer->targetDepth());
+}
+
+std::shared_ptr<PeerAudioManager::PeerState> PeerAudioManager::findPeer(
+    const std::string& macAddress) {
+    std::lock_guard<std::mutex> lock(peerRegistryMutex_);
+    auto it = peers_.find(macAddress);
+    return it != peers_.end() ? it->second : nullptr;
+}
+
+std::shared_ptr<PeerAudioManager::PeerState> PeerAudioManager::findPeer(
+    int handle) const {
+    if (handle <= 0) return nullptr;
+    auto state = std::atomic_load(&slots_[slotFor(handle)]);
+    // The slot may since have been handed to a newer peer.
+    if (state && state->deviceId != handle) return nullptr;
+    return state;
+}
+
+std::shared_ptr<OutboundFrameRing> PeerAudioManager::outboundRing(int handle) {
+    auto state = findPeer(handle);
+    return state ? state->outbound : nullptr;
+}
+
 int PeerAudioManager::getDeviceId(const std::string& macAddress) {
     std::lock_guard<std::mutex> lock(peerRegistryMutex_);
     auto it = peers_.find(macAddress);
@@ -165,108 +460,385 @@ bool PeerAudioManager::onVoiceFramePushed(const std::string& macAddress,
                                           uint32_t seq, uint32_t senderTsMs,
                                           const uint8_t* opusData,
                                           int opusSize) {
-    std::shared_ptr<PeerState> state;
-    {
-        std::lock_guard<std::mutex> lock(peerRegistryMutex_);
-        auto it = peers_.find(macAddress);
-        if (it == peers_.end()) {
-            // VOICE-DIAG: frames arriving for a peer with no registered
-            // audio state — inbound leg is up but the decode path is dead.
-            // Throttled so a sustained mismatch doesn't flood logcat.
-            static int dropLog = 0;
-            if (dropLog++ % 50 == 0) {
-                LOGW("VOICE-DIAG drop: frame seq=%u for unregistered peer %s",
-                     seq, macAddress.c_str());
-            }
-            return false;
+    // shared_ptr keeps state alive past the registry unlock.
+    std::shared_ptr<PeerState> state = findPeer(macAddress);
+    if (!state) {
+        // VOICE-DIAG: frames arriving for a peer with no registered
+        // audio state — inbound leg is up but the decode path is dead.
+        // Throttled so a sustained mismatch doesn't flood logcat.
+        static int dropLog = 0;
+        if (dropLog++ % 50 == 0) {
+            LOGW("VOICE-DIAG drop: frame seq=%u for unregistered peer %s",
+                 seq, macAddress.c_str());
         }
-        state = it->second;  // shared_ptr keeps state alive past unlock.
+        return false;
     }
+    return pushFrame(*state, seq, senderTsMs, opusData, opusSize);
+}
 
+bool PeerAudioManager::onVoiceFramePushed(int handle, uint32_t seq,
+                                          uint32_t senderTsMs,
+                                          const uint8_t* opusData,
+                                          int opusSize) {
+    std::shared_ptr<PeerState> state = findPeer(handle);
+    if (!state) {
+        static int dropLog = 0;
+        if (dropLog++ % 50 == 0) {
+            LOGW("VOICE-DIAG drop: frame seq=%u for unregistered handle %d",
+                 seq, handle);
+        }
+        return false;
+    }
+    return pushFrame(*state, seq, senderTsMs, opusData, opusSize);
+}
+
+bool PeerAudioManager::pushFrame(PeerState& state, uint32_t seq,
+                                 uint32_t senderTsMs, const uint8_t* opusData,
+                                 int opusSize) {
     // Local arrival time on a monotonic clock. Both ends are now monotonic
     // (sender: SystemClock.elapsedRealtime; receiver: steady_clock), so neither
     // jumps under NTP. PlayoutLagEstimator only uses *differences*, and its
     // sliding-window-min cancels the constant offset between the two monotonic
-    // epochs.
-    const int64_t recvMs =
-        std::chrono::duration_cast<std::chrono::milliseconds>(
-            std::chrono::steady_clock::now().time_since_epoch())
-            .count();
-
-    // JitterBuffer is not thread-safe; we serialize against the mixer
-    // thread's tick/pop here.
-    std::lock_guard<std::mutex> stateLock(state->mutex);
-
-    const int64_t excessMs = state->lagEstimator.feed(senderTsMs, recvMs);
-    state->lastLagMs = excessMs;
+    // epochs. Read here, not at drain time, so queueing doesn't read as transit.
+    const int64_t recvMs = steadyNowMs();
+    bool queued = false;
+    if (opusSize > 0 &&
+        voice_bundle::isBundle(opusData, static_cast<size_t>(opusSize))) {
+        // Several frames in one VoiceFrame: each gets its own seq, and so its
+        // own jitter-buffer slot, encoded as long after the last as the last
+        // one lasted — 10 or 20 ms, read from its TOC (opus_toc.h).
+        size_t pushed = 0;
+        uint32_t frameTsMs = senderTsMs;
+        const int frames = voice_bundle::unpack(
+            opusData, static_cast<size_t>(opusSize),
+            [&](size_t i, const uint8_t* frame, size_t len) {
+                if (state.arrivals.push(seq + static_cast<uint32_t>(i),
+                                        frameTsMs, recvMs, frame, len)) {
+                    ++pushed;
+                }
+                frameTsMs += opus_toc::packetDurationUs(frame, len) / 1000;
+            });
+        queued = frames > 0 && pushed == static_cast<size_t>(frames);
+    } else if (opusSize > 0) {
+        queued = state.arrivals.push(seq, senderTsMs, recvMs, opusData,
+                                     static_cast<size_t>(opusSize));
+    }
 
-    // Staleness drop (Kevin's timestamp-drop). A frame whose transit sits far
-    // above the best recent baseline has been languishing — most likely
-    // seconds deep in the sender's kernel L2CAP TX buffer, which our per-stage
-    // caps can't see. Playing it would pin playout that far behind real time,
-    // so drop it before it enters the jitter buffer.
-    //
-    // No-silence guard: only drop once the stream is live (playhead primed)
-    // AND there's already buffered audio to play in its place. On a cold start
-    // or a fully-drained buffer we accept even a stale frame rather than starve
-    // the consumer to silence — choppy-but-present beats dead air.
-    if (PlayoutLagEstimator::isStale(excessMs) &&
-        state->jitterBuffer->playheadInitialized() &&
-        state->jitterBuffer->currentDepth() > 0) {
-        ++state->staleDropCount;
-        state->sheddingStale = true;
+    // Any arrival — even one about to be dropped or shed as stale — means the
+    // room is live: keep the mixer tick out of its idle park, or wake it. The
+    // frame plays on the first tick after the wake.
+    frameArrived_.store(true);
+    wakeMixer();
+
+    if (!queued) {
+        static int dropLog = 0;
+        if (dropLog++ % 50 == 0) {
+            LOGW("VOICE-DIAG drop: arrival queue refused seq=%u (%d bytes, "
+                 "%llu refused so far)",
+                 seq, opusSize,
+                 static_cast<unsigned long long>(state.arrivals.droppedCount()));
+        }
         return false;
     }
+    if (decodeOnArrival_.load(std::memory_order_relaxed)) {
+        std::lock_guard<std::mutex> stateLock(state.mutex);
+        ingestArrivals(state);
+    }
+    return true;
+}
 
-    // Accepting. If we were shedding a stale backlog, the seqs we dropped would
-    // otherwise read as a hole-at-head when this frame plays — inflating
-    // lostFrameCount (which drives bitrate) and PLC-pacing a gap that wasn't
-    // network loss. Resync the playhead to this seq (effective only once the
-    // buffer has drained to empty) so the shed is a clean cut, not phantom loss.
-    if (state->sheddingStale) {
-        state->jitterBuffer->resyncPlayheadIfEmpty(seq);
-        state->sheddingStale = false;
+void PeerAudioManager::onLinkControlFrame(int handle, uint32_t opcode,
+                                          uint32_t arg) {
+    std::shared_ptr<PeerState> state = findPeer(handle);
+    if (!state) return;
+    if (opcode == audio_config::kLinkControlBundleOffer) {
+        const int frames = static_cast<int>(std::min<uint32_t>(
+            std::max<uint32_t>(arg, 1), audio_config::kMaxBundleFrames));
+        if (state->peerBundleFrames.exchange(frames) != frames) {
+            LOGI("Peer %d unpacks up to %d frame(s) per VoiceFrame", handle,
+                 frames);
+        }
+    } else if (opcode == audio_config::kLinkControlTalkspurtEnd) {
+        state->talkspurtEndSeq.store(arg, std::memory_order_relaxed);
+        state->talkspurtEnded.store(true, std::memory_order_release);
+    } else if (opcode == audio_config::kLinkControlLowLatencyOffer) {
+        // `arg` is the frame duration the peer wants; anything but the
+        // low-latency frame means the default.
+        const int frameMs =
+            arg == static_cast<uint32_t>(audio_config::kLowLatencyFrameDurationMs)
+                ? audio_config::kLowLatencyFrameDurationMs
+                : audio_config::kFrameDurationMs;
+        if (state->peerFrameMs.exchange(frameMs) != frameMs) {
+            LOGI("Peer %d asks for %d ms frames", handle, frameMs);
+        }
+    } else if (opcode == audio_config::kLinkControlPreRollOffer) {
+        const int frames = static_cast<int>(
+            std::min<uint32_t>(arg, audio_config::kPreRollFrames));
+        if (state->peerPreRollFrames.exchange(frames) != frames) {
+            LOGI("Peer %d opens talkspurts with up to %d frame(s) of pre-roll",
+                 handle, frames);
+        }
+    } else if (opcode == audio_config::kLinkControlCompactHeaderOffer) {
+        // `arg` is the newest header version the peer reads; we only speak 1.
+        const bool compact = arg >= audio_config::kCompactHeaderVersion;
+        if (state->peerCompactHeaders.exchange(compact) != compact) {
+            LOGI("Peer %d %s compact VoiceFrame headers", handle,
+                 compact ? "decodes" : "no longer decodes");
+        }
     }
+    // Other opcodes are from a newer peer; ignore them.
+}
+
+size_t PeerAudioManager::drainArrivals(const std::string& macAddress) {
+    std::shared_ptr<PeerState> state = findPeer(macAddress);
+    return state ? lockedDrain(*state) : 0;
+}
+
+size_t PeerAudioManager::drainArrivals(int handle) {
+    std::shared_ptr<PeerState> state = findPeer(handle);
+    return state ? lockedDrain(*state) : 0;
+}
+
+size_t PeerAudioManager::lockedDrain(PeerState& state) {
+    std::lock_guard<std::mutex> stateLock(state.mutex);
+    return ingestArrivals(state);
+}
+
+size_t PeerAudioManager::ingestArrivals(PeerState& state) {
+    // An announced pause. Taken before the drain, so the drain covers every
+    // frame the peer sent before announcing it.
+    if (state.talkspurtEnded.exchange(false, std::memory_order_acquire)) {
+        state.jitterBuffer->expectGap(
+            state.talkspurtEndSeq.load(std::memory_order_relaxed));
+        state.catchUpFrames = 0;
+        state.catchUpMergeDue = false;
+    }
+    size_t accepted = 0;
+    for (const ArrivalQueue::Arrival* a = state.arrivals.front(); a != nullptr;
+         state.arrivals.pop(), a = state.arrivals.front()) {
+        const int64_t excessMs = state.lagEstimator.feed(a->senderTsMs, a->recvMs);
+        state.lastLagMs = excessMs;
+        // Every arrival feeds the drift fit — including the ones about to be
+        // shed as stale: the estimator keys on per-block *minimum* transit, so
+        // a backlogged frame can't bias it, and skipping them would starve the
+        // fit exactly when the sender's clock is running away from ours.
+        state.driftEstimator.feed(a->senderTsMs, a->recvMs);
+
+        // Staleness drop (Kevin's timestamp-drop). A frame whose transit sits
+        // far above the best recent baseline has been languishing — most
+        // likely seconds deep in the sender's kernel L2CAP TX buffer, which
+        // our per-stage caps can't see. Playing it would pin playout that far
+        // behind real time, so drop it before it enters the jitter buffer.
+        //
+        // No-silence guard: only drop once the stream is live (playhead
+        // primed) AND there's already buffered audio to play in its place. On
+        // a cold start or a fully-drained buffer we accept even a stale frame
+        // rather than starve the consumer to silence — choppy-but-present
+        // beats dead air.
+        if (PlayoutLagEstimator::isStale(excessMs) &&
+            state.jitterBuffer->playheadInitialized() &&
+            state.jitterBuffer->currentDepth() > 0) {
+            ++state.staleDropCount;
+            state.sheddingStale = true;
+            continue;
+        }
+
+        // Accepting. If we were shedding a stale backlog, the seqs we dropped
+        // would otherwise read as a hole-at-head when this frame plays —
+        // inflating lostFrameCount (which drives bitrate) and PLC-pacing a gap
+        // that wasn't network loss. Resync the playhead to this seq (effective
+        // only once the buffer has drained to empty) so the shed is a clean
+        // cut, not phantom loss.
+        if (state.sheddingStale) {
+            state.jitterBuffer->resyncPlayheadIfEmpty(a->seq);
+            state.sheddingStale = false;
+        }
 
-    const bool accepted =
-        state->jitterBuffer->push(seq, opusData, static_cast<size_t>(opusSize));
-    if (accepted) {
-        ++state->recvCount;
-        state->lastAcceptedSeq = seq;
+        if (state.jitterBuffer->push(a->seq, a->payload, a->size)) {
+            ++accepted;
+            ++state.recvCount;
+            state.lastAcceptedSeq = a->seq;
+        }
+    }
+    if (accepted > 0 && decodeOnArrival_.load(std::memory_order_relaxed)) {
+        decodeAhead(state);
     }
     return accepted;
 }
 
 int PeerAudioManager::setPeerBitrate(const std::string& macAddress, int bps) {
-    std::shared_ptr<PeerState> state;
-    {
-        std::lock_guard<std::mutex> lock(peerRegistryMutex_);
-        auto it = peers_.find(macAddress);
-        if (it == peers_.end()) {
-            return -1;
+    std::shared_ptr<PeerState> state = findPeer(macAddress);
+    return state ? applyBitrate(*state, bps) : -1;
+}
+
+int PeerAudioManager::setPeerBitrate(int handle, int bps) {
+    std::shared_ptr<PeerState> state = findPeer(handle);
+    return state ? applyBitrate(*state, bps) : -1;
+}
+
+int PeerAudioManager::applyBitrate(PeerState& state, int bps) {
+    const int ceiling =
+        std::clamp(bps, audio_config::kBitrateLow, audio_config::kBitrateHigh);
+    state.bitrateCeiling.store(ceiling, std::memory_order_relaxed);
+    // The controller honours the new ceiling at its next interval; only a
+    // cut needs to land now. OpusEncoder is not safe to ctl while another
+    // thread calls encode(); serialize against the mixer-thread encode pass
+    // via the per-peer mutex.
+    std::lock_guard<std::mutex> stateLock(state.mutex);
+    if (state.bitrate.load(std::memory_order_relaxed) > ceiling) {
+        state.bitrate.store(state.encoder->setBitrate(ceiling),
+                            std::memory_order_relaxed);
+    }
+    return state.bitrate.load(std::memory_order_relaxed);
+}
+
+void PeerAudioManager::flushBundle(PeerState& state, OutboundFrameRing& ring,
+                                   int64_t nowMs) {
+    BundleAccumulator& bundle = state.pendingBundle;
+    if (bundle.count() == 0) return;
+    uint8_t* slot = ring.writeSlot();
+    if (!slot) {
+        ring.noteFullDrop();
+        bundle.clear();
+        return;
+    }
+    const uint32_t seq = bundle.firstSeq();
+    const uint32_t senderTsMs = bundle.firstTsMs();
+    commitVoice(state, ring, seq, senderTsMs, bundle.flush(slot), nowMs);
+}
+
+void PeerAudioManager::commitVoice(PeerState& state, OutboundFrameRing& ring,
+                                   uint32_t seq, uint32_t senderTsMs,
+                                   size_t payloadLen, int64_t nowMs) {
+    // The encoder tracks every voice frame, compact or not, so it is primed
+    // by the time the peer's offer lands.
+    const bool compact =
+        state.headerEncoder.next(seq, senderTsMs, ring.continuityEpoch()) &&
+        state.peerCompactHeaders.load(std::memory_order_relaxed);
+    ring.commit(seq, senderTsMs, payloadLen, nowMs, compact);
+    state.talkspurtOpen = true;
+}
+
+void PeerAudioManager::applyGovernorPlan(PeerState& state, int level) {
+    // Protected: a talking peer is what the room is listening to, and a weak
+    // link is the one that most needs FEC and the encoder's best effort.
+    const bool protectedPeer = state.talkingOrWeak || state.outboundCongested;
+    const TickGovernor::Plan plan = TickGovernor::planFor(level, protectedPeer);
+    state.rmsStride = plan.rmsStride;
+    const bool fec = plan.fec && !state.outboundCongested;
+    const int complexity = state.encoderComplexity.load(std::memory_order_relaxed);
+    if (fec == state.encoderFec && plan.complexity == complexity) return;
+    std::lock_guard<std::mutex> stateLock(state.mutex);
+    if (fec != state.encoderFec) {
+        state.encoder->setInbandFec(fec);
+        state.encoderFec = fec;
+    }
+    if (plan.complexity != complexity) {
+        state.encoder->setComplexity(plan.complexity);
+        state.encoderComplexity.store(plan.complexity, std::memory_order_relaxed);
+    }
+}
+
+void PeerAudioManager::sendPreRoll(PeerState& state, OutboundFrameRing& ring,
+                                   const PreRollRing& history, size_t skipNewest,
+                                   int frameSize, int frameMs, uint32_t& seq,
+                                   int64_t nowMs, int16_t* pcm) {
+    // No more packets than leave the writer's queue room for the live frame
+    // and a control frame. The backpressure gate doesn't count them (see
+    // `preRollAllowance`), so the burst doesn't read as congestion on the
+    // next tick. Bundled as fully as the peer takes, so what fits in those
+    // packets goes.
+    const size_t perPacket = static_cast<size_t>(
+        std::max(1, state.peerBundleFrames.load(std::memory_order_relaxed)));
+    const size_t queued = ring.depth();
+    const size_t packets = queued + 2 < audio_config::kOutboundQueueFrames
+                               ? audio_config::kOutboundQueueFrames - 2 - queued
+                               : 0;
+    size_t frames = std::min(audio_config::kPreRollFrames, packets * perPacket);
+    const size_t frameSamples = static_cast<size_t>(frameSize);
+    // Just keyed after a restart, the history may not reach back that far.
+    while (frames > 0 && history.copyBefore(pcm, frames * frameSamples, skipNewest) == 0) {
+        --frames;
+    }
+    if (frames == 0) return;
+
+    const uint32_t firstTsMs =
+        senderTimestampMs() - static_cast<uint32_t>(frames) * static_cast<uint32_t>(frameMs);
+    // Bundled like the live stream (see the mixer tick), even at one frame
+    // per packet: the accumulator is the only staging area we have.
+    BundleAccumulator& bundle = state.pendingBundle;
+    for (size_t f = 0; f < frames; ++f) {
+        int encodedSize;
+        {
+            std::lock_guard<std::mutex> stateLock(state.mutex);
+            encodedSize = state.encoder->encode(
+                pcm + f * frameSamples, frameSize, bundle.nextFrame(),
+                static_cast<int>(BundleAccumulator::kFrameCap));
+        }
+        if (encodedSize > 0) {
+            bundle.add(seq++, firstTsMs + static_cast<uint32_t>(f * frameMs),
+                       static_cast<size_t>(encodedSize));
         }
-        state = it->second;
+        if (bundle.count() >= perPacket) flushBundle(state, ring, nowMs);
     }
-    // OpusEncoder is not safe to ctl while another thread calls encode();
-    // serialize against the mixer-thread encode pass via the per-peer mutex.
-    int applied;
-    {
-        std::lock_guard<std::mutex> stateLock(state->mutex);
-        applied = state->encoder->setBitrate(bps);
+    flushBundle(state, ring, nowMs);
+    const size_t depth = ring.depth();
+    state.preRollAllowance = depth > queued ? depth - queued : 0;
+    LOGI("Peer %d: talkspurt opens with %zu frame(s) of pre-roll", state.deviceId, frames);
+}
+
+void PeerAudioManager::endTalkspurt(PeerState& state, OutboundFrameRing& ring,
+                                    uint32_t nextSeq, int64_t nowMs) {
+    // Announced once per talkspurt; with the ring full, next tick.
+    if (!state.talkspurtOpen || !ring.writeSlot()) return;
+    ring.commit(audio_config::kLinkControlTalkspurtEnd, nextSeq, 0, nowMs);
+    state.talkspurtOpen = false;
+}
+
+void PeerAudioManager::controlBitrate(PeerState& state,
+                                      const OutboundFrameRing& ring, int frameMs) {
+    BitrateController::Sample sample;
+    sample.lostFrames = state.jitterBuffer->lostFrameCount();
+    sample.recvFrames = state.recvCount;
+    sample.lagMs = state.lastLagMs;
+    sample.congestionSkips = ring.congestionSkipCount();
+    sample.congested = state.outboundCongested;
+    sample.ceilingBps = state.bitrateCeiling.load(std::memory_order_relaxed);
+    sample.maxFramesPerPacket = state.peerBundleFrames.load(std::memory_order_relaxed);
+    sample.frameMs = frameMs;
+    const BitrateController::Output out = state.bitrateController.update(sample);
+
+    if (out.framesPerPacket != state.framesPerPacket.load(std::memory_order_relaxed)) {
+        LOGI("Peer %d: %d frame(s) per VoiceFrame", state.deviceId,
+             out.framesPerPacket);
+        state.framesPerPacket.store(out.framesPerPacket, std::memory_order_relaxed);
+    }
+
+    if (out.bitrateBps != state.bitrate.load(std::memory_order_relaxed)) {
+        state.bitrate.store(state.encoder->setBitrate(out.bitrateBps),
+                            std::memory_order_relaxed);
+    }
+    if (out.expectedLossPct >= 0 && out.expectedLossPct != state.expectedLossPct) {
+        state.expectedLossPct = out.expectedLossPct;
+        state.encoder->setExpectedLossPct(out.expectedLossPct);
     }
-    state->bitrate.store(applied, std::memory_order_relaxed);
-    return applied;
 }
 
 void PeerAudioManager::setPeerVolume(const std::string& macAddress, float volume) {
-    std::shared_ptr<PeerState> state;
-    {
-        std::lock_guard<std::mutex> lock(peerRegistryMutex_);
-        auto it = peers_.find(macAddress);
-        if (it == peers_.end()) {
-            return;
-        }
-        state = it->second;
+    std::shared_ptr<PeerState> state = findPeer(macAddress);
+    if (!state) {
+        return;
+    }
+    auto mixer = std::atomic_load(&g_audioMixer);
+    if (mixer) {
+        mixer->setDeviceVolume(state->deviceId, volume);
+    }
+}
+
+void PeerAudioManager::setPeerVolume(int handle, float volume) {
+    std::shared_ptr<PeerState> state = findPeer(handle);
+    if (!state) {
+        return;
     }
     auto mixer = std::atomic_load(&g_audioMixer);
     if (mixer) {
@@ -275,14 +847,20 @@ void PeerAudioManager::setPeerVolume(const std::string& macAddress, float volume
 }
 
 void PeerAudioManager::setPeerMuted(const std::string& macAddress, bool muted) {
-    std::shared_ptr<PeerState> state;
-    {
-        std::lock_guard<std::mutex> lock(peerRegistryMutex_);
-        auto it = peers_.find(macAddress);
-        if (it == peers_.end()) {
-            return;
-        }
-        state = it->second;
+    std::shared_ptr<PeerState> state = findPeer(macAddress);
+    if (!state) {
+        return;
+    }
+    auto mixer = std::atomic_load(&g_audioMixer);
+    if (mixer) {
+        mixer->setDeviceMuted(state->deviceId, muted);
+    }
+}
+
+void PeerAudioManager::setPeerMuted(int handle, bool muted) {
+    std::shared_ptr<PeerState> state = findPeer(handle);
+    if (!state) {
+        return;
     }
     auto mixer = std::atomic_load(&g_audioMixer);
     if (mixer) {
@@ -292,75 +870,175 @@ void PeerAudioManager::setPeerMuted(const std::string& macAddress, bool muted) {
 
 PeerAudioManager::LinkTelemetry PeerAudioManager::getTelemetry(
     const std::string& macAddress) {
+    std::shared_ptr<PeerState> state = findPeer(macAddress);
+    return state ? telemetryFor(*state) : LinkTelemetry{};  // valid = false
+}
+
+PeerAudioManager::LinkTelemetry PeerAudioManager::getTelemetry(int handle) {
+    std::shared_ptr<PeerState> state = findPeer(handle);
+    return state ? telemetryFor(*state) : LinkTelemetry{};
+}
+
+PeerAudioManager::LinkTelemetry PeerAudioManager::telemetryFor(
+    PeerState& state) {
     LinkTelemetry t;
-    std::shared_ptr<PeerState> state;
-    {
-        std::lock_guard<std::mutex> lock(peerRegistryMutex_);
-        auto it = peers_.find(macAddress);
-        if (it == peers_.end()) {
-            return t;  // valid = false
-        }
-        state = it->second;
-    }
     // JitterBuffer counters are non-atomic; lock to read them coherently.
     {
-        std::lock_guard<std::mutex> stateLock(state->mutex);
-        // The jitter-buffer counters are cumulative size_t accessors (64-bit on
-        // the target ABI). Clamp to UINT32_MAX before narrowing into the
-        // uint32_t telemetry fields so a long-lived session can't silently wrap
-        // a counter — mirroring the ringUnderReadCount clamp below.
-        t.underrunCount = static_cast<uint32_t>(
-            std::min<uint64_t>(state->jitterBuffer->underrunCount(), UINT32_MAX));
-        t.lateFrameCount = static_cast<uint32_t>(
-            std::min<uint64_t>(state->jitterBuffer->lateFrameCount(), UINT32_MAX));
-        t.lostFrameCount = static_cast<uint32_t>(
-            std::min<uint64_t>(state->jitterBuffer->lostFrameCount(), UINT32_MAX));
-        // Depths are bounded by the jitter buffer's small capacity; no clamp.
-        t.jitterTargetDepth =
-            static_cast<uint32_t>(state->jitterBuffer->targetDepth());
-        t.jitterCurrentDepth =
-            static_cast<uint32_t>(state->jitterBuffer->currentDepth());
-        // lastLagMs is int64_t: clamp both ends ([0, UINT32_MAX]) before
-        // narrowing. The bare std::max-only form lower-bounded but let a
-        // lag > UINT32_MAX wrap, unlike its ringUnderReadCount sibling.
-        t.currentLagMs = static_cast<uint32_t>(
-            std::clamp<int64_t>(state->lastLagMs, 0, UINT32_MAX));
-        t.staleDropCount = state->staleDropCount;
-        t.recvCount = state->recvCount;
-        t.lastSeq = state->lastAcceptedSeq;
-    }
-    t.currentBitrate = state->bitrate.load(std::memory_order_relaxed);
+        std::lock_guard<std::mutex> stateLock(state.mutex);
+        collectLockedTelemetry(state, t);
+    }
+    collectSharedTelemetry(state, t);
+    return t;
+}
+
+void PeerAudioManager::collectLockedTelemetry(PeerState& state,
+                                              LinkTelemetry& t) {
+    // The jitter-buffer counters are cumulative size_t accessors (64-bit on
+    // the target ABI). Clamp to UINT32_MAX before narrowing into the
+    // uint32_t telemetry fields so a long-lived session can't silently wrap
+    // a counter — mirroring the ringUnderReadCount clamp below.
+    t.underrunCount = static_cast<uint32_t>(
+        std::min<uint64_t>(state.jitterBuffer->underrunCount(), UINT32_MAX));
+    t.lateFrameCount = static_cast<uint32_t>(
+        std::min<uint64_t>(state.jitterBuffer->lateFrameCount(), UINT32_MAX));
+    t.lostFrameCount = static_cast<uint32_t>(
+        std::min<uint64_t>(state.jitterBuffer->lostFrameCount(), UINT32_MAX));
+    // Depths are bounded by the jitter buffer's small capacity; no clamp.
+    t.jitterTargetDepth =
+        static_cast<uint32_t>(state.jitterBuffer->targetDepth());
+    t.jitterCurrentDepth =
+        static_cast<uint32_t>(state.jitterBuffer->currentDepth());
+    // lastLagMs is int64_t: clamp both ends ([0, UINT32_MAX]) before
+    // narrowing. The bare std::max-only form lower-bounded but let a
+    // lag > UINT32_MAX wrap, unlike its ringUnderReadCount sibling.
+    t.currentLagMs = static_cast<uint32_t>(
+        std::clamp<int64_t>(state.lastLagMs, 0, UINT32_MAX));
+    t.staleDropCount = state.staleDropCount;
+    t.recvCount = state.recvCount;
+    t.lastSeq = state.lastAcceptedSeq;
+    t.clockDriftPpm = static_cast<int32_t>(
+        std::lround(state.driftEstimator.skewPpm()));
+    t.bitrateBackoffCount = state.bitrateController.backoffCount();
+    t.expectedLossPct =
+        static_cast<uint32_t>(std::max(state.expectedLossPct, 0));
+}
+
+void PeerAudioManager::collectSharedTelemetry(PeerState& state,
+                                              LinkTelemetry& t) {
+    t.currentBitrate = state.bitrate.load(std::memory_order_relaxed);
     if (auto mixer = std::atomic_load(&g_audioMixer)) {
-        uint64_t raw = mixer->getRingUnderReadCount(state->deviceId);
+        uint64_t raw = mixer->getRingUnderReadCount(state.deviceId);
         t.ringUnderReadCount = static_cast<uint32_t>(
             std::min<uint64_t>(raw, UINT32_MAX));
-        uint64_t rawOw = mixer->getRingOverwriteCount(state->deviceId);
+        uint64_t rawOw = mixer->getRingOverwriteCount(state.deviceId);
         t.ringOverwriteCount = static_cast<uint32_t>(
             std::min<uint64_t>(rawOw, UINT32_MAX));
     }
+    t.tickLateP99Us = tickLateness_.publishedP99Us();
+    t.tickWorkP99Us = tickWork_.publishedP99Us();
+    t.tickOverrunCount = tickOverrunCount_.load(std::memory_order_relaxed);
+    t.arrivalDropCount = static_cast<uint32_t>(
+        std::min<uint64_t>(state.arrivals.droppedCount(), UINT32_MAX));
+    t.outboundStaleDropCount = static_cast<uint32_t>(
+        std::min<uint64_t>(state.outbound->staleDropCount(), UINT32_MAX));
+    t.outboundFullDropCount = static_cast<uint32_t>(
+        std::min<uint64_t>(state.outbound->fullDropCount(), UINT32_MAX));
+    t.outboundDepth = static_cast<uint32_t>(state.outbound->depth());
+    t.outboundSkipCount = static_cast<uint32_t>(
+        std::min<uint64_t>(state.outbound->congestionSkipCount(), UINT32_MAX));
+    t.outboundFramesPerPacket = static_cast<uint32_t>(
+        state.framesPerPacket.load(std::memory_order_relaxed));
+    t.encoderComplexity = static_cast<uint32_t>(
+        state.encoderComplexity.load(std::memory_order_relaxed));
+    t.governorLevel = static_cast<uint32_t>(tickGovernor_.level());
     t.valid = true;
-    return t;
 }
 
-bool PeerAudioManager::isPeerTalking(const std::string& macAddress) {
-    std::shared_ptr<PeerState> state;
-    {
-        std::lock_guard<std::mutex> lock(peerRegistryMutex_);
-        auto it = peers_.find(macAddress);
-        if (it == peers_.end()) return false;
-        state = it->second;
+void PeerAudioManager::marshalTelemetry(const LinkTelemetry& t, int32_t* out) {
+    // uint32 counters cross as their bit pattern; Kotlin and Dart read them
+    // back unsigned. clockDriftPpm is genuinely signed.
+    const int32_t values[] = {
+        static_cast<int32_t>(t.underrunCount),
+        static_cast<int32_t>(t.lateFrameCount),
+        static_cast<int32_t>(t.jitterTargetDepth),
+        static_cast<int32_t>(t.jitterCurrentDepth),
+        static_cast<int32_t>(t.currentBitrate),
+        static_cast<int32_t>(t.lostFrameCount),
+        static_cast<int32_t>(t.currentLagMs),
+        static_cast<int32_t>(t.staleDropCount),
+        static_cast<int32_t>(t.recvCount),
+        static_cast<int32_t>(t.lastSeq),
+        static_cast<int32_t>(t.ringUnderReadCount),
+        static_cast<int32_t>(t.ringOverwriteCount),
+        static_cast<int32_t>(t.clockDriftPpm),
+        static_cast<int32_t>(t.tickLateP99Us),
+        static_cast<int32_t>(t.tickWorkP99Us),
+        static_cast<int32_t>(t.tickOverrunCount),
+        static_cast<int32_t>(t.arrivalDropCount),
+        static_cast<int32_t>(t.outboundStaleDropCount),
+        static_cast<int32_t>(t.outboundFullDropCount),
+        static_cast<int32_t>(t.outboundDepth),
+        static_cast<int32_t>(t.outboundSkipCount),
+        static_cast<int32_t>(t.bitrateBackoffCount),
+        static_cast<int32_t>(t.expectedLossPct),
+        static_cast<int32_t>(t.outboundFramesPerPacket),
+        static_cast<int32_t>(t.encoderComplexity),
+        static_cast<int32_t>(t.governorLevel),
+    };
+    static_assert(sizeof(values) / sizeof(values[0]) ==
+                      static_cast<size_t>(audio_config::kTelemetryFieldCount),
+                  "marshalTelemetry must emit exactly kTelemetryFieldCount fields");
+    std::copy(std::begin(values), std::end(values), out);
+}
+
+size_t PeerAudioManager::snapshotTelemetry(int32_t* out,
+                                           size_t maxRecords) const {
+    size_t written = 0;
+    for (size_t i = 0; i < TelemetryBoard::kRecords && written < maxRecords;
+         ++i) {
+        int32_t* record = out + written * kTelemetryRecordInts;
+        int32_t handle = 0;
+        if (!telemetryBoard_.read(i, &handle, record + 1)) continue;
+        // A record outlives its peer until the slot is reused; only report
+        // the peer that holds the slot now.
+        if (!findPeer(handle)) continue;
+        record[0] = handle;
+        ++written;
     }
+    return written;
+}
+
+bool PeerAudioManager::isPeerTalking(const std::string& macAddress) {
+    std::shared_ptr<PeerState> state = findPeer(macAddress);
+    if (!state) return false;
     std::lock_guard<std::mutex> stateLock(state->mutex);
     return state->peerVad.talking();
 }
 
+bool PeerAudioManager::isPeerDormant(const std::string& macAddress) {
+    std::shared_ptr<PeerState> state = findPeer(macAddress);
+    if (!state) return false;
+    std::lock_guard<std::mutex> stateLock(state->mutex);
+    return state->plcDormant;
+}
+
+uint64_t PeerAudioManager::catchUpMergeCount(int handle) {
+    std::shared_ptr<PeerState> state = findPeer(handle);
+    if (!state) return 0;
+    std::lock_guard<std::mutex> stateLock(state->mutex);
+    return state->catchUpMerges;
+}
+
 bool PeerAudioManager::startMixerThread() {
     if (mixerRunning_.load()) {
         LOGI("Mixer thread already running");
         return true;
     }
     mixerRunning_.store(true);
+    talkingState_.restart();
+    tickGovernor_.reset();
     mixerThread_ = std::thread(&PeerAudioManager::mixerTickLoop, this);
+    talkNotifierThread_ = std::thread(&PeerAudioManager::talkNotifierLoop, this);
     LOGI("Mixer thread started");
     return true;
 }
@@ -370,60 +1048,372 @@ void PeerAudioManager::stopMixerThread() {
         return;
     }
     mixerRunning_.store(false);
+    wakeMixer();
     if (mixerThread_.joinable()) {
         mixerThread_.join();
     }
+    talkingState_.stop();
+    if (talkNotifierThread_.joinable()) {
+        talkNotifierThread_.join();
+    }
     LOGI("Mixer thread stopped");
 }
 
-void PeerAudioManager::mixerTickLoop() {
-    LOGI("Mixer tick loop started");
+void PeerAudioManager::decodeAhead(PeerState& state) {
+    if (!state.decodeSeqValid || state.plcDormant ||
+        !state.jitterBuffer->primed()) {
+        return;
+    }
+    if (state.arrivalPcm.empty()) {
+        state.arrivalPcm.resize(audio_config::kCodecMaxFrameSize);
+    }
+    for (size_t i = 0;; ++i) {
+        JitterBuffer::Frame* f = state.jitterBuffer->frameAt(i);
+        if (f == nullptr) break;
+        if (!f->pcm.empty()) continue;  // decoded on an earlier arrival
+        // Only the frame the decoder expects next. Anything else is behind a
+        // hole, and the hole's FEC/PLC belongs to the tick at playout time.
+        if (f->seq != state.decodeSeq) break;
+        // Known silence needs no decode; playFrame() handles it in order.
+        if (opus_silence::isSilent(f->opusData)) {
+            ++state.decodeSeq;
+            continue;
+        }
+        const int n = state.decoder->decode(
+            f->opusData.data(), static_cast<int>(f->opusData.size()),
+            state.arrivalPcm.data(), audio_config::kCodecMaxFrameSize);
+        // A bad packet is left undecoded; the tick retries it in order and
+        // handles the error exactly as without decode-ahead.
+        if (n <= 0) break;
+        f->pcm.assign(state.arrivalPcm.begin(), state.arrivalPcm.begin() + n);
+        ++state.decodeSeq;
+    }
+}
 
-    constexpr int kFrameSize = audio_config::kCodecFrameSize;
-    // Update the per-peer FEC loss hint once per second (50 frames at 20 ms each).
-    constexpr int kLossPctUpdateInterval = 50;
+int PeerAudioManager::playFrame(PeerState& state,
+                                const JitterBuffer::Frame& frame,
+                                int16_t* pcm) {
+    const bool wasSilent = state.silentRun;
+    state.silentRun = false;
+    int n;
+    if (!frame.pcm.empty()) {
+        n = static_cast<int>(frame.pcm.size());
+        std::copy(frame.pcm.begin(), frame.pcm.end(), pcm);
+    } else if (opus_silence::isSilent(frame.opusData)) {
+        // Nothing to decode: libopus would only conceal it, extrapolating
+        // the last syllable. The decoder state stays at the last real frame,
+        // as if the packet had never been sent — which is what DTX means.
+        if (!wasSilent) state.comfortNoise.restart();
+        state.silentRun = true;
+        const uint32_t us =
+            opus_toc::packetDurationUs(frame.opusData.data(), frame.opusData.size());
+        if (us > 0) {
+            state.frameSamples = std::min(
+                static_cast<int>(us * audio_config::kCodecSampleRate / 1000000),
+                audio_config::kCodecMaxFrameSize);
+        }
+        n = state.comfortNoise.generate(pcm, state.frameSamples);
+    } else {
+        n = state.decoder->decode(
+            frame.opusData.data(), static_cast<int>(frame.opusData.size()),
+            pcm, audio_config::kCodecMaxFrameSize);
+    }
+    if (n > 0 && !state.silentRun) state.frameSamples = n;
+    // popAny() can skip a hole, so resync rather than increment: the decoder
+    // has now consumed exactly this seq.
+    if (!state.decodeSeqValid ||
+        static_cast<int32_t>(frame.seq + 1 - state.decodeSeq) > 0) {
+        state.decodeSeq = frame.seq + 1;
+        state.decodeSeqValid = true;
+    }
+    return n;
+}
 
+int PeerAudioManager::decodeNextFrame(PeerState& state, int16_t* pcm,
+                                      int16_t* scratch) {
+    // The peer's frame length: 480, or 240 under the low-latency profile.
+    const int frameSize = state.frameSamples;
     // Decode-call sizing note: the trailing size arg means two different
     // things, which is why the normal path passes kCodecMaxFrameSize (5760)
-    // while the FEC/PLC paths pass kFrameSize (480). On the normal decode()
-    // it is a *capacity cap* — the buffer headroom Opus may not exceed, so we
-    // hand it the worst-case 120 ms frame size and let Opus emit whatever the
-    // packet actually encodes. On decodeFec()/decodeMissing() it is instead
+    // while the FEC/PLC paths pass frameSize (480, or 240). On the normal
+    // decode() it is a *capacity cap* — the buffer headroom Opus may not
+    // exceed, so we hand it the worst-case 120 ms frame size and let Opus
+    // emit whatever the packet actually encodes. On decodeFec()/decodeMissing() it is instead
     // the *requested* recovery/concealment length: Opus has no packet to read
     // the duration from, so this arg tells it exactly how many samples to
-    // synthesize, and it must be a valid Opus frame length (one 20 ms frame =
-    // kFrameSize). The two are not interchangeable: bumping the FEC/PLC arg to
-    // kCodecMaxFrameSize would ask Opus to conceal 120 ms, not cap a buffer.
-
-    // Per-thread JVM attachment. The thread runs at 50 Hz × N peers, so we
-    // do the attach once and reuse the JNIEnv — per-call attach/detach is
-    // wasteful and adds jitter to the mixer loop.
+    // synthesize, and it must be a valid Opus frame length (one of the
+    // peer's frames = frameSize). The two are not interchangeable: bumping
+    // the FEC/PLC arg to kCodecMaxFrameSize would ask Opus to conceal 120 ms,
+    // not cap a buffer.
+
+    // Dormant after a faded-out PLC tail. Stay that way, doing nothing, until
+    // the talkspurt's lead-in has refilled the jitter buffer to the depth
+    // pop() releases at (the fast-start depth on a cold buffer, the target
+    // otherwise) — or, if fewer frames than that are coming, until we've
+    // waited as many ticks as that would have taken to fill. Resuming any earlier
+    // would just underrun into another tail.
     //
-    // **Lazy:** if startMixerThread() runs before setCallback() publishes
-    // jvm_, we'd otherwise stay unattached forever. We retry the attach on
-    // each tick where `env` is still null AND `jvm_` is now available.
-    // Once attached, the JNIEnv is stable for the thread's lifetime; we
-    // detach exactly once on loop exit if we attached at all.
-    JNIEnv* env = nullptr;
-    bool attached = false;
+    // Dormant through an announced pause, the pause plays comfort noise.
+    if (state.plcDormant) {
+        const size_t depth = state.jitterBuffer->currentDepth();
+        if (depth == 0) return pauseNoise(state, pcm);
+        const size_t need = state.jitterBuffer->releaseDepth();
+        if (depth < need && ++state.dormantHeldTicks < need) {
+            return pauseNoise(state, pcm);
+        }
+        // The decoder's state is the end of the tail, possibly seconds old:
+        // start the new talkspurt clean rather than overlap it. Likewise the
+        // resampler's few leftover tail samples. consecutiveUnderruns is left
+        // at the tail length, so if pop() still can't release a frame (lead-in
+        // shorter than the target) the popAny() escalation takes what's there.
+        state.decoder->reset();
+        state.driftResampler.reset();
+        state.decodeSeqValid = false;
+        state.plcDormant = false;
+        state.dormantHeldTicks = 0;
+    }
+
+    int decoded = -1;
+    bool silent = false;
+    auto frame = state.jitterBuffer->pop();
+    if (frame.has_value()) {
+        decoded = playFrame(state, *frame, pcm);
+        silent = state.silentRun;
+        state.consecutiveUnderruns = 0;
+
+        // Drift drain (time-scaling "accelerate"). If the buffer is still
+        // at/above the high watermark after this pop, the producer's 50 Hz
+        // clock is outrunning ours faster than the drift resampler has
+        // corrected for (or the estimator hasn't converged yet). Pull one
+        // extra frame and crossfade-merge it into the frame we just decoded —
+        // two 20 ms input frames collapse into one 20 ms output frame,
+        // draining the backlog by one without a hard skip. Capped at one
+        // extra frame per call so the time compression stays subtle and
+        // spreads across ticks. (The opposite drift — our clock outrunning
+        // the producer — is handled by the underrun/PLC path below, which
+        // stretches.)
+        //
+        // A pre-roll catch-up merge that's due (see the tick) takes the same
+        // path while the buffer stays past its target.
+        const size_t after = state.jitterBuffer->currentDepth();
+        const bool catchUp = state.catchUpMergeDue &&
+                             after > state.jitterBuffer->targetDepth();
+        if (decoded > 0 &&
+            (after >= audio_config::kJitterHighWatermark || catchUp)) {
+            if (catchUp) {
+                state.catchUpMergeDue = false;
+                state.catchUpWaitTicks = audio_config::kPreRollCatchUpIntervalTicks;
+                --state.catchUpFrames;
+                ++state.catchUpMerges;
+            }
+            auto extra = state.jitterBuffer->pop();
+            if (extra.has_value()) {
+                int decoded2 = playFrame(state, *extra, scratch);
+                if (decoded2 > 0) {
+                    decoded =
+                        crossfadeMergeFrames(pcm, decoded, scratch, decoded2);
+                }
+            }
+            // A nullopt here can only be a hole-at-head: depth is >= the
+            // high watermark, so pop() never reports an underrun in this
+            // branch. pop() has already advanced the playhead past one lost
+            // seq, and that advance IS the drain we want — collapsing the
+            // missing 20 ms is exactly the time compression drift-drain exists
+            // to do. Deliberately no PLC for it: synthesizing concealment
+            // would re-stretch the very gap we are draining. The real frame
+            // decoded above is still played out.
+        }
+    } else {
+        // Hole-at-head with its successor queued: that packet's in-band FEC
+        // (LBRR) reconstructs exactly the lost seq. fecSourceForHole() only
+        // answers for the seq pop() just stepped over, so a multi-frame hole
+        // PLCs its earlier seqs and recovers the last one, and a plain
+        // underrun (nothing lost, buffer just thin) never "recovers" from the
+        // playhead frame itself. When the packet carries no LBRR (encoder FEC
+        // off, or loss estimate too low) libopus returns PLC output, so this
+        // is never worse than decodeMissing().
+        const JitterBuffer::Frame* fecSource =
+            state.jitterBuffer->fecSourceForHole();
+        if (fecSource != nullptr) {
+            decoded = state.decoder->decodeFec(
+                fecSource->opusData.data(),
+                static_cast<int>(fecSource->opusData.size()), pcm, frameSize);
+            if (decoded >= 0) {
+                // Loss concealed with real audio; don't escalate.
+                state.consecutiveUnderruns = 0;
+            }
+        }
+
+        // Otherwise PLC for one frame; if we've already PLC'd twice in a row,
+        // prefer popAny() so the buffer doesn't grow stale.
+        //
+        // Decode-on-arrival exception: if the front frame already carries
+        // PCM, the decoder has run ahead past the playhead, and PLC now would
+        // splice concealment into the middle of its stream. Nothing is lost
+        // here — the buffer is just below target — so play the ready frame
+        // instead. A silent front frame is as ready: it needs no decoder.
+        // pop() above has already counted the underrun, so the target depth
+        // still adapts.
+        //
+        // Likewise at the end of a talkspurt the sender has announced: no
+        // more is coming to fill the buffer, so play out what's there.
+        const JitterBuffer::Frame* front = state.jitterBuffer->peekFront();
+        if (decoded < 0 &&
+            (state.consecutiveUnderruns >= 2 || state.jitterBuffer->gapExpected() ||
+             (front != nullptr &&
+              (!front->pcm.empty() || opus_silence::isSilent(front->opusData))))) {
+            auto any = state.jitterBuffer->popAny();
+            if (any.has_value()) {
+                decoded = playFrame(state, *any, pcm);
+                silent = state.silentRun;
+                state.consecutiveUnderruns = 0;
+            }
+        }
+        if (decoded < 0 || fecSource != nullptr) {
+            // FEC or PLC stands in for the playhead frame, leaving the
+            // decoder exactly at the playhead (pop() has already stepped past
+            // a hole) — which is where decode-ahead picks up.
+            if (state.jitterBuffer->playheadInitialized()) {
+                state.decodeSeq = state.jitterBuffer->playhead();
+                state.decodeSeqValid = true;
+            }
+        }
+        if (decoded < 0 && state.jitterBuffer->gapExpected()) {
+            // The announced pause itself: nothing was lost, so there's
+            // nothing to conceal. Dormant straight away (as at the end of a
+            // PLC tail, below), with comfort noise in place of the tail.
+            state.plcDormant = true;
+            state.dormantHeldTicks = 0;
+            state.consecutiveUnderruns = audio_config::kPlcTailFrames;
+            if (state.peerVad.talking()) state.peerVad.reset();
+            talkingState_.setLevel(slotFor(state.deviceId), 0);
+            state.comfortNoise.restart();
+            return pauseNoise(state, pcm);
+        }
+        if (decoded < 0) {
+            decoded = state.decoder->decodeMissing(pcm, frameSize);
+            ++state.consecutiveUnderruns;
+            // Fade only a genuine tail (nothing queued). With frames still
+            // buffered, popAny() drains them within two ticks and a dip in
+            // between would be audible.
+            if (decoded > 0 && state.jitterBuffer->currentDepth() == 0) {
+                fadePlcTail(pcm, decoded, state.consecutiveUnderruns);
+            }
+            if (state.consecutiveUnderruns >= audio_config::kPlcTailFrames) {
+                // Tail is down to silence. Go dormant; force the VAD off
+                // now, since it won't see the silence that would
+                // otherwise close its off-hysteresis.
+                state.plcDormant = true;
+                state.dormantHeldTicks = 0;
+                if (state.peerVad.talking()) state.peerVad.reset();
+                talkingState_.setLevel(slotFor(state.deviceId), 0);
+                return decoded;
+            }
+        }
+    }
+
+    // Per-peer VAD: compute RMS on decoded PCM and update hysteresis. Runs
+    // under the caller's stateLock so isPeerTalking() reads are race-free.
+    // The tick publishes the resulting talking set; the level goes straight
+    // to talkingState_ for lock-free readers. Known silence skips the RMS:
+    // the VAD hears quiet, and comfort noise keeps the level it last learned.
+    if (silent) {
+        state.peerVad.update(false, state.frameSamples);
+        talkingState_.setLevel(slotFor(state.deviceId), 0);
+    } else if (decoded > 0) {
+        const double rms = frameRms(pcm, decoded, state.rmsStride);
+        state.peerVad.update(rms > VadDetector::kDefaultThreshold, decoded);
+        state.comfortNoise.observe(rms, state.peerVad.talking());
+        talkingState_.setLevel(
+            slotFor(state.deviceId),
+            static_cast<uint16_t>(std::min(rms * 32768.0, 65535.0)));
+    }
+    return decoded;
+}
+
+int PeerAudioManager::pauseNoise(PeerState& state, int16_t* pcm) {
+    return state.jitterBuffer->gapExpected()
+               ? state.comfortNoise.generate(pcm, state.frameSamples)
+               : 0;
+}
+
+void PeerAudioManager::noteLocalActivity() {
+    localActivity_.store(true);
+    wakeMixer();
+}
+
+void PeerAudioManager::wakeMixer() {
+    if (!mixerParked_.load()) return;
+    // Taking the lock orders this notify after the mixer's wait() has
+    // released it, so the notify can't be lost (see the handshake note on
+    // mixerParked_).
+    std::lock_guard<std::mutex> lock(parkMutex_);
+    parkCv_.notify_one();
+}
+
+void PeerAudioManager::parkMixer() {
+    std::vector<std::shared_ptr<PeerState>> peers;
+    {
+        std::lock_guard<std::mutex> lock(peerRegistryMutex_);
+        for (const auto& [mac, state] : peers_) {
+            peers.push_back(state);
+        }
+    }
+    // Every buffer is already drained (nothing has arrived for the whole
+    // park window). Resetting makes the next talkspurt a cold start: the
+    // playhead re-anchors on its first seq and the buffer fast-starts and
+    // ramps to its target again, instead of the silence reading as one long underrun that
+    // ratchets the target depth up on every talkspurt. Lifetime stats
+    // survive reset().
+    for (const auto& state : peers) {
+        std::lock_guard<std::mutex> stateLock(state->mutex);
+        state->jitterBuffer->reset();
+        state->consecutiveUnderruns = 0;
+        state->decodeSeqValid = false;
+    }
+
+    LOGI("Mixer tick parked (idle room)");
+    std::unique_lock<std::mutex> lock(parkMutex_);
+    mixerParked_.store(true);
+    parkCv_.wait(lock, [this] {
+        return frameArrived_.load() || localActivity_.load() ||
+               talkingPeersDirty_.load() || !mixerRunning_.load();
+    });
+    mixerParked_.store(false, std::memory_order_release);
+    LOGI("Mixer tick woken");
+}
+
+void PeerAudioManager::mixerTickLoop() {
+    LOGI("Mixer tick loop started");
+
+    // Scratch is sized for the default frame; under the low-latency profile
+    // a tick uses the front half.
+    constexpr int kFrameSize = audio_config::kCodecFrameSize;
+
+    // No JNI on this thread: outbound audio goes to the outbound rings and
+    // the talking set to talkingState_, whose notifier thread makes the one
+    // upcall it needs.
 
     // Pre-allocate scratch — the mixer thread runs every 20 ms, so the cost
     // of a tick matters more than memory.
     std::vector<int16_t> decodedBuffer(audio_config::kCodecMaxFrameSize);
     // Second decode scratch — used only by the drift-drain crossfade-merge.
     std::vector<int16_t> decodedBuffer2(audio_config::kCodecMaxFrameSize);
+    // Drift-corrected output of the per-peer VariableRatioResampler.
+    std::vector<int16_t> driftBuffer(kFrameSize);
     std::vector<int16_t> mixedBuffer(kFrameSize);
+    // Encode target for a peer whose outbound ring is full (see below).
     std::vector<uint8_t> opusBuffer(audio_config::kMaxOpusPacketSize);
+    // The push-to-talk pre-roll, copied out of the capture history.
+    std::vector<int16_t> preRollBuffer(audio_config::kPreRollFrames * kFrameSize);
 
     // Snapshot of active peers, filled from peerRegistryMutex_-guarded state
     // once per tick to avoid holding the lock through the heavier work.
     std::vector<std::shared_ptr<PeerState>> peerSnapshot;
-    std::vector<std::string> macSnapshot;
     // One entry per registered peer, so the ceiling is AudioMixer::kMaxDevices
     // (not the per-stream frame-depth bound kJitterMaxDepth). Reserving against
     // the right constant keeps this allocation-free even if kMaxDevices rises.
     peerSnapshot.reserve(AudioMixer::kMaxDevices);
-    macSnapshot.reserve(AudioMixer::kMaxDevices);
 
     // Mix-minus output uses a per-peer monotonically-increasing seq, separate
     // from the per-peer recv seq tracked inside the jitter buffer. Stays here
@@ -431,39 +1421,53 @@ void PeerAudioManager::mixerTickLoop() {
     // alive — a re-start of the mixer thread legitimately re-zeros it.
     std::map<int, uint32_t> outboundSeq;
 
-    auto nextTick = std::chrono::steady_clock::now();
+    // Idle-room counters (see audio_config::kIdleParkAfterTicks). Saturate
+    // at the park threshold so a room that stays quiet all afternoon can't
+    // overflow them.
+    int quietTicks = 0;
+    int ticksSinceArrival = 0;
+    // Since the local mic last carried keyed speech; a talkspurt that opens
+    // within kPreRollOnsetTicks of it is the speaker's, and gets a pre-roll.
+    int ticksSinceLocalVoice = audio_config::kIdleParkAfterTicks;
+
+    // The frame the room runs on (audio_config::kLowLatencyProfile), decided
+    // afresh every tick, and how many ticks of it make one default frame:
+    // the factor every tick count that stands for wall-clock time stretches
+    // by.
+    int frameMs = audio_config::kFrameDurationMs;
+    int tickScale = 1;
+
+    raiseMixerThreadPriority();
+
+    // Tick-jitter stats window (see audio_config::kTickStatsWindowTicks).
+    int statsTicks = 0;
+    // Telemetry board cadence (see audio_config::kTelemetryPublishTicks).
+    int telemetryTicks = 0;
+    LinkTelemetry telemetry;
+    int32_t telemetryFields[audio_config::kTelemetryFieldCount];
+
+    int64_t deadlineNs = monotonicNowNs();
 
     while (mixerRunning_.load()) {
-        const auto now = std::chrono::steady_clock::now();
-        if (now < nextTick) {
-            std::this_thread::sleep_for(nextTick - now);
+        sleepUntilNs(deadlineNs);
+        if (!mixerRunning_.load()) break;
+        const int64_t wakeNs = monotonicNowNs();
+        tickLateness_.record(nsToUs(wakeNs - deadlineNs));
+
+        // Idle park. Nobody is talking, nothing has arrived, and we already
+        // stopped sending — there is nothing for this tick to do until a
+        // frame or the local mic says otherwise.
+        const int parkTicks = audio_config::kIdleParkAfterTicks * tickScale;
+        if (quietTicks >= parkTicks && ticksSinceArrival >= parkTicks) {
+            parkMixer();
+            quietTicks = 0;
+            ticksSinceArrival = 0;
+            // Re-anchor: the park may have lasted minutes, and the first
+            // tick after it should run now, not replay the missed ones.
+            deadlineNs = monotonicNowNs();
             continue;
         }
 
-        // Lazy JNI attach. If setCallback() hadn't yet been called when the
-        // thread started, jvm_ was null and we couldn't attach. Try again
-        // on each tick until we succeed; before that, encoded frames are
-        // produced but `sendAudioToPeer` skips the JNI call (no callback to
-        // hand them to anyway). On a healthy boot sequence this branch
-        // succeeds on the very first tick.
-        //
-        // jvm_ is std::atomic; the acquire load pairs with the release
-        // store in setCallback() to give us happens-before with whatever
-        // setCallback() did before publishing.
-        JavaVM* jvm = jvm_.load(std::memory_order_acquire);
-        if (env == nullptr && jvm != nullptr) {
-            if (jvm->GetEnv(reinterpret_cast<void**>(&env),
-                            JNI_VERSION_1_6) != JNI_OK) {
-                if (jvm->AttachCurrentThread(&env, nullptr) == JNI_OK) {
-                    attached = true;
-                } else {
-                    LOGE("mixerTickLoop: AttachCurrentThread failed; will "
-                         "retry next tick");
-                    env = nullptr;
-                }
-            }
-        }
-
         // Hoist the mixer snapshot to the top of the tick so the same
         // strong reference covers both the decode pass and the mix-minus
         // pass below — the load itself is cheap (one atomic word read) but
@@ -473,18 +1477,45 @@ void PeerAudioManager::mixerTickLoop() {
         auto mixer = std::atomic_load(&g_audioMixer);
 
         peerSnapshot.clear();
-        macSnapshot.clear();
         {
             std::lock_guard<std::mutex> lock(peerRegistryMutex_);
             for (const auto& [mac, state] : peers_) {
                 peerSnapshot.push_back(state);
-                macSnapshot.push_back(mac);
             }
         }
 
+        // Frame profile. The room runs on 10 ms frames while we want them
+        // and every peer has asked for them too; the whole tick — pulls,
+        // mix, encode, the next deadline — runs on the one decided here.
+        const bool wantLowLatency = lowLatencyProfile_.load(std::memory_order_relaxed);
+        size_t lowLatencyPeers = 0;
+        for (const auto& state : peerSnapshot) {
+            if (state->peerFrameMs.load(std::memory_order_relaxed) ==
+                audio_config::kLowLatencyFrameDurationMs) {
+                ++lowLatencyPeers;
+            }
+        }
+        const bool lowLatency = wantLowLatency && !peerSnapshot.empty() &&
+                                lowLatencyPeers == peerSnapshot.size();
+        const int tickFrameMs = lowLatency ? audio_config::kLowLatencyFrameDurationMs
+                                           : audio_config::kFrameDurationMs;
+        if (tickFrameMs != frameMs) {
+            LOGI("Room frame duration %d ms -> %d ms", frameMs, tickFrameMs);
+            frameMs = tickFrameMs;
+            tickScale = audio_config::kFrameDurationMs / frameMs;
+            frameMs_.store(frameMs, std::memory_order_relaxed);
+        }
+        const int frameSize = lowLatency ? audio_config::kLowLatencyCodecFrameSize
+                                         : audio_config::kCodecFrameSize;
+        const size_t playoutRingCap = lowLatency
+                                          ? audio_config::kLowLatencyPlayoutMaxRingFillSamples
+                                          : audio_config::kPlayoutMaxRingFillSamples;
+        if (mixer) mixer->setPlayoutRingCap(playoutRingCap);
+
         // ---- Decode pass: drain each peer's jitter buffer by one frame and
         // feed the decoded PCM into the mixer's per-peer ring. Underruns
-        // produce one frame of PLC instead of stalling.
+        // produce one frame of PLC instead of stalling, up to a faded tail;
+        // past that the peer is dormant and costs nothing until it sends.
         //
         // We hand the BLE-arrived audio to AudioMixer::updateDeviceAudio
         // rather than AudioMixer::onVoiceFrame: the jitter buffer already
@@ -492,359 +1523,498 @@ void PeerAudioManager::mixerTickLoop() {
         // stuck-producer poison logic would never fire. Skipping it avoids
         // duplicating the gap detection that the buffer + this loop's PLC
         // path already handle.
-        bool anyTalkingChanged = false;
+        bool anyPeerTalking = false;
+        const bool publishTelemetry =
+            ++telemetryTicks >= audio_config::kTelemetryPublishTicks * tickScale;
+        if (publishTelemetry) telemetryTicks = 0;
         for (size_t i = 0; i < peerSnapshot.size(); ++i) {
             auto& state = peerSnapshot[i];
-            int decoded = -1;
-            // Hold the per-peer lock across jitter-buffer + decoder use.
-            // The decoder is touched only on this thread, so the lock is
-            // really there to serialize the jitter buffer (push side runs
-            // on the BLE thread).
+            int produced = 0;
+            // Hold the per-peer lock across jitter-buffer + decoder use. The
+            // receive threads never take it (outside decode-on-arrival mode);
+            // it serializes this pass against the control and telemetry calls.
             {
                 std::lock_guard<std::mutex> stateLock(state->mutex);
+                // Everything that arrived since the last tick goes into the
+                // jitter buffer first, so this tick plays with it.
+                ingestArrivals(*state);
                 state->jitterBuffer->tick();
 
-                auto frame = state->jitterBuffer->pop();
-                if (frame.has_value()) {
-                    decoded = state->decoder->decode(
-                        frame->opusData.data(),
-                        static_cast<int>(frame->opusData.size()),
-                        decodedBuffer.data(),
-                        audio_config::kCodecMaxFrameSize);
-                    state->consecutiveUnderruns = 0;
-
-                    // Drift drain (time-scaling "accelerate"). If the buffer is
-                    // still at/above the high watermark after this pop, the
-                    // producer's 50 Hz clock is outrunning ours. Pull one extra
-                    // frame and crossfade-merge it into the frame we just
-                    // decoded — two 20 ms input frames collapse into one 20 ms
-                    // output frame, draining the backlog by one without a hard
-                    // skip. Capped at one extra frame per tick so the time
-                    // compression stays subtle and spreads across ticks. (The
-                    // opposite drift — our clock outrunning the producer — is
-                    // handled by the underrun/PLC path below, which stretches.)
-                    if (decoded > 0 &&
-                        state->jitterBuffer->currentDepth() >=
-                            audio_config::kJitterHighWatermark) {
-                        auto extra = state->jitterBuffer->pop();
-                        if (extra.has_value()) {
-                            int decoded2 = state->decoder->decode(
-                                extra->opusData.data(),
-                                static_cast<int>(extra->opusData.size()),
-                                decodedBuffer2.data(),
-                                audio_config::kCodecMaxFrameSize);
-                            if (decoded2 > 0) {
-                                decoded = crossfadeMergeFrames(
-                                    decodedBuffer.data(), decoded,
-                                    decodedBuffer2.data(), decoded2);
-                            }
-                        }
-                        // A nullopt here can only be a hole-at-head: depth is
-                        // >= the high watermark, so pop() never reports an
-                        // underrun in this branch. pop() has already advanced
-                        // the playhead past one lost seq, and that advance IS
-                        // the drain we want — collapsing the missing 20 ms is
-                        // exactly the time compression drift-drain exists to do.
-                        // Deliberately no PLC for it: synthesizing concealment
-                        // would re-stretch the very gap we are draining. The
-                        // real frame decoded above is still played out this tick.
+                // Clock-drift correction. The resampler consumes this peer's
+                // PCM at the sender's clock rate (1 + skew input samples per
+                // output) while we emit exactly one frame per tick on ours,
+                // so we pull decoded frames on demand rather than one per
+                // tick: normally exactly one pull; a sender running slow
+                // occasionally leaves enough in the reservoir to skip one
+                // (the jitter buffer keeps the frame), a sender running fast
+                // occasionally needs a second.
+                //
+                // During a fast-start ramp the same resampler also plays the
+                // peer slightly slow, so the buffer grows from its start
+                // depth to the target without a pause.
+                //
+                // A peer's frames needn't match our tick while the room
+                // changes frame profile: its 20 ms frames leave every other
+                // 10 ms tick nothing to pull, its 10 ms frames take two pulls
+                // to fill a 20 ms tick.
+                //
+                // A talkspurt that opens past the target on a peer that
+                // offered pre-roll opened with its burst: while the buffer
+                // stays past the target, every kPreRollCatchUpIntervalTicks
+                // the decode crossfade-merges one extra frame in, as the
+                // high-watermark drain does, until the announced frames are
+                // shed. Time compression, not speed, so pitch is kept.
+                double step = state->driftEstimator.consumeStep();
+                const size_t depth = state->jitterBuffer->currentDepth();
+                const size_t target = state->jitterBuffer->targetDepth();
+                if (state->jitterBuffer->gapExpected()) {
+                    state->talkspurtPending = true;
+                } else if (state->talkspurtPending && depth > 0) {
+                    state->talkspurtPending = false;
+                    state->catchUpFrames =
+                        depth > target
+                            ? std::min<int>(state->peerPreRollFrames.load(
+                                                std::memory_order_relaxed),
+                                            static_cast<int>(depth - target))
+                            : 0;
+                    state->catchUpWaitTicks = 0;
+                }
+                if (state->catchUpFrames > 0 && depth > target) {
+                    if (state->catchUpWaitTicks > 0) {
+                        --state->catchUpWaitTicks;
+                    } else {
+                        state->catchUpMergeDue = true;
                     }
                 } else {
-                    // Underrun. PLC for one frame; if we've already PLC'd twice in
-                    // a row, prefer popAny() so the buffer doesn't grow stale.
-                    if (state->consecutiveUnderruns >= 2) {
-                        auto any = state->jitterBuffer->popAny();
-                        if (any.has_value()) {
-                            decoded = state->decoder->decode(
-                                any->opusData.data(),
-                                static_cast<int>(any->opusData.size()),
-                                decodedBuffer.data(),
-                                audio_config::kCodecMaxFrameSize);
-                            state->consecutiveUnderruns = 0;
-                        }
-                    }
-                    if (decoded < 0) {
-                        // Attempt inband FEC before falling back to PLC. If
-                        // the next in-order packet is already queued, its LBRR
-                        // side-channel can reconstruct the missing frame. FEC
-                        // returns negative when the packet doesn't carry it
-                        // (underrun case, or low loss-rate encoder setting), so
-                        // we always have PLC as a fallback.
-                        const JitterBuffer::Frame* next =
-                            state->jitterBuffer->peekFront();
-                        if (next != nullptr) {
-                            decoded = state->decoder->decodeFec(
-                                next->opusData.data(),
-                                static_cast<int>(next->opusData.size()),
-                                decodedBuffer.data(), kFrameSize);
-                            if (decoded >= 0) {
-                                // FEC recovered the frame: loss was concealed
-                                // cleanly. Don't escalate the underrun counter
-                                // — escalation should only fire when loss is
-                                // genuinely unconcealable.
-                                state->consecutiveUnderruns = 0;
-                            }
-                        }
-                        if (decoded < 0) {
-                            decoded = state->decoder->decodeMissing(
-                                decodedBuffer.data(), kFrameSize);
-                            ++state->consecutiveUnderruns;
-                        }
+                    state->catchUpFrames = 0;
+                    state->catchUpMergeDue = false;
+                }
+                if (state->jitterBuffer->ramping()) {
+                    step *= audio_config::kJitterRampStretchStep;
+                }
+                state->driftResampler.setStep(step);
+                int decoded = 0;
+                if (state->driftResampler.inputNeeded(frameSize) > 0) {
+                    decoded = decodeNextFrame(
+                        *state, decodedBuffer.data(), decodedBuffer2.data());
+                    if (decoded > 0) {
+                        state->driftResampler.write(decodedBuffer.data(),
+                                                    decoded);
                     }
                 }
-
-                // Per-peer VAD: compute RMS on decoded PCM and update hysteresis.
-                // Kept inside stateLock so isPeerTalking() reads are race-free.
-                if (decoded > 0) {
-                    double sum = 0.0;
-                    for (int j = 0; j < decoded; ++j) {
-                        double s = decodedBuffer[j] / 32768.0;
-                        sum += s * s;
+                // Further pulls must be real, in-order frames — never a
+                // second PLC frame. Unless the peer's frames are shorter than
+                // our tick, there's at most one, and only of a frame the
+                // buffer holds beyond its target, never one that would make
+                // the next tick underrun. If it isn't there yet the read
+                // below comes up short, which the mixer ring absorbs; the
+                // sender-fast skew that caused the deficit is what puts that
+                // frame in the buffer.
+                constexpr int kMaxPulls =
+                    audio_config::kFrameDurationMs / audio_config::kLowLatencyFrameDurationMs + 1;
+                for (int pulls = 1; pulls < kMaxPulls &&
+                                    state->driftResampler.inputNeeded(frameSize) > 0;
+                     ++pulls) {
+                    const bool shortFrames = decoded > 0 && decoded < frameSize;
+                    if (!shortFrames &&
+                        (pulls > 1 || state->jitterBuffer->currentDepth() <=
+                                          state->jitterBuffer->targetDepth())) {
+                        break;
                     }
-                    double rms = std::sqrt(sum / decoded);
-                    if (state->peerVad.update(
-                            rms > VadDetector::kDefaultThreshold, decoded)) {
-                        anyTalkingChanged = true;
+                    const JitterBuffer::Frame* next =
+                        state->jitterBuffer->peekFront();
+                    if (next == nullptr ||
+                        next->seq != state->jitterBuffer->playhead()) {
+                        break;
                     }
+                    decoded = decodeNextFrame(*state, decodedBuffer.data(),
+                                              decodedBuffer2.data());
+                    if (decoded <= 0) break;
+                    state->driftResampler.write(decodedBuffer.data(), decoded);
                 }
+                produced = state->driftResampler.read(driftBuffer.data(),
+                                                      frameSize);
+                if (state->peerVad.talking()) anyPeerTalking = true;
+                // For the governor, taken while we hold the lock the VAD and
+                // rate control are written under.
+                state->talkingOrWeak =
+                    state->peerVad.talking() ||
+                    state->bitrateController.lossPct() >
+                        audio_config::kGovernorWeakLinkLossPct;
+                // Already holding the lock pollers used to take: copy the
+                // counters out for the telemetry board while we're here.
+                if (publishTelemetry) {
+                    telemetry = LinkTelemetry{};
+                    collectLockedTelemetry(*state, telemetry);
+                }
+            }
+            if (publishTelemetry) {
+                collectSharedTelemetry(*state, telemetry);
+                marshalTelemetry(telemetry, telemetryFields);
+                telemetryBoard_.publish(slotFor(state->deviceId),
+                                        state->deviceId, telemetryFields);
             }
 
-            if (decoded > 0 && mixer) {
-                mixer->updateDeviceAudio(state->deviceId,
-                                         decodedBuffer.data(), decoded);
+            if (produced > 0 && mixer) {
+                mixer->updateDeviceAudio(state->deviceId, driftBuffer.data(),
+                                         produced);
             }
         }
 
-        // Emit talkingPeers event whenever any peer's VAD edge fires or a
-        // peer was removed (talkingPeersDirty_ set by unregisterPeer()).
-        const bool dirty =
-            talkingPeersDirty_.exchange(false, std::memory_order_acq_rel);
-        if ((anyTalkingChanged || dirty) && env != nullptr) {
-            std::vector<std::string> talkingMacs;
-            for (size_t i = 0; i < peerSnapshot.size(); ++i) {
-                if (peerSnapshot[i]->peerVad.talking()) {
-                    talkingMacs.push_back(macSnapshot[i]);
-                }
+        // Publish the talking set (talking_state.h). Rebuilt from the
+        // snapshot every tick, so a peer that unregistered simply drops out;
+        // the notifier thread tells Kotlin when it changes.
+        talkingPeersDirty_.store(false, std::memory_order_relaxed);
+        uint32_t talkingMask = 0;
+        for (const auto& state : peerSnapshot) {
+            if (state->peerVad.talking()) {
+                talkingMask |= 1u << slotFor(state->deviceId);
             }
-            sendTalkingPeersEvent(env, talkingMacs);
         }
+        talkingState_.publish(talkingMask);
+
+        // Idle-room bookkeeping. Frame arrival alone doesn't count as
+        // activity: every peer sends continuously until *it* goes quiet, so
+        // treating silent frames as activity would hold two quiet phones
+        // awake forever on each other's silence.
+        const bool localActive = localActivity_.exchange(false);
+        const bool roomActive = anyPeerTalking || localActive;
+        quietTicks = roomActive ? 0 : std::min(quietTicks + 1, parkTicks);
+        ticksSinceLocalVoice =
+            localActive ? 0 : std::min(ticksSinceLocalVoice + 1, parkTicks);
+        ticksSinceArrival = frameArrived_.exchange(false)
+                                ? 0
+                                : std::min(ticksSinceArrival + 1, parkTicks);
+        const bool suppressSend =
+            quietTicks >= audio_config::kIdleSuppressAfterTicks * tickScale;
 
         // ---- Mix-minus + encode pass: produce one outbound frame per peer.
+        // Timed by phase for the governor: the mixing, and the rest.
+        const int64_t decodeDoneNs = monotonicNowNs();
+        int64_t mixNs = 0;
+        const int governorLevel = tickGovernor_.level();
+        // Push-to-talk pre-roll (audio_config::kPreRoll): the mic is keyed
+        // and just carried speech, so a talkspurt opening now is ours.
+        const bool preRollArmed =
+            mixer && preRoll_.load(std::memory_order_relaxed) &&
+            mixer->localPreRoll().keyed() &&
+            ticksSinceLocalVoice <= audio_config::kPreRollOnsetTicks * tickScale;
         for (size_t i = 0; i < peerSnapshot.size(); ++i) {
             auto& state = peerSnapshot[i];
-            const std::string& mac = macSnapshot[i];
 
+            // Re-registered (registerPeer): nothing this thread queued or
+            // negotiated for the old link carries into the new one.
+            if (state->linkRenewed.exchange(false, std::memory_order_acquire)) {
+                state->pendingBundle.clear();
+                state->bundleOfferTicks = 0;
+                state->headerEncoder = CompactHeaderEncoder{};
+                state->talkspurtOpen = false;
+                state->outboundQuietTicks = 0;
+                state->askedLowLatency = false;
+                state->offeredPreRoll = false;
+                // Rate control starts over from the default bitrate.
+                std::lock_guard<std::mutex> stateLock(state->mutex);
+                state->bitrateController = BitrateController{};
+                state->bitrate.store(
+                    state->encoder->setBitrate(audio_config::kDefaultBitrate),
+                    std::memory_order_relaxed);
+            }
+
+            // What of the mic the mix is about to take is still in its ring
+            // (capped as the mix will cap it); the pre-roll ends where that
+            // begins.
+            const bool preRollCandidate = preRollArmed && !state->talkspurtOpen;
+            const size_t micBacklog =
+                preRollCandidate
+                    ? std::min(mixer->bufferedSamples(AudioMixer::kLocalMicDeviceId),
+                               playoutRingCap)
+                    : 0;
+
+            const int64_t mixStartNs = monotonicNowNs();
             if (mixer) {
                 mixer->getMixedAudioForDevice(
-                    state->deviceId, mixedBuffer.data(), kFrameSize);
+                    state->deviceId, mixedBuffer.data(), frameSize);
             } else {
                 std::fill(mixedBuffer.begin(), mixedBuffer.end(), 0);
             }
+            mixNs += monotonicNowNs() - mixStartNs;
+            OutboundFrameRing& ring = *state->outbound;
+            const int64_t nowMs = steadyNowMs();
+
+            // Silence suppression (audio_config::kSilenceSuppression): this
+            // peer's own mix has been quiet for the hangover. DTX follows
+            // the mode, so the hangover itself goes out as DTX packets.
+            const bool suppressSilence =
+                silenceSuppression_.load(std::memory_order_relaxed);
+            if (state->encoderDtx != suppressSilence) {
+                std::lock_guard<std::mutex> stateLock(state->mutex);
+                state->encoder->setDtx(suppressSilence);
+                state->encoderDtx = suppressSilence;
+            }
+            const int hangoverTicks = audio_config::kTalkspurtHangoverTicks * tickScale;
+            state->outboundQuietTicks =
+                frameRms(mixedBuffer.data(), frameSize, state->rmsStride) >
+                        VadDetector::kDefaultThreshold
+                    ? 0
+                    : std::min(state->outboundQuietTicks + 1, hangoverTicks);
+            const bool gated =
+                suppressSilence && state->outboundQuietTicks >= hangoverTicks;
+
+            // Quiet room, or a quiet mix for this peer: keep draining the
+            // rings above (so nothing stale is waiting when someone speaks)
+            // but stop putting silence on the air, and say so. The outbound
+            // seq doesn't advance, so the peer sees no gap.
+            if (suppressSend || gated) {
+                flushBundle(*state, ring, nowMs);
+                endTalkspurt(*state, ring, outboundSeq[state->deviceId], nowMs);
+                continue;
+            }
+
+            // Backpressure: if the writer is behind, don't encode a frame
+            // that would only queue behind the backlog. FEC goes off for the
+            // duration; the seq holds, as for a quiet room. A pre-roll
+            // burst's packets don't count while its allowance lasts.
+            const size_t queued = ring.depth();
+            const int64_t oldestMs = ring.oldestAgeMs(nowMs);
+            const bool congested =
+                state->outboundCongested
+                    ? !(queued <= audio_config::kOutboundDecongestedFrames &&
+                        oldestMs < audio_config::kOutboundCongestedAgeMs)
+                    : (queued >= audio_config::kOutboundCongestedFrames +
+                                     state->preRollAllowance ||
+                       oldestMs >= audio_config::kOutboundCongestedAgeMs);
+            state->preRollAllowance =
+                std::min(state->preRollAllowance > 0 ? state->preRollAllowance - 1 : 0,
+                         queued);
+            if (congested != state->outboundCongested) {
+                state->outboundCongested = congested;
+                LOGI("Peer %d outbound %s (%zu queued, oldest %lld ms)",
+                     state->deviceId, congested ? "congested" : "recovered",
+                     queued, static_cast<long long>(oldestMs));
+            }
+            applyGovernorPlan(*state, governorLevel);
+            // Rate control runs whether or not this tick encodes: a
+            // congested peer is exactly the one that needs its bitrate cut.
+            if (++state->bitrateControlTicks >=
+                audio_config::kBitrateControlTicks * tickScale) {
+                state->bitrateControlTicks = 0;
+                std::lock_guard<std::mutex> stateLock(state->mutex);
+                controlBitrate(*state, ring, frameMs);
+            }
+            if (congested) {
+                flushBundle(*state, ring, nowMs);
+                ring.noteCongestionSkip();
+                continue;
+            }
+
+            // Tell the peer, in-band, that we can unpack its bundles and
+            // decode compact headers, and which frames we want. We ask this
+            // peer for 10 ms frames only while every *other* peer has asked
+            // us for them: in a star room the host's answer carries the
+            // rest of the room's, so one guest that doesn't want them holds
+            // every guest at 20 ms, not just the host.
+            if (--state->bundleOfferTicks <= 0) {
+                state->bundleOfferTicks = audio_config::kBundleOfferIntervalTicks * tickScale;
+                if (ring.writeSlot()) {
+                    ring.commit(audio_config::kLinkControlBundleOffer,
+                                static_cast<uint32_t>(audio_config::kMaxBundleFrames),
+                                0, nowMs);
+                }
+                if (ring.writeSlot()) {
+                    ring.commit(audio_config::kLinkControlCompactHeaderOffer,
+                                audio_config::kCompactHeaderVersion, 0, nowMs);
+                }
+                const size_t othersLowLatency =
+                    lowLatencyPeers -
+                    (state->peerFrameMs.load(std::memory_order_relaxed) ==
+                             audio_config::kLowLatencyFrameDurationMs
+                         ? 1
+                         : 0);
+                const bool askLowLatency =
+                    wantLowLatency && othersLowLatency + 1 == peerSnapshot.size();
+                // A peer takes silence for 20 ms, so only the ask and its
+                // withdrawal go on the air.
+                if ((askLowLatency || state->askedLowLatency) && ring.writeSlot()) {
+                    ring.commit(audio_config::kLinkControlLowLatencyOffer,
+                                static_cast<uint32_t>(
+                                    askLowLatency ? audio_config::kLowLatencyFrameDurationMs
+                                                  : audio_config::kFrameDurationMs),
+                                0, nowMs);
+                    state->askedLowLatency = askLowLatency;
+                }
+                // Likewise the pre-roll offer: a peer that never hears one
+                // doesn't shed our talkspurts' openings.
+                const bool offerPreRoll = preRoll_.load(std::memory_order_relaxed);
+                if ((offerPreRoll || state->offeredPreRoll) && ring.writeSlot()) {
+                    ring.commit(audio_config::kLinkControlPreRollOffer,
+                                static_cast<uint32_t>(
+                                    offerPreRoll ? audio_config::kPreRollFrames : 0),
+                                0, nowMs);
+                    state->offeredPreRoll = offerPreRoll;
+                }
+            }
+
+            // A talkspurt of ours opens: what the mic heard just before it
+            // goes first, back-dated, as if the gate had been open all along.
+            if (preRollCandidate) {
+                sendPreRoll(*state, ring, mixer->localPreRoll(), micBacklog, frameSize,
+                            frameMs, outboundSeq[state->deviceId], nowMs,
+                            preRollBuffer.data());
+            }
+
+            // Bundling: encode into the accumulator, and send once it holds
+            // framesPerPacket frames. nextFrame() has room — a flush follows
+            // any add that reaches framesPerPacket, which never exceeds
+            // kMaxBundleFrames.
+            const int framesPerPacket =
+                state->framesPerPacket.load(std::memory_order_relaxed);
+            BundleAccumulator& bundle = state->pendingBundle;
+            if (framesPerPacket > 1 || bundle.count() > 0) {
+                int encodedSize;
+                {
+                    std::lock_guard<std::mutex> stateLock(state->mutex);
+                    encodedSize = state->encoder->encode(
+                        mixedBuffer.data(), frameSize, bundle.nextFrame(),
+                        static_cast<int>(BundleAccumulator::kFrameCap));
+                }
+                if (encodedSize > 0) {
+                    bundle.add(outboundSeq[state->deviceId]++, senderTimestampMs(),
+                               static_cast<size_t>(encodedSize));
+                }
+                if (bundle.count() >= static_cast<size_t>(framesPerPacket)) {
+                    flushBundle(*state, ring, nowMs);
+                }
+                continue;
+            }
+
+            // Encode straight into the peer's outbound ring, capped to the
+            // slot. If the writer still holds every slot, encode into scratch
+            // anyway — the encoder's state has to advance — and drop it.
+            uint8_t* slot = ring.writeSlot();
+            uint8_t* encodeDst = slot ? slot : opusBuffer.data();
+            const int encodeCap =
+                slot ? static_cast<int>(OutboundFrameRing::kMaxPayloadBytes)
+                     : static_cast<int>(opusBuffer.size());
 
             // Encoder ctl (`setBitrate`, `setExpectedLossPct`) and encode() race
             // on the OpusEncoder handle; the per-peer mutex serializes them.
             int encodedSize;
             {
                 std::lock_guard<std::mutex> stateLock(state->mutex);
-
-                // Once per second, derive the windowed packet-loss rate from the
-                // jitter-buffer lifetime counters and update the FEC hint so Opus
-                // allocates the right LBRR bandwidth for the current link quality.
-                if (++state->lossPctTickCounter >= kLossPctUpdateInterval) {
-                    state->lossPctTickCounter = 0;
-                    uint64_t curLost = state->jitterBuffer->lostFrameCount();
-                    uint64_t curRecv = state->recvCount;
-                    uint64_t deltaLost = curLost - state->lossPctPrevLost;
-                    uint64_t deltaRecv = curRecv - state->lossPctPrevRecv;
-                    state->lossPctPrevLost = curLost;
-                    state->lossPctPrevRecv = curRecv;
-                    uint64_t total = deltaLost + deltaRecv;
-                    if (total > 0) {
-                        int pct = static_cast<int>(deltaLost * 100 / total);
-                        state->encoder->setExpectedLossPct(pct);
-                    }
-                }
-
                 encodedSize = state->encoder->encode(
-                    mixedBuffer.data(), kFrameSize, opusBuffer.data(),
-                    static_cast<int>(opusBuffer.size()));
+                    mixedBuffer.data(), frameSize, encodeDst, encodeCap);
             }
-            if (encodedSize > 0 && env != nullptr) {
+            if (encodedSize > 0) {
                 uint32_t seq = outboundSeq[state->deviceId]++;
-                sendAudioToPeer(env, mac, opusBuffer.data(), encodedSize, seq);
+                if (slot) {
+                    commitVoice(*state, ring, seq, senderTimestampMs(),
+                                static_cast<size_t>(encodedSize), nowMs);
+                } else {
+                    ring.noteFullDrop();
+                }
             }
         }
 
-        nextTick += std::chrono::milliseconds(audio_config::kMixerTickIntervalMs);
+        const int64_t doneNs = monotonicNowNs();
+        tickWork_.record(nsToUs(doneNs - wakeNs));
+        if (tickGovernor_.record(nsToUs(decodeDoneNs - wakeNs), nsToUs(mixNs),
+                                 nsToUs(doneNs - decodeDoneNs - mixNs),
+                                 static_cast<uint32_t>(frameMs) * 1000)) {
+            LOGI("Tick governor level %d -> %d (per tick: decode %u us, mix %u us, "
+                 "encode %u us)",
+                 governorLevel, tickGovernor_.level(), tickGovernor_.meanDecodeUs(),
+                 tickGovernor_.meanMixUs(), tickGovernor_.meanEncodeUs());
+        }
+        if (++statsTicks >= audio_config::kTickStatsWindowTicks * tickScale) {
+            tickLateness_.rollWindow();
+            tickWork_.rollWindow();
+            statsTicks = 0;
+        }
+
+        const int64_t tickIntervalNs = static_cast<int64_t>(frameMs) * 1000000LL;
+        deadlineNs += tickIntervalNs;
+        // Overrun: this tick's lateness plus work already ate into the next
+        // one, so the next wake is late before it starts.
+        const int64_t behindNs = doneNs - deadlineNs;
+        if (behindNs > 0) {
+            tickOverrunCount_.fetch_add(1, std::memory_order_relaxed);
+        }
         // If we fell behind by more than a tick (e.g. a long stop-the-world
         // GC on the JVM side), don't try to catch up — re-anchor to "now".
         // Catching up just produces a burst of frames that a healthy peer
         // would interpret as a seq jump and the unhealthy peer is already
         // poisoned by the protocol's stuck-producer rule.
-        const auto drift = std::chrono::steady_clock::now() - nextTick;
-        if (drift > std::chrono::milliseconds(
-                        audio_config::kMixerTickIntervalMs * 2)) {
+        if (behindNs > 2 * tickIntervalNs) {
             LOGW("Mixer tick fell behind by %lld ms; re-anchoring",
-                 static_cast<long long>(
-                     std::chrono::duration_cast<std::chrono::milliseconds>(drift)
-                         .count()));
-            nextTick = std::chrono::steady_clock::now();
-        }
-    }
-
-    if (attached) {
-        JavaVM* jvm = jvm_.load(std::memory_order_acquire);
-        if (jvm) {
-            jvm->DetachCurrentThread();
+                 static_cast<long long>(behindNs / 1000000LL));
+            deadlineNs = monotonicNowNs();
         }
     }
 
     LOGI("Mixer tick loop ended");
 }
 
-void PeerAudioManager::sendAudioToPeer(JNIEnv* env,
-                                        const std::string& macAddress,
-                                        const uint8_t* opusData, int opusSize,
-                                        uint32_t seq) {
-    if (!env) {
-        return;
-    }
-
-    // Snapshot the global ref under callbackMutex_ into a local ref. This
-    // rules out the race where setCallback (JNI thread) calls
-    // DeleteGlobalRef while we're mid-CallVoidMethod on the mixer thread.
-    // The local ref is independent of the global; it survives even if the
-    // global is concurrently swapped or deleted.
-    jobject callback = nullptr;
-    {
-        std::lock_guard<std::mutex> lock(callbackMutex_);
-        if (callbackObject_) {
-            callback = env->NewLocalRef(callbackObject_);
-        }
-    }
-    if (!callback) {
-        return;
-    }
-
-    jclass callbackClass = env->GetObjectClass(callback);
-    if (callbackClass) {
-        jmethodID method = env->GetMethodID(callbackClass, "onMixedAudioReady",
-                                            "(Ljava/lang/String;[BI)V");
-        if (method) {
-            // Either alloc can return null and leave a pending OOM
-            // exception. Check both before passing them to JNI calls that
-            // would crash on null (SetByteArrayRegion in particular). On
-            // failure we clear the pending exception so the next JNI call
-            // on this thread doesn't assert, and bail.
-            jstring jMac = env->NewStringUTF(macAddress.c_str());
-            jbyteArray jData = env->NewByteArray(opusSize);
-            if (jMac != nullptr && jData != nullptr) {
-                env->SetByteArrayRegion(
-                    jData, 0, opusSize,
-                    reinterpret_cast<const jbyte*>(opusData));
-
-                env->CallVoidMethod(callback, method, jMac, jData,
-                                    static_cast<jint>(seq));
-
-                // Defensive: clear any pending exception from the Java
-                // callback so the next JNI call doesn't trip an assert.
-                // The protocol contract is that the callback returns void
-                // without throwing, but we shouldn't crash the foreground
-                // service if Kotlin code throws unexpectedly.
-                if (env->ExceptionCheck()) {
-                    env->ExceptionDescribe();
-                    env->ExceptionClear();
-                }
-            } else {
-                LOGE("sendAudioToPeer: JNI alloc failed (jMac=%p jData=%p)",
-                     jMac, jData);
-                if (env->ExceptionCheck()) {
-                    env->ExceptionDescribe();
-                    env->ExceptionClear();
+void PeerAudioManager::talkNotifierLoop() {
+    // Attached lazily: if the thread starts before setCallback() publishes
+    // jvm_ there is nothing to attach to — or to call — yet. Masks that
+    // change before then are dropped; setCallback() asks for a resend, so
+    // the new callback still starts from the current set.
+    JNIEnv* env = nullptr;
+    bool attached = false;
+    uint32_t sent = 0;
+    uint32_t mask = 0;
+    while (talkingState_.waitForChange(sent, &mask)) {
+        sent = mask;
+        // The acquire load pairs with the release store in setCallback().
+        JavaVM* jvm = jvm_.load(std::memory_order_acquire);
+        if (env == nullptr && jvm != nullptr) {
+            if (jvm->GetEnv(reinterpret_cast<void**>(&env),
+                            JNI_VERSION_1_6) != JNI_OK) {
+                if (jvm->AttachCurrentThread(&env, nullptr) == JNI_OK) {
+                    attached = true;
+                } else {
+                    LOGE("talkNotifierLoop: AttachCurrentThread failed");
+                    env = nullptr;
                 }
             }
-
-            if (jMac) env->DeleteLocalRef(jMac);
-            if (jData) env->DeleteLocalRef(jData);
         }
-        env->DeleteLocalRef(callbackClass);
-    }
-    env->DeleteLocalRef(callback);
-}
+        if (env == nullptr) continue;
 
-void PeerAudioManager::sendTalkingPeersEvent(
-    JNIEnv* env, const std::vector<std::string>& talkingMacs) {
-    jobject callback = nullptr;
-    {
-        std::lock_guard<std::mutex> lock(callbackMutex_);
-        if (callbackObject_) {
-            callback = env->NewLocalRef(callbackObject_);
+        // Snapshot the callback; the local ref survives a concurrent
+        // setCallback() swapping it.
+        jobject callback = nullptr;
+        jmethodID method = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(callbackMutex_);
+            if (callbackObject_ && talkingMaskMethod_) {
+                callback = env->NewLocalRef(callbackObject_);
+                method = talkingMaskMethod_;
+            }
+        }
+        if (!callback) continue;
+        env->CallVoidMethod(callback, method, static_cast<jint>(mask));
+        if (env->ExceptionCheck()) {
+            env->ExceptionDescribe();
+            env->ExceptionClear();
         }
+        env->DeleteLocalRef(callback);
     }
-    if (!callback) return;
-
-    jclass callbackClass = env->GetObjectClass(callback);
-    if (callbackClass) {
-        jmethodID method = env->GetMethodID(
-            callbackClass, "onTalkingPeersChanged", "([Ljava/lang/String;)V");
-        if (method) {
-            jclass stringClass = env->FindClass("java/lang/String");
-            if (stringClass == nullptr) {
-                LOGE("sendTalkingPeersEvent: FindClass(java/lang/String) failed");
-                if (env->ExceptionCheck()) {
-                    env->ExceptionDescribe();
-                    env->ExceptionClear();
-                }
-            } else {
-                jobjectArray peerArray = env->NewObjectArray(
-                    static_cast<jsize>(talkingMacs.size()), stringClass, nullptr);
-                if (peerArray == nullptr) {
-                    LOGE("sendTalkingPeersEvent: NewObjectArray failed");
-                    if (env->ExceptionCheck()) {
-                        env->ExceptionDescribe();
-                        env->ExceptionClear();
-                    }
-                } else {
-                    bool arrayOk = true;
-                    for (size_t i = 0; i < talkingMacs.size(); ++i) {
-                        jstring s = env->NewStringUTF(talkingMacs[i].c_str());
-                        if (!s) {
-                            arrayOk = false;
-                            if (env->ExceptionCheck()) {
-                                env->ExceptionDescribe();
-                                env->ExceptionClear();
-                            }
-                            break;
-                        }
-                        env->SetObjectArrayElement(peerArray, static_cast<jsize>(i), s);
-                        env->DeleteLocalRef(s);
-                        if (env->ExceptionCheck()) {
-                            env->ExceptionDescribe();
-                            env->ExceptionClear();
-                            arrayOk = false;
-                            break;
-                        }
-                    }
-                    if (arrayOk) {
-                        env->CallVoidMethod(callback, method, peerArray);
-                    }
-                    if (env->ExceptionCheck()) {
-                        env->ExceptionDescribe();
-                        env->ExceptionClear();
-                    }
-                    env->DeleteLocalRef(peerArray);
-                }
-                env->DeleteLocalRef(stringClass);
-            }
+
+    if (attached) {
+        if (JavaVM* jvm = jvm_.load(std::memory_order_acquire)) {
+            jvm->DetachCurrentThread();
         }
-        env->DeleteLocalRef(callbackClass);
     }
-    env->DeleteLocalRef(callback);
+}
+
+int PeerAudioManager::peerLevel(int handle) const {
+    std::shared_ptr<PeerState> state = findPeer(handle);
+    return state ? talkingState_.level(slotFor(handle)) : 0;
 }
 
 void PeerAudioManager::setCallback(JNIEnv* env, jobject callback) {
     // Publish jvm_ first with release semantics so that as soon as the
-    // mixer thread observes a non-null jvm_ via its acquire load, it can
+    // notifier thread observes a non-null jvm_ via its acquire load, it can
     // safely use it without further synchronization. Capturing the JavaVM
     // is idempotent, but we still go through the atomic to keep the
     // happens-before edge correct.
@@ -853,11 +2023,35 @@ void PeerAudioManager::setCallback(JNIEnv* env, jobject callback) {
         env->GetJavaVM(&vm);
         jvm_.store(vm, std::memory_order_release);
     }
-    std::lock_guard<std::mutex> lock(callbackMutex_);
-    if (callbackObject_) {
-        env->DeleteGlobalRef(callbackObject_);
+    // Resolve the callback's method once, here, instead of on every
+    // talking-set update from the notifier thread.
+    jmethodID method = nullptr;
+    if (callback) {
+        jclass callbackClass = env->GetObjectClass(callback);
+        if (callbackClass) {
+            method = env->GetMethodID(callbackClass, "onTalkingMaskChanged",
+                                      "(I)V");
+            env->DeleteLocalRef(callbackClass);
+        }
+        if (!method) {
+            LOGE("setCallback: failed to resolve onTalkingMaskChanged");
+            if (env->ExceptionCheck()) {
+                env->ExceptionDescribe();
+                env->ExceptionClear();
+            }
+        }
     }
-    callbackObject_ = env->NewGlobalRef(callback);
+
+    {
+        std::lock_guard<std::mutex> lock(callbackMutex_);
+        if (callbackObject_) {
+            env->DeleteGlobalRef(callbackObject_);
+        }
+        callbackObject_ = callback ? env->NewGlobalRef(callback) : nullptr;
+        talkingMaskMethod_ = method;
+    }
+    // The new callback hasn't seen the current set yet.
+    talkingState_.requestResend();
     LOGI("JNI callback set");
 }
 
@@ -872,42 +2066,58 @@ void PeerAudioManager::clear() {
             mixer->removeDevice(state->deviceId);
         }
     }
+    for (const auto& [mac, state] : peers_) {
+        state->outbound->close();
+    }
     peers_.clear();
     deviceIdToMac_.clear();
-    nextDeviceId_ = 1;
+    for (auto& slot : slots_) {
+        std::atomic_store(&slot, std::shared_ptr<PeerState>());
+    }
+    warmStart_.clear();
+    talkingState_.reset();
     LOGI("PeerAudioManager cleared");
 }
 
-PeerAudioManager* g_peerAudioManager = nullptr;
+std::shared_ptr<PeerAudioManager> g_peerAudioManager;
 
-// Serializes JNI entrypoints against `nativeClear`, which can delete the
-// singleton from one thread while another is mid-call. Mirrors the
-// g_engineMutex pattern in audio_engine.cpp. The mixer thread itself runs
-// without taking this mutex — it only ever uses snapshots of the manager's
-// internal state, so once the manager is alive long enough to start the
-// thread, the thread can safely outlive any JNI race.
+// Serializes the lifecycle entry points (init, clear, mixer start/stop,
+// callback) against each other. Everything else — including the per-frame
+// push — runs without it: each call takes its own reference to the manager
+// with std::atomic_load (the g_audioMixer pattern from audio_mixer.h), so
+// nativeClear can unpublish and tear down the singleton while another
+// thread is mid-call, and the last reference frees it. The mixer thread
+// itself never touches the global; once stopped by clear() it holds nothing.
 static std::mutex g_peerManagerMutex;
 
+void peerAudioManagerNoteLocalActivity() {
+    if (auto mgr = std::atomic_load(&g_peerAudioManager)) {
+        mgr->noteLocalActivity();
+    }
+}
+
 extern "C" {
 
 JNIEXPORT void JNICALL
 Java_com_elodin_walkie_1talkie_PeerAudioManager_nativeInit(JNIEnv* env,
                                                             jobject thiz) {
     std::lock_guard<std::mutex> lock(g_peerManagerMutex);
-    if (g_peerAudioManager == nullptr) {
-        g_peerAudioManager = new PeerAudioManager();
+    if (!std::atomic_load(&g_peerAudioManager)) {
+        std::atomic_store(&g_peerAudioManager,
+                          std::make_shared<PeerAudioManager>());
         LOGI("PeerAudioManager native initialized");
     }
 }
 
+// Returns the peer's handle (its device ID), or -1.
 JNIEXPORT jint JNICALL
 Java_com_elodin_walkie_1talkie_PeerAudioManager_nativeRegisterPeer(
     JNIEnv* env, jobject thiz, jstring macAddress) {
-    std::lock_guard<std::mutex> lock(g_peerManagerMutex);
-    if (!g_peerAudioManager) return -1;
+    auto mgr = std::atomic_load(&g_peerAudioManager);
+    if (!mgr) return -1;
     const char* mac = env->GetStringUTFChars(macAddress, nullptr);
     if (!mac) return -1;
-    int id = g_peerAudioManager->registerPeer(std::string(mac));
+    int id = mgr->registerPeer(std::string(mac));
     env->ReleaseStringUTFChars(macAddress, mac);
     return id;
 }
@@ -915,11 +2125,11 @@ Java_com_elodin_walkie_1talkie_PeerAudioManager_nativeRegisterPeer(
 JNIEXPORT void JNICALL
 Java_com_elodin_walkie_1talkie_PeerAudioManager_nativeUnregisterPeer(
     JNIEnv* env, jobject thiz, jstring macAddress) {
-    std::lock_guard<std::mutex> lock(g_peerManagerMutex);
-    if (!g_peerAudioManager) return;
+    auto mgr = std::atomic_load(&g_peerAudioManager);
+    if (!mgr) return;
     const char* mac = env->GetStringUTFChars(macAddress, nullptr);
     if (!mac) return;
-    g_peerAudioManager->unregisterPeer(std::string(mac));
+    mgr->unregisterPeer(std::string(mac));
     env->ReleaseStringUTFChars(macAddress, mac);
 }
 
@@ -927,16 +2137,17 @@ JNIEXPORT jboolean JNICALL
 Java_com_elodin_walkie_1talkie_PeerAudioManager_nativeStartMixerThread(
     JNIEnv* env, jobject thiz) {
     std::lock_guard<std::mutex> lock(g_peerManagerMutex);
-    if (!g_peerAudioManager) return JNI_FALSE;
-    return g_peerAudioManager->startMixerThread() ? JNI_TRUE : JNI_FALSE;
+    auto mgr = std::atomic_load(&g_peerAudioManager);
+    if (!mgr) return JNI_FALSE;
+    return mgr->startMixerThread() ? JNI_TRUE : JNI_FALSE;
 }
 
 JNIEXPORT void JNICALL
 Java_com_elodin_walkie_1talkie_PeerAudioManager_nativeStopMixerThread(
     JNIEnv* env, jobject thiz) {
     std::lock_guard<std::mutex> lock(g_peerManagerMutex);
-    if (g_peerAudioManager) {
-        g_peerAudioManager->stopMixerThread();
+    if (auto mgr = std::atomic_load(&g_peerAudioManager)) {
+        mgr->stopMixerThread();
     }
 }
 
@@ -944,8 +2155,8 @@ JNIEXPORT void JNICALL
 Java_com_elodin_walkie_1talkie_PeerAudioManager_nativeSetCallback(
     JNIEnv* env, jobject thiz, jobject callback) {
     std::lock_guard<std::mutex> lock(g_peerManagerMutex);
-    if (g_peerAudioManager) {
-        g_peerAudioManager->setCallback(env, callback);
+    if (auto mgr = std::atomic_load(&g_peerAudioManager)) {
+        mgr->setCallback(env, callback);
     }
 }
 
@@ -953,121 +2164,214 @@ JNIEXPORT void JNICALL
 Java_com_elodin_walkie_1talkie_PeerAudioManager_nativeClear(JNIEnv* env,
                                                              jobject thiz) {
     std::lock_guard<std::mutex> lock(g_peerManagerMutex);
-    if (g_peerAudioManager) {
-        g_peerAudioManager->clear();
-        delete g_peerAudioManager;
-        g_peerAudioManager = nullptr;
+    auto mgr = std::atomic_load(&g_peerAudioManager);
+    if (mgr) {
+        // Unpublish first so no new call picks the manager up, then stop
+        // the mixer and drop the peers. A call already holding a reference
+        // finishes against the emptied manager, and frees it.
+        std::atomic_store(&g_peerAudioManager,
+                          std::shared_ptr<PeerAudioManager>());
+        mgr->clear();
     }
 }
 
-// Push a peer-arrived Opus frame into the peer's jitter buffer. `seq` is the
+// Push a peer-arrived Opus frame into the peer's jitter buffer. `handle` is
+// the value nativeRegisterPeer returned. `seq` is the
 // per-link uint32 from the VoiceFrame header; arrives as `jlong` so the
 // unsigned value survives the JNI hop without sign extension. Range-checking
-// happens on the Kotlin side (PeerAudioManager.kt:69); this function trusts
-// its input.
+// happens on the Kotlin side (PeerAudioManager.kt); this function trusts
+// its input. No global lock, no string marshaling: one atomic load for the
+// manager, one for the peer's slot.
 JNIEXPORT void JNICALL
 Java_com_elodin_walkie_1talkie_PeerAudioManager_nativeOnVoiceFrameReceived(
-    JNIEnv* env, jobject thiz, jstring macAddress, jbyteArray opusData,
+    JNIEnv* env, jobject thiz, jint handle, jbyteArray opusData,
     jlong seq, jlong senderTsMs) {
-    std::lock_guard<std::mutex> lock(g_peerManagerMutex);
-    if (!g_peerAudioManager) return;
-    const char* mac = env->GetStringUTFChars(macAddress, nullptr);
-    if (!mac) return;
+    auto mgr = std::atomic_load(&g_peerAudioManager);
+    if (!mgr) return;
     jsize size = env->GetArrayLength(opusData);
     jbyte* buf = env->GetByteArrayElements(opusData, nullptr);
-    if (!buf) {
-        env->ReleaseStringUTFChars(macAddress, mac);
-        return;
-    }
+    if (!buf) return;
 
-    g_peerAudioManager->onVoiceFramePushed(
-        std::string(mac), static_cast<uint32_t>(seq),
+    mgr->onVoiceFramePushed(
+        static_cast<int>(handle), static_cast<uint32_t>(seq),
         static_cast<uint32_t>(senderTsMs),
         reinterpret_cast<const uint8_t*>(buf), static_cast<int>(size));
 
     env->ReleaseByteArrayElements(opusData, buf, JNI_ABORT);
-    env->ReleaseStringUTFChars(macAddress, mac);
+}
+
+// Batched stream ingestion. The Kotlin receive loop owns one VoiceFrameParser
+// per socket (as an opaque jlong) and feeds it raw socket bytes from a reused
+// direct ByteBuffer; each complete frame goes straight to the peer's jitter
+// buffer. The parser lives with the stream, not the peer, so framing survives
+// bytes that arrive before the peer is registered (those frames are dropped,
+// as nativeOnVoiceFrameReceived would).
+JNIEXPORT jlong JNICALL
+Java_com_elodin_walkie_1talkie_PeerAudioManager_nativeCreateVoiceStream(
+    JNIEnv* env, jclass clazz) {
+    return reinterpret_cast<jlong>(new VoiceFrameParser());
+}
+
+JNIEXPORT void JNICALL
+Java_com_elodin_walkie_1talkie_PeerAudioManager_nativeDestroyVoiceStream(
+    JNIEnv* env, jclass clazz, jlong stream) {
+    delete reinterpret_cast<VoiceFrameParser*>(stream);
+}
+
+// Parse `length` bytes from the start of `buffer` (a direct ByteBuffer) and
+// push every complete VoiceFrame for `handle`. Returns the number of frames
+// parsed, or -1 on a fatal framing error (the caller closes the channel).
+JNIEXPORT jint JNICALL
+Java_com_elodin_walkie_1talkie_PeerAudioManager_nativeIngestVoiceStream(
+    JNIEnv* env, jclass clazz, jlong stream, jint handle, jobject buffer,
+    jint length) {
+    auto* parser = reinterpret_cast<VoiceFrameParser*>(stream);
+    if (!parser || length < 0) return -1;
+    auto* data = static_cast<const uint8_t*>(env->GetDirectBufferAddress(buffer));
+    if (!data || env->GetDirectBufferCapacity(buffer) < length) return -1;
+
+    auto mgr = std::atomic_load(&g_peerAudioManager);
+    return parser->feed(
+        data, static_cast<size_t>(length),
+        [&](uint32_t seq, uint32_t senderTsMs, const uint8_t* payload,
+            size_t payloadLen) {
+            if (mgr) {
+                mgr->onVoiceFramePushed(static_cast<int>(handle), seq,
+                                        senderTsMs, payload,
+                                        static_cast<int>(payloadLen));
+            }
+        },
+        [&](uint32_t opcode, uint32_t arg) {
+            if (mgr) mgr->onLinkControlFrame(static_cast<int>(handle), opcode, arg);
+        });
+}
+
+// Claim `handle`'s outbound ring for the calling writer thread. Returns an
+// owning pointer (a heap-held shared_ptr, so the ring outlives the peer
+// while the writer holds it), or 0 if the peer is gone or another writer
+// still holds the ring.
+JNIEXPORT jlong JNICALL
+Java_com_elodin_walkie_1talkie_PeerAudioManager_nativeAttachOutbound(
+    JNIEnv* env, jclass clazz, jint handle) {
+    auto mgr = std::atomic_load(&g_peerAudioManager);
+    if (!mgr) return 0;
+    auto ring = mgr->outboundRing(static_cast<int>(handle));
+    if (!ring || !ring->claim()) return 0;
+    return reinterpret_cast<jlong>(new std::shared_ptr<OutboundFrameRing>(std::move(ring)));
+}
+
+JNIEXPORT void JNICALL
+Java_com_elodin_walkie_1talkie_PeerAudioManager_nativeDetachOutbound(
+    JNIEnv* env, jclass clazz, jlong ring) {
+    auto* holder = reinterpret_cast<std::shared_ptr<OutboundFrameRing>*>(ring);
+    if (!holder) return;
+    (*holder)->unclaim();
+    delete holder;
+}
+
+// A direct ByteBuffer over the ring's slots. The writer creates it once per
+// attach and reads frames out of it at the offsets acquire returns.
+JNIEXPORT jobject JNICALL
+Java_com_elodin_walkie_1talkie_PeerAudioManager_nativeOutboundBuffer(
+    JNIEnv* env, jclass clazz, jlong ring) {
+    auto* holder = reinterpret_cast<std::shared_ptr<OutboundFrameRing>*>(ring);
+    if (!holder) return nullptr;
+    return env->NewDirectByteBuffer((*holder)->storage(),
+                                    OutboundFrameRing::storageBytes());
+}
+
+// Block up to `timeoutMs` for the next frame. Returns its offset in the
+// buffer (length prefix first), OutboundFrameRing::kEmpty on timeout, or
+// kClosed once the peer has been unregistered.
+JNIEXPORT jint JNICALL
+Java_com_elodin_walkie_1talkie_PeerAudioManager_nativeOutboundAcquire(
+    JNIEnv* env, jclass clazz, jlong ring, jint timeoutMs) {
+    auto* holder = reinterpret_cast<std::shared_ptr<OutboundFrameRing>*>(ring);
+    if (!holder) return OutboundFrameRing::kClosed;
+    return (*holder)->acquire(static_cast<int>(timeoutMs));
+}
+
+JNIEXPORT void JNICALL
+Java_com_elodin_walkie_1talkie_PeerAudioManager_nativeOutboundRelease(
+    JNIEnv* env, jclass clazz, jlong ring) {
+    auto* holder = reinterpret_cast<std::shared_ptr<OutboundFrameRing>*>(ring);
+    if (holder) (*holder)->release();
 }
 
 JNIEXPORT jint JNICALL
 Java_com_elodin_walkie_1talkie_PeerAudioManager_nativeSetPeerBitrate(
-    JNIEnv* env, jobject thiz, jstring macAddress, jint bps) {
-    std::lock_guard<std::mutex> lock(g_peerManagerMutex);
-    if (!g_peerAudioManager) return -1;
-    const char* mac = env->GetStringUTFChars(macAddress, nullptr);
-    if (!mac) return -1;
-    int applied = g_peerAudioManager->setPeerBitrate(std::string(mac), bps);
-    env->ReleaseStringUTFChars(macAddress, mac);
-    return applied;
-}
-
-// Returns a 12-element int array with telemetry, or null if peer not found.
-// Layout: [underrunCount, lateFrameCount, jitterTargetDepth,
-//          jitterCurrentDepth, currentBitrate, lostFrameCount, currentLagMs,
-//          staleDropCount, recvCount, lastSeq, ringUnderReadCount,
-//          ringOverwriteCount].
-// New fields are appended so the existing index layout (0..10) is undisturbed.
-// Kotlin unpacks this into a data class — keeping the marshaling cheap
-// (no JNI object allocations) is the point.
-JNIEXPORT jintArray JNICALL
-Java_com_elodin_walkie_1talkie_PeerAudioManager_nativeGetTelemetry(
-    JNIEnv* env, jobject thiz, jstring macAddress) {
-    std::lock_guard<std::mutex> lock(g_peerManagerMutex);
-    if (!g_peerAudioManager) return nullptr;
-    const char* mac = env->GetStringUTFChars(macAddress, nullptr);
-    if (!mac) return nullptr;
-    auto t = g_peerAudioManager->getTelemetry(std::string(mac));
-    env->ReleaseStringUTFChars(macAddress, mac);
+    JNIEnv* env, jobject thiz, jint handle, jint bps) {
+    auto mgr = std::atomic_load(&g_peerAudioManager);
+    if (!mgr) return -1;
+    return mgr->setPeerBitrate(static_cast<int>(handle), bps);
+}
 
-    if (!t.valid) return nullptr;
-
-    // Single source of truth for the marshaled field count; kept in lockstep
-    // with `LinkTelemetrySnapshot.fieldCount` on the Dart side. New fields are
-    // appended so the existing index layout is undisturbed.
-    static constexpr jint kTelemetryFieldCount = 12;
-
-    jintArray arr = env->NewIntArray(kTelemetryFieldCount);
-    if (!arr) return nullptr;
-    jint values[kTelemetryFieldCount] = {
-        static_cast<jint>(t.underrunCount),
-        static_cast<jint>(t.lateFrameCount),
-        static_cast<jint>(t.jitterTargetDepth),
-        static_cast<jint>(t.jitterCurrentDepth),
-        static_cast<jint>(t.currentBitrate),
-        static_cast<jint>(t.lostFrameCount),
-        static_cast<jint>(t.currentLagMs),
-        static_cast<jint>(t.staleDropCount),
-        static_cast<jint>(t.recvCount),
-        static_cast<jint>(t.lastSeq),
-        static_cast<jint>(t.ringUnderReadCount),
-        static_cast<jint>(t.ringOverwriteCount),
-    };
-    static_assert(sizeof(values) / sizeof(values[0]) == kTelemetryFieldCount,
-                  "telemetry values[] must hold exactly kTelemetryFieldCount entries");
-    env->SetIntArrayRegion(arr, 0, kTelemetryFieldCount, values);
-    return arr;
+// Copies every registered peer's telemetry into `dst`, a direct ByteBuffer
+// the caller allocates once (native byte order), as records of
+// PeerAudioManager::kTelemetryRecordInts ints: [handle, fields...] in
+// marshalTelemetry() order. Returns the record count, or -1 without a
+// manager or with a buffer that isn't direct. Lock-free and allocation-free,
+// so polling can't stall the mixer tick (see telemetry_board.h).
+JNIEXPORT jint JNICALL
+Java_com_elodin_walkie_1talkie_PeerAudioManager_nativeReadTelemetry(
+    JNIEnv* env, jobject thiz, jobject dst) {
+    auto mgr = std::atomic_load(&g_peerAudioManager);
+    if (!mgr || !dst) return -1;
+    void* addr = env->GetDirectBufferAddress(dst);
+    const jlong capacity = env->GetDirectBufferCapacity(dst);
+    if (!addr || capacity < 0) return -1;
+    const size_t maxRecords = static_cast<size_t>(capacity) /
+                              (PeerAudioManager::kTelemetryRecordInts * sizeof(int32_t));
+    return static_cast<jint>(
+        mgr->snapshotTelemetry(static_cast<int32_t*>(addr), maxRecords));
 }
 
 JNIEXPORT void JNICALL
 Java_com_elodin_walkie_1talkie_PeerAudioManager_nativeSetPeerVolume(
-    JNIEnv* env, jobject thiz, jstring macAddress, jfloat volume) {
-    std::lock_guard<std::mutex> lock(g_peerManagerMutex);
-    if (!g_peerAudioManager) return;
-    const char* mac = env->GetStringUTFChars(macAddress, nullptr);
-    if (!mac) return;
-    g_peerAudioManager->setPeerVolume(std::string(mac), volume);
-    env->ReleaseStringUTFChars(macAddress, mac);
+    JNIEnv* env, jobject thiz, jint handle, jfloat volume) {
+    if (auto mgr = std::atomic_load(&g_peerAudioManager)) {
+        mgr->setPeerVolume(static_cast<int>(handle), volume);
+    }
 }
 
 JNIEXPORT void JNICALL
 Java_com_elodin_walkie_1talkie_PeerAudioManager_nativeSetPeerMuted(
-    JNIEnv* env, jobject thiz, jstring macAddress, jboolean muted) {
-    std::lock_guard<std::mutex> lock(g_peerManagerMutex);
-    if (!g_peerAudioManager) return;
-    const char* mac = env->GetStringUTFChars(macAddress, nullptr);
-    if (!mac) return;
-    g_peerAudioManager->setPeerMuted(std::string(mac), muted == JNI_TRUE);
-    env->ReleaseStringUTFChars(macAddress, mac);
+    JNIEnv* env, jobject thiz, jint handle, jboolean muted) {
+    if (auto mgr = std::atomic_load(&g_peerAudioManager)) {
+        mgr->setPeerMuted(static_cast<int>(handle), muted == JNI_TRUE);
+    }
+}
+
+JNIEXPORT void JNICALL
+Java_com_elodin_walkie_1talkie_PeerAudioManager_nativeSetDecodeOnArrival(
+    JNIEnv* env, jobject thiz, jboolean enabled) {
+    if (auto mgr = std::atomic_load(&g_peerAudioManager)) {
+        mgr->setDecodeOnArrival(enabled == JNI_TRUE);
+    }
+}
+
+JNIEXPORT void JNICALL
+Java_com_elodin_walkie_1talkie_PeerAudioManager_nativeSetSilenceSuppression(
+    JNIEnv* env, jobject thiz, jboolean enabled) {
+    if (auto mgr = std::atomic_load(&g_peerAudioManager)) {
+        mgr->setSilenceSuppression(enabled == JNI_TRUE);
+    }
+}
+
+JNIEXPORT void JNICALL
+Java_com_elodin_walkie_1talkie_PeerAudioManager_nativeSetLowLatencyProfile(
+    JNIEnv* env, jobject thiz, jboolean enabled) {
+    if (auto mgr = std::atomic_load(&g_peerAudioManager)) {
+        mgr->setLowLatencyProfile(enabled == JNI_TRUE);
+    }
+}
+
+JNIEXPORT void JNICALL
+Java_com_elodin_walkie_1talkie_PeerAudioManager_nativeSetPreRoll(
+    JNIEnv* env, jobject thiz, jboolean enabled) {
+    if (auto mgr = std::atomic_load(&g_peerAudioManager)) {
+        mgr->setPreRoll(enabled == JNI_TRUE);
+    }
 }
 
 }  // extern "C"
@@ -1,7 +1,9 @@
 #ifndef PEER_AUDIO_MANAGER_H
 #define PEER_AUDIO_MANAGER_H
 
+#include <array>
 #include <atomic>
+#include <condition_variable>
 #include <jni.h>
 #include <map>
 #include <memory>
@@ -10,12 +12,26 @@
 #include <thread>
 #include <vector>
 
+#include "arrival_queue.h"
 #include "audio_config.h"
 #include "audio_mixer.h"
+#include "bitrate_controller.h"
+#include "clock_drift_estimator.h"
+#include "comfort_noise.h"
 #include "jitter_buffer.h"
 #include "opus_codec.h"
+#include "opus_silence.h"
+#include "opus_toc.h"
+#include "outbound_frame_ring.h"
 #include "playout_lag_estimator.h"
+#include "resampler.h"
+#include "talking_state.h"
+#include "telemetry_board.h"
+#include "tick_governor.h"
+#include "tick_histogram.h"
 #include "vad_detector.h"
+#include "voice_bundle.h"
+#include "voice_header.h"
 
 // Owns the per-peer audio plumbing on the host (or the host's mirror image
 // running on a guest):
@@ -24,12 +40,21 @@
 //   - Per-peer Opus encoder / decoder pair.
 //   - Per-peer adaptive jitter buffer (see jitter_buffer.h).
 //   - The mixer tick that drives mix-minus encoding once every
-//     audio_config::kFrameDurationMs ms.
+//     audio_config::kFrameDurationMs ms (kLowLatencyFrameDurationMs under
+//     the low-latency profile).
 //
 // Lifecycle: `PeerAudioManager` is constructed once at JNI init via
 // `nativeInit`. The mixer thread runs from `startMixerThread` to
 // `stopMixerThread`. The class is intentionally not copyable; all access
 // goes through the singleton `g_peerAudioManager`.
+//
+// Peer handles: registerPeer() returns the peer's device ID, which is also a
+// stable integer handle (unchanged across re-register). The per-frame and
+// polling entry points have handle overloads that resolve through a
+// lock-free slot table instead of a string-keyed map under
+// `peerRegistryMutex_`, so eight receive threads and the telemetry poller
+// don't serialize on one lock. The MAC overloads remain for registration,
+// tests, and diagnostics.
 class PeerAudioManager {
 public:
     PeerAudioManager();
@@ -38,14 +63,14 @@ public:
     PeerAudioManager(const PeerAudioManager&) = delete;
     PeerAudioManager& operator=(const PeerAudioManager&) = delete;
 
-    // Per-peer telemetry snapshot. Read by JNI to feed the LinkQuality
-    // control-plane message — wiring of the message itself is a follow-up,
-    // but the C++ surface is in place so the BLE side can poll today.
+    // Per-peer telemetry snapshot. Published to the telemetry board for the
+    // LinkQuality reporter and the voice debug dashboard (see
+    // snapshotTelemetry()), marshaled by marshalTelemetry().
     struct LinkTelemetry {
         uint32_t underrunCount{0};
         uint32_t lateFrameCount{0};
         // True network loss (seq-gap). This — not lateFrameCount — is what
-        // the bitrate adapter consumes, so jitter-buffer overflow/late drops
+        // the bitrate controller consumes, so jitter-buffer overflow/late drops
         // can't be misread as link loss and floor the encoder.
         uint32_t lostFrameCount{0};
         uint32_t jitterTargetDepth{0};
@@ -68,24 +93,65 @@ public:
         // Lifetime count of partial ring writes (producer faster than consumer)
         // across both the onVoiceFrame and updateDeviceAudio paths.
         uint32_t ringOverwriteCount{0};
+        // Estimated sender-clock skew vs ours (ClockDriftEstimator), rounded
+        // to whole ppm. Positive = sender fast. 0 until the estimator has
+        // converged (~10 s of stream).
+        int32_t clockDriftPpm{0};
+        // Mixer-tick scheduling health — mixer-wide, so every peer's snapshot
+        // carries the same values. p99 wake lateness past the tick deadline
+        // and p99 tick work time over the last completed stats window (µs),
+        // plus the lifetime count of ticks whose work ran past the next
+        // deadline.
+        uint32_t tickLateP99Us{0};
+        uint32_t tickWorkP99Us{0};
+        uint32_t tickOverrunCount{0};
+        // Frames the receive path couldn't queue for the mixer (arrival
+        // queue full or payload too large) — see arrival_queue.h.
+        uint32_t arrivalDropCount{0};
+        // Outbound ring health (outbound_frame_ring.h): frames the writer
+        // shed as stale or over-backlog, frames the mixer dropped because
+        // every slot was held, and the frames queued right now.
+        uint32_t outboundStaleDropCount{0};
+        uint32_t outboundFullDropCount{0};
+        uint32_t outboundDepth{0};
+        // Encodes the mixer skipped because the outbound ring was congested.
+        uint32_t outboundSkipCount{0};
+        // BitrateController decisions: lifetime backoffs, and the expected
+        // loss (%) it last handed the encoder. currentBitrate is its output.
+        uint32_t bitrateBackoffCount{0};
+        uint32_t expectedLossPct{0};
+        // Frames per outbound VoiceFrame right now (1 = unbundled).
+        uint32_t outboundFramesPerPacket{1};
+        // Tick CPU governor (tick_governor.h): the complexity this peer's
+        // encoder runs at, and the governor's level — mixer-wide, like the
+        // tick stats.
+        uint32_t encoderComplexity{0};
+        uint32_t governorLevel{0};
         bool valid{false};
     };
 
-    // Register a peer (assign device ID). Returns device ID, or -1 on error.
+    // Register a peer (assign device ID). Returns device ID — also the
+    // peer's handle — or -1 on error (including every handle slot in use).
     int registerPeer(const std::string& macAddress);
 
     // Unregister a peer (remove from mixer). Tears down the peer's Opus
     // codec pair and jitter buffer.
     void unregisterPeer(const std::string& macAddress);
 
+    // Ready-built peer states waiting for a join (audio_config::
+    // kPeerWarmSpares once refilled). For tests and diagnostics.
+    size_t warmSpareCount();
+
     // Get device ID for a MAC address (-1 if not found).
     int getDeviceId(const std::string& macAddress);
     std::string getMacAddress(int deviceId);
 
-    // Push a peer-arrived Opus frame into the peer's jitter buffer. Called
-    // from the L2CAP receive path. `seq` is the protocol's per-link uint32.
-    // Returns true if accepted; false if dropped (late, duplicate, or peer
-    // not registered).
+    // Queue a peer-arrived Opus frame for the peer's jitter buffer. Called
+    // from the L2CAP receive path; takes no lock the mixer tick holds (see
+    // arrival_queue.h). `seq` is the protocol's per-link uint32. Returns true
+    // if queued; false if dropped here (peer not registered, queue full, or
+    // payload too large). Lateness, duplicates and staleness are judged when
+    // the mixer tick moves the frame into the jitter buffer.
     // `senderTsMs` is the VoiceFrame header's sender encode-time on a MONOTONIC
     // clock (SystemClock.elapsedRealtime, low 32 bits of ms-since-boot — not
     // wall-clock, so it can't jump under NTP); used to estimate end-to-end
@@ -93,18 +159,69 @@ public:
     bool onVoiceFramePushed(const std::string& macAddress, uint32_t seq,
                             uint32_t senderTsMs, const uint8_t* opusData,
                             int opusSize);
+    bool onVoiceFramePushed(int handle, uint32_t seq, uint32_t senderTsMs,
+                            const uint8_t* opusData, int opusSize);
+
+    // A link-control frame (a header-only VoiceFrame) from the peer: `opcode`
+    // is its seq field, `arg` its senderTsMs. Handled:
+    // audio_config::kLinkControlBundleOffer — the peer can unpack bundles of
+    // up to `arg` frames, so ours may use them — and
+    // kLinkControlCompactHeaderOffer — it reads compact headers up to version
+    // `arg` — kLinkControlLowLatencyOffer — it wants `arg` ms frames —
+    // kLinkControlPreRollOffer — its talkspurts may open with up to `arg`
+    // frames of pre-roll — and kLinkControlTalkspurtEnd — it paused, and
+    // will resume at seq `arg`. Receive thread; lock-free.
+    void onLinkControlFrame(int handle, uint32_t opcode, uint32_t arg);
 
-    // Set this peer's outbound encoder bitrate. Called when LinkQuality
-    // telemetry suggests adapting. Clamped to [kBitrateLow, kBitrateHigh].
-    // Returns the actual bitrate applied, or -1 if the peer isn't registered.
+    // Move the peer's queued arrivals into its jitter buffer now, as the
+    // mixer tick does at the start of each peer's decode step. Returns how
+    // many the jitter buffer accepted (0 if the peer isn't registered). For
+    // tests and for a stopped mixer; thread-safe.
+    size_t drainArrivals(const std::string& macAddress);
+    size_t drainArrivals(int handle);
+
+    // Cap this peer's outbound encoder bitrate (a BitrateHint from Dart).
+    // The per-peer BitrateController chooses the bitrate itself, from what
+    // the mixer tick measures, within [kBitrateLow, this cap]; a cap below
+    // the current bitrate applies at once. Returns the bitrate in effect, or
+    // -1 if the peer isn't registered.
     int setPeerBitrate(const std::string& macAddress, int bps);
+    int setPeerBitrate(int handle, int bps);
 
     // Set peer playback volume and mute state
     void setPeerVolume(const std::string& macAddress, float volume);
+    void setPeerVolume(int handle, float volume);
     void setPeerMuted(const std::string& macAddress, bool muted);
+    void setPeerMuted(int handle, bool muted);
 
-    // Snapshot current link telemetry for a peer.
+    // Snapshot current link telemetry for a peer, exactly as of now. Takes
+    // the peer's lock, so it contends with the mixer tick: for tests and
+    // diagnostics. Pollers use snapshotTelemetry().
     LinkTelemetry getTelemetry(const std::string& macAddress);
+    LinkTelemetry getTelemetry(int handle);
+
+    // Ints per record written by snapshotTelemetry(): the peer's handle, then
+    // its marshalTelemetry() fields.
+    static constexpr size_t kTelemetryRecordInts =
+        1 + static_cast<size_t>(audio_config::kTelemetryFieldCount);
+
+    // Copy every registered peer's telemetry, as the mixer last published it
+    // (at most kTelemetryPublishTicks old while the room is live), into `out`:
+    // up to `maxRecords` records of kTelemetryRecordInts. Returns the number
+    // written. Lock-free and allocation-free; never blocks the mixer. A peer
+    // the mixer hasn't published yet is absent.
+    size_t snapshotTelemetry(int32_t* out, size_t maxRecords) const;
+
+    // The wire layout shared by the board, Kotlin and Dart — fields in this
+    // order: underrunCount, lateFrameCount, jitterTargetDepth,
+    // jitterCurrentDepth, currentBitrate, lostFrameCount, currentLagMs,
+    // staleDropCount, recvCount, lastSeq, ringUnderReadCount,
+    // ringOverwriteCount, clockDriftPpm, tickLateP99Us, tickWorkP99Us,
+    // tickOverrunCount, arrivalDropCount, outboundStaleDropCount,
+    // outboundFullDropCount, outboundDepth, outboundSkipCount,
+    // bitrateBackoffCount, expectedLossPct, outboundFramesPerPacket,
+    // encoderComplexity, governorLevel. Appended to, never reordered.
+    static void marshalTelemetry(const LinkTelemetry& t, int32_t* out);
 
     // Returns true if the most recent decoded audio from this peer crossed the
     // VAD threshold (i.e., the peer is currently detected as talking).
@@ -112,30 +229,130 @@ public:
     // Thread-safe: acquires the per-peer mutex internally.
     bool isPeerTalking(const std::string& macAddress);
 
+    // Every talking peer at once, as the mixer tick last published it: bit
+    // (handle % kPeerHandleSlots) is set while that peer's VAD reads talking.
+    // This is the word the notifier hands Kotlin. Lock-free.
+    uint32_t talkingMask() const { return talkingState_.mask(); }
+
+    // The peer's latest decoded RMS level in int16 sample units (what its
+    // VAD compared against the threshold), or 0 if it isn't registered.
+    // Lock-free.
+    int peerLevel(int handle) const;
+
+    // Returns true while this peer is dormant: its PLC tail has faded out
+    // and the mixer tick skips it (no decode, VAD or ring writes) until
+    // frames arrive. False if the peer is not registered. For tests and
+    // diagnostics. Thread-safe: acquires the per-peer mutex internally.
+    bool isPeerDormant(const std::string& macAddress);
+
+    // Frames this peer has crossfade-merged away to shed an announced
+    // pre-roll burst (audio_config::kPreRollCatchUpIntervalTicks), or 0 if it
+    // isn't registered. For tests and diagnostics. Thread-safe: acquires the
+    // per-peer mutex.
+    uint64_t catchUpMergeCount(int handle);
+
+    // Decode-on-arrival mode (default audio_config::kDecodeOnArrival). When
+    // on, onVoiceFramePushed() Opus-decodes each in-order frame on the
+    // calling receive thread and parks the PCM in the jitter buffer, so the
+    // mixer tick's per-peer critical section shrinks to picking up ready PCM.
+    // Loss handling (FEC, PLC, the popAny escalation) stays on the tick at
+    // playout time. The price is the per-peer lock on the receive path: to
+    // decode, the receive thread drains its own arrival queue under
+    // `PeerState::mutex` rather than leaving that to the tick. Safe to flip
+    // at any time: frames already decoded ahead play out either way.
+    void setDecodeOnArrival(bool enabled) {
+        decodeOnArrival_.store(enabled, std::memory_order_relaxed);
+    }
+    bool decodeOnArrival() const {
+        return decodeOnArrival_.load(std::memory_order_relaxed);
+    }
+
+    // Silence suppression (default audio_config::kSilenceSuppression): gate
+    // each peer's outbound stream on its own mix-minus, with Opus DTX in the
+    // hangover, and announce each pause so the peer fills it with comfort
+    // noise. Off, a peer is sent every frame while anyone in the room talks.
+    // Takes effect on the next tick.
+    void setSilenceSuppression(bool enabled) {
+        silenceSuppression_.store(enabled, std::memory_order_relaxed);
+    }
+    bool silenceSuppression() const {
+        return silenceSuppression_.load(std::memory_order_relaxed);
+    }
+
+    // Low-latency profile (default audio_config::kLowLatencyProfile): ask
+    // for 10 ms frames and a 10 ms tick. Offered to every peer in-band; the
+    // tick only switches once every peer has offered it too, and switches
+    // back as soon as one hasn't. Takes effect on the next tick.
+    void setLowLatencyProfile(bool enabled) {
+        lowLatencyProfile_.store(enabled, std::memory_order_relaxed);
+    }
+    bool lowLatencyProfile() const {
+        return lowLatencyProfile_.load(std::memory_order_relaxed);
+    }
+    // Push-to-talk pre-roll (default audio_config::kPreRoll): when a
+    // talkspurt opens on keyed local voice, send the moments of mic audio
+    // before it ahead of the live frame (pre_roll_ring.h). Takes effect on
+    // the next tick.
+    void setPreRoll(bool enabled) {
+        preRoll_.store(enabled, std::memory_order_relaxed);
+    }
+    bool preRoll() const {
+        return preRoll_.load(std::memory_order_relaxed);
+    }
+
+    // The frame duration the tick is running on: kFrameDurationMs, or
+    // kLowLatencyFrameDurationMs while the room has agreed to the profile.
+    int frameDurationMs() const {
+        return frameMs_.load(std::memory_order_relaxed);
+    }
+
+    // The outbound ring the mixer encodes `handle`'s frames into, for its
+    // L2CAP writer thread to drain (outbound_frame_ring.h). Null for a
+    // retired handle. The ring outlives the peer for as long as a writer
+    // holds it; unregistering the peer closes it.
+    std::shared_ptr<OutboundFrameRing> outboundRing(int handle);
+
     // Start / stop the mixer tick thread. The thread runs decode →
-    // updateDeviceAudio → mix-minus → encode → JNI callback once every
-    // audio_config::kFrameDurationMs ms.
+    // updateDeviceAudio → mix-minus → encode into the outbound rings once every
+    // frameDurationMs() ms — except in an idle room, where it
+    // stops sending and then parks (see audio_config::kIdleParkAfterTicks).
+    // The talking-set notifier thread starts and stops with it.
     bool startMixerThread();
     void stopMixerThread();
 
-    // Set JNI callback object for sending audio (Java-side
-    // PeerAudioManager.onMixedAudioReady).
+    // Record local mic activity (energy over the VAD threshold). Keeps the
+    // mixer tick out of its idle states and wakes it if parked. Called from
+    // the audio engine's talking-event worker — never from the audio
+    // callback itself, since waking may take a mutex.
+    void noteLocalActivity();
+
+    // True while the mixer tick thread is parked on an idle room. For tests
+    // and diagnostics.
+    bool isMixerParked() const {
+        return mixerParked_.load(std::memory_order_acquire);
+    }
+
+    // Set the JNI callback object for talking-set updates (Java-side
+    // PeerAudioManager.onTalkingMaskChanged). Resolves the method ID here,
+    // once, rather than per event, and has the notifier re-send the current
+    // mask to the new callback.
     void setCallback(JNIEnv* env, jobject callback);
 
     // Clear all peers. Stops the mixer thread first. Idempotent.
     void clear();
 
 private:
-    // Per-peer state. `mutex` serializes access from the BLE receive thread
-    // (push side via `onVoiceFramePushed`) and the mixer thread (pop/decode
-    // and encode sides) — neither `JitterBuffer` nor the Opus codec wrappers
-    // are internally thread-safe, so all access to those three fields must
-    // happen with `mutex` held.
+    // Per-peer state. The BLE receive thread only touches `arrivals` (see
+    // arrival_queue.h). `mutex` serializes the mixer thread (drain, decode
+    // and encode) against the control and telemetry calls, and against a
+    // receive thread in decode-on-arrival mode — neither `JitterBuffer` nor
+    // the Opus codec wrappers are internally thread-safe, so all access to
+    // those three fields must happen with `mutex` held.
     //
-    // `bitrate` is `std::atomic<int>` so a JNI caller can publish a hint
-    // without contending the mixer-tick lock. The applied bitrate value
-    // also passes through `OpusEncoder::setBitrate`, which is itself called
-    // under `mutex`.
+    // `bitrate` and `bitrateCeiling` are `std::atomic<int>` so telemetry and
+    // a JNI caller's hint don't contend the mixer-tick lock. The applied
+    // bitrate value also passes through `OpusEncoder::setBitrate`, which is
+    // itself called under `mutex`.
     //
     // `consecutiveUnderruns` is touched only on the mixer thread.
     struct PeerState {
@@ -144,11 +361,39 @@ private:
         std::unique_ptr<OpusEncoder> encoder;
         std::unique_ptr<OpusDecoder> decoder;
         std::unique_ptr<JitterBuffer> jitterBuffer;
+        // Frames in from this peer, waiting for the mixer tick. Pushed
+        // lock-free; drained under `mutex`.
+        ArrivalQueue arrivals;
+        // Encoded frames out to this peer. A shared_ptr of its own so the
+        // writer thread's reference survives unregistration. The mixer
+        // thread is its only producer.
+        std::shared_ptr<OutboundFrameRing> outbound{
+            std::make_shared<OutboundFrameRing>()};
         std::atomic<int> bitrate{audio_config::kDefaultBitrate};
+        std::atomic<int> bitrateCeiling{audio_config::kBitrateHigh};
         // Two consecutive PLC frames sound increasingly mechanical; we use
-        // this to bias toward popAny() on the third underrun in a row.
+        // this to bias toward popAny() on the third underrun in a row. It is
+        // also the position in the PLC tail (audio_config::kPlcTailFrames).
         int consecutiveUnderruns{0};
-            // Per-peer VAD. Guarded by `mutex` so reads from isPeerTalking() are
+        // Set once the PLC tail has faded out: the peer costs nothing per
+        // tick until its jitter buffer holds frames again. While frames are
+        // queued but short of the target depth, `dormantHeldTicks` counts
+        // the ticks we've waited for the rest of the talkspurt's lead-in.
+        // Both under `mutex` (isPeerDormant() reads from other threads).
+        bool plcDormant{false};
+        size_t dormantHeldTicks{0};
+        // Decoder cursor: the seq the Opus decoder's state has advanced to
+        // (one past the last frame it decoded or concealed). Decode-ahead
+        // only ever decodes the frame at this seq, so the decoder can run
+        // ahead of the playhead over a contiguous run of queued frames and
+        // never across a hole. Invalid until the first playout decode, and
+        // again after any jitter-buffer reset. Under `mutex`.
+        uint32_t decodeSeq{0};
+        bool decodeSeqValid{false};
+        // Decode-ahead output scratch (kCodecMaxFrameSize), allocated on
+        // first use so the mode costs nothing when off. Under `mutex`.
+        std::vector<int16_t> arrivalPcm;
+        // Per-peer VAD. Guarded by `mutex` so reads from isPeerTalking() are
         // race-free even when the mixer thread is running.
         VadDetector peerVad{audio_config::kCodecSampleRate};
         // End-to-end staleness (Kevin's timestamp-drop). Fed on the receive
@@ -163,54 +408,313 @@ private:
         // jitter buffer). On the next accepted frame we resync the playhead so
         // the shed gap isn't miscounted as a hole-at-head loss.
         bool sheddingStale{false};
-        // State for the periodic setExpectedLossPct updates. Touched only on
-        // the mixer thread (always inside stateLock).
-        uint64_t lossPctPrevLost{0};
-        uint64_t lossPctPrevRecv{0};
-        int lossPctTickCounter{0};
+        // Clock-drift correction. The estimator is fed alongside lagEstimator
+        // on the receive path; the resampler sits between this peer's decoder
+        // and the mixer ring on the mixer thread. Both under `mutex`.
+        ClockDriftEstimator driftEstimator;
+        VariableRatioResampler driftResampler;
+        // Bitrate and expected-loss control (bitrate_controller.h), run
+        // every kBitrateControlTicks. Mixer thread only, inside stateLock;
+        // `expectedLossPct` and `bitrateBackoffCount` are read for telemetry
+        // under `mutex`.
+        BitrateController bitrateController;
+        int bitrateControlTicks{0};
+        int expectedLossPct{-1};
+        // Outbound packetization (voice_bundle.h). `peerBundleFrames` is the
+        // largest bundle the peer has offered to unpack (set by the receive
+        // thread); `framesPerPacket` the controller's current choice (read
+        // for telemetry). The offer countdown and the frames waiting to be
+        // bundled are mixer thread only.
+        std::atomic<int> peerBundleFrames{1};
+        std::atomic<int> framesPerPacket{1};
+        int bundleOfferTicks{0};
+        BundleAccumulator pendingBundle;
+        // Set by registerPeer when the peer reconnects, for the mixer
+        // thread to drop its own per-link state before the next encode.
+        std::atomic<bool> linkRenewed{false};
+        // Compact headers (voice_header.h): whether the peer has offered to
+        // decode them (receive thread sets it), and the mixer thread's
+        // per-frame choice.
+        std::atomic<bool> peerCompactHeaders{false};
+        CompactHeaderEncoder headerEncoder;
+        // The frame duration the peer last asked for (low-latency profile),
+        // from the receive thread. kFrameDurationMs until it offers. Whether
+        // our last offer asked it for 10 ms frames: mixer thread only.
+        std::atomic<int> peerFrameMs{audio_config::kFrameDurationMs};
+        bool askedLowLatency{false};
+        // The most pre-roll frames the peer has said its talkspurts open
+        // with (receive thread; 0 until it offers), and whether our last
+        // offer said we send them (mixer thread only).
+        std::atomic<int> peerPreRollFrames{0};
+        bool offeredPreRoll{false};
+        // Outbound backpressure (audio_config::kOutboundCongestedFrames):
+        // true while the tick is skipping this peer's encodes, and how many
+        // queued packets of a pre-roll burst the gate still leaves out of
+        // its count: those sendPreRoll() queued, one fewer each tick and
+        // never more than are queued. Mixer thread only.
+        bool outboundCongested{false};
+        size_t preRollAllowance{0};
+        // What the tick governor last applied (tick_governor.h). Mixer
+        // thread only, but for `encoderComplexity`, read for telemetry; FEC
+        // is also off while `outboundCongested`.
+        std::atomic<int> encoderComplexity{audio_config::kGovernorComplexity[0]};
+        bool encoderFec{true};
+        int rmsStride{1};
+        // Talking, or losing more than kGovernorWeakLinkLossPct, as of this
+        // tick's decode pass, which reads both under `mutex`. Mixer thread
+        // only.
+        bool talkingOrWeak{false};
+        // Silence suppression, outbound (mixer thread only): quiet frames in
+        // this peer's mix since the last loud one, whether a talkspurt is
+        // on the air (so its end gets announced), and the DTX setting the
+        // encoder has.
+        int outboundQuietTicks{0};
+        bool talkspurtOpen{false};
+        bool encoderDtx{false};
+        // Silence suppression, inbound: the peer's talkspurt-end frame, from
+        // the receive thread — `talkspurtEndSeq` is published by the release
+        // store to `talkspurtEnded` — for the tick to hand the jitter buffer.
+        // The comfort noise that fills the pause is under `mutex`.
+        std::atomic<uint32_t> talkspurtEndSeq{0};
+        std::atomic<bool> talkspurtEnded{false};
+        ComfortNoise comfortNoise;
+        // The last packet played was known silence (opus_silence.h), not
+        // decoded. Mixer thread, under `mutex`.
+        bool silentRun{false};
+        // Samples in the peer's last decoded frame: the length PLC, FEC and
+        // comfort noise stand in for, 10 ms or 20 ms (opus_toc.h). Mixer
+        // thread, under `mutex`.
+        int frameSamples{audio_config::kCodecFrameSize};
+        // Pre-roll catch-up (audio_config::kPreRollCatchUpIntervalTicks):
+        // whether the next voice to reach the jitter buffer opens a
+        // talkspurt (the link's first, or the first after an announced
+        // pause), the frames still to shed from the burst it opened with,
+        // the ticks until the next merge, whether that merge is due, and the
+        // merges so far. Under `mutex`.
+        bool talkspurtPending{true};
+        int catchUpFrames{0};
+        int catchUpWaitTicks{0};
+        bool catchUpMergeDue{false};
+        uint64_t catchUpMerges{0};
     };
 
+    // A new peer's state with its codec pair, jitter buffer and outbound
+    // ring, but no identity yet. Allocates, so it runs outside
+    // peerRegistryMutex_ except as the fallback when the pool is empty.
+    static std::shared_ptr<PeerState> buildPeerState();
+
+    // Top the warm pool up to audio_config::kPeerWarmSpares, building each
+    // spare outside peerRegistryMutex_. Caller doesn't hold it.
+    void refillWarmSpares();
+
+    // What a peer's last link learned, kept across a reconnect (see
+    // audio_config::kWarmStartCacheEntries).
+    struct WarmStartProfile {
+        JitterBuffer::AdaptState jitter;
+        bool hasLagBaseline{false};
+        int32_t lagBaselineRawDelay{0};
+        int64_t savedAtMs{0};
+    };
+
+    // Save `state`'s learned link profile under `macAddress`, evicting the
+    // oldest entry past the cache size. Skips a link that never played a
+    // frame. Caller holds peerRegistryMutex_ and `state.mutex` (or owns
+    // `state` exclusively).
+    void saveWarmStart(const std::string& macAddress, PeerState& state);
+
+    // Seed a freshly reset `state` from the cached profile for `macAddress`,
+    // if there is a fresh one, and consume the entry. Same locking as
+    // saveWarmStart().
+    void applyWarmStart(const std::string& macAddress, PeerState& state);
+
+    // Resolve a peer by MAC (under peerRegistryMutex_) or by handle
+    // (lock-free). nullptr if not registered.
+    std::shared_ptr<PeerState> findPeer(const std::string& macAddress);
+    std::shared_ptr<PeerState> findPeer(int handle) const;
+
+    static size_t slotFor(int handle) {
+        return static_cast<size_t>(handle) & (audio_config::kPeerHandleSlots - 1);
+    }
+
+    // Bodies shared by the MAC and handle overloads.
+    bool pushFrame(PeerState& state, uint32_t seq, uint32_t senderTsMs,
+                   const uint8_t* opusData, int opusSize);
+    size_t lockedDrain(PeerState& state);
+
+    // Move everything in `state.arrivals` into the jitter buffer: feed the
+    // lag and drift estimators, shed stale frames, push the rest (and
+    // decode ahead, in decode-on-arrival mode). Returns the frames the
+    // jitter buffer accepted. Caller holds `state.mutex`.
+    size_t ingestArrivals(PeerState& state);
+    int applyBitrate(PeerState& state, int bps);
+    // One BitrateController interval: sample the link, apply its bitrate and
+    // expected-loss decisions to the encoder. `frameMs` is the frame the
+    // tick runs on. Mixer thread; caller holds `state.mutex`.
+    void controlBitrate(PeerState& state, const OutboundFrameRing& ring, int frameMs);
+    // Send whatever `state.pendingBundle` holds as one VoiceFrame. Mixer
+    // thread.
+    void flushBundle(PeerState& state, OutboundFrameRing& ring, int64_t nowMs);
+    // Commit one voice VoiceFrame to `ring`, with a compact header when the
+    // peer decodes them and the receiver can extend it. Mixer thread.
+    void commitVoice(PeerState& state, OutboundFrameRing& ring, uint32_t seq,
+                     uint32_t senderTsMs, size_t payloadLen, int64_t nowMs);
+    // Bring `state`'s encoder and RMS work in line with the tick governor's
+    // `level` (TickGovernor::planFor). Mixer thread; takes `state.mutex`
+    // only when something changes.
+    void applyGovernorPlan(PeerState& state, int level);
+    // Encode the local pre-roll that ends `skipNewest` samples before the
+    // newest captured into `state`'s stream, ahead of the talkspurt's live
+    // frame: as many `frameSize` frames (up to kPreRollFrames) as the peer's
+    // bundles take in the packets the writer's queue has room for, stamped
+    // with their capture times, which the congestion gate then allows for. `pcm` is scratch for kPreRollFrames default
+    // frames. Mixer thread; takes `state.mutex`.
+    void sendPreRoll(PeerState& state, OutboundFrameRing& ring, const PreRollRing& history,
+                     size_t skipNewest, int frameSize, int frameMs, uint32_t& seq,
+                     int64_t nowMs, int16_t* pcm);
+    // Announce the end of the talkspurt on the air, if one is, with a
+    // kLinkControlTalkspurtEnd frame naming `nextSeq`. Mixer thread.
+    void endTalkspurt(PeerState& state, OutboundFrameRing& ring, uint32_t nextSeq,
+                      int64_t nowMs);
+    LinkTelemetry telemetryFor(PeerState& state);
+    // The two halves of a telemetry snapshot: the counters guarded by
+    // `state.mutex` (caller holds it), and the atomics and mixer-wide
+    // figures (no lock needed). Fill `t` in place.
+    void collectLockedTelemetry(PeerState& state, LinkTelemetry& t);
+    void collectSharedTelemetry(PeerState& state, LinkTelemetry& t);
+
     void mixerTickLoop();
 
-    // Send a freshly-encoded mix-minus frame to a peer via the JNI callback.
-    // `env` must be valid for the calling (mixer) thread — see mixerTickLoop
-    // for the once-per-thread Attach.
-    void sendAudioToPeer(JNIEnv* env, const std::string& macAddress,
-                         const uint8_t* opusData, int opusSize, uint32_t seq);
+    // Idle park: reset every peer's jitter buffer to cold start (so the next
+    // talkspurt primes afresh instead of reading the silence as one long
+    // underrun) and block until wakeMixer() reports work or the thread is
+    // stopped. Mixer thread only.
+    void parkMixer();
+
+    // Wake a parked mixer tick. Cheap when not parked (one atomic load), so
+    // the receive path can call it on every frame.
+    void wakeMixer();
+
+    // Decode-on-arrival: decode queued frames from the front of `state`'s
+    // jitter buffer for as long as each is the decoder cursor's seq, and
+    // attach the PCM to the frame. Stops at the first hole. No-op until the
+    // stream is primed, and while dormant (the resume path resets the
+    // decoder first). From ingestArrivals(); caller holds `state.mutex`.
+    void decodeAhead(PeerState& state);
 
-    // Emit a talkingPeers event with the current set of active peer MACs.
-    // Called on the mixer thread when any peer's VAD state changes.
-    void sendTalkingPeersEvent(JNIEnv* env,
-                               const std::vector<std::string>& talkingMacs);
+    // Play out `frame` into `pcm`: copy its decoded-ahead PCM if present,
+    // comfort noise if it's known silence (`state.silentRun`), otherwise
+    // decode it now. Advances the decoder cursor either way. Returns the
+    // sample count (< 0 on decoder error, 0 for silence once the noise has
+    // faded). Caller holds `state.mutex`.
+    int playFrame(PeerState& state, const JitterBuffer::Frame& frame,
+                  int16_t* pcm);
+
+    // Produce one decoded frame for `state` into `pcm` (capacity
+    // kCodecMaxFrameSize): jitter-buffer pop with the high-watermark drain
+    // and pre-roll catch-up merge, popAny escalation, inband FEC, or PLC — then per-peer VAD and level.
+    // `scratch` is the drain's second decode buffer. Returns the sample count
+    // (<= 0 on decoder error, 0 while the peer is dormant after its PLC
+    // tail or its pause's comfort noise). Mixer thread only; caller holds
+    // `state.mutex`.
+    int decodeNextFrame(PeerState& state, int16_t* pcm, int16_t* scratch);
+
+    // One frame of comfort noise while `state` is in an announced pause, or
+    // 0. Caller holds `state.mutex`.
+    int pauseNoise(PeerState& state, int16_t* pcm);
+
+    // Body of the talking-set notifier thread: waits on talkingState_ and
+    // calls PeerAudioManager.onTalkingMaskChanged(int) with each new mask.
+    // Runs alongside the mixer thread, at ordinary priority; owns all the
+    // JNI the talking indicator needs.
+    void talkNotifierLoop();
 
     std::mutex peerRegistryMutex_;
     std::map<std::string, std::shared_ptr<PeerState>> peers_;
     std::map<int, std::string> deviceIdToMac_;
-    int nextDeviceId_{1};  // 0 reserved for local mic.
+    // The next handle to try. Process-wide, so handles never go backwards:
+    // not across clear(), nor across the manager nativeClear tears down and
+    // the next nativeInit replaces. 0 is reserved for the local mic.
+    static inline std::atomic<int> nextDeviceId_{1};
+    // Handle → peer, at slotFor(deviceId). Written with std::atomic_store
+    // under peerRegistryMutex_; read with std::atomic_load and no lock.
+    std::array<std::shared_ptr<PeerState>, audio_config::kPeerHandleSlots>
+        slots_;
+    // Warm-start profiles by MAC. Under peerRegistryMutex_.
+    std::map<std::string, WarmStartProfile> warmStart_;
+    // Spare states for the next joins (see refillWarmSpares()). Under
+    // peerRegistryMutex_; capacity reserved up front, so neither a join's
+    // pop nor a refill's push reallocates under it.
+    std::vector<std::shared_ptr<PeerState>> warmSpares_;
 
-    // Set to true by unregisterPeer() so the next mixer tick emits an updated
-    // talkingPeers set even if no VAD edge fires on a surviving peer.
+    // Set by registerPeer()/unregisterPeer() so a parked mixer wakes and
+    // republishes the talking set without the departed (or reset) peer.
     std::atomic<bool> talkingPeersDirty_{false};
 
+    // Talking bitmask and levels: published by the mixer tick, delivered to
+    // Kotlin by talkNotifierThread_ (see talking_state.h).
+    TalkingState talkingState_;
+    std::thread talkNotifierThread_;
+
+    std::atomic<bool> decodeOnArrival_{audio_config::kDecodeOnArrival};
+    std::atomic<bool> silenceSuppression_{audio_config::kSilenceSuppression};
+    std::atomic<bool> lowLatencyProfile_{audio_config::kLowLatencyProfile};
+    std::atomic<bool> preRoll_{audio_config::kPreRoll};
+    // The room's frame duration, decided by the mixer tick each tick;
+    // readable from any thread.
+    std::atomic<int> frameMs_{audio_config::kFrameDurationMs};
+
     std::thread mixerThread_;
     std::atomic<bool> mixerRunning_{false};
 
+    // Idle-park handshake. The wakers (receive path, registry changes, local
+    // activity, stop) set their flag *then* check `mixerParked_`; the mixer
+    // sets `mixerParked_` *then* checks the flags in its wait predicate. Both
+    // sides are seq_cst, so at least one of them sees the other — a wake
+    // can't slip between the last idle check and the wait.
+    std::atomic<bool> frameArrived_{false};
+    std::atomic<bool> localActivity_{false};
+    std::atomic<bool> mixerParked_{false};
+    std::mutex parkMutex_;
+    std::condition_variable parkCv_;
+
+    // Tick-jitter instrumentation. Written by the mixer thread only; read
+    // lock-free by getTelemetry().
+    TickHistogram tickLateness_;
+    TickHistogram tickWork_;
+    std::atomic<uint32_t> tickOverrunCount_{0};
+    // Steps encoder complexity, FEC and RMS work to the tick's CPU budget.
+    // Mixer thread; its level is read lock-free for telemetry.
+    TickGovernor tickGovernor_;
+
+    // Per-peer telemetry, indexed by slotFor(handle). Written by the mixer
+    // thread only; read lock-free by snapshotTelemetry().
+    TelemetryBoard telemetryBoard_;
+
     // jvm_ is published lazily by setCallback() (which captures it from
-    // the calling JNIEnv) and read by mixerTickLoop's lazy-attach path on
-    // every tick. std::atomic with release/acquire prevents the C++ data
-    // race that a plain pointer would create between the publishing thread
-    // and the polling mixer thread.
+    // the calling JNIEnv) and read by talkNotifierLoop's lazy-attach path.
+    // std::atomic with release/acquire prevents the C++ data race that a
+    // plain pointer would create between the publishing thread and the
+    // notifier thread.
     std::atomic<JavaVM*> jvm_{nullptr};
 
-    // Guards `callbackObject_` against the race between the JNI thread's
-    // `setCallback` (which deletes + replaces the global ref) and the
-    // mixer thread's `sendAudioToPeer` (which reads and uses the global
-    // ref). The lock is held only across the snapshot — JNI calls happen
-    // on the snapshotted local reference outside the lock.
+    // Guards `callbackObject_` and the JNI handles resolved with it against
+    // the race between the JNI thread's `setCallback` (which deletes +
+    // replaces the global ref) and the notifier thread's
+    // `talkNotifierLoop` (which reads and uses them). The lock is held only
+    // across the snapshot — JNI calls happen on the snapshotted local
+    // reference outside the lock.
     std::mutex callbackMutex_;
     jobject callbackObject_{nullptr};
+    jmethodID talkingMaskMethod_{nullptr};
 };
 
-extern PeerAudioManager* g_peerAudioManager;
+// Published with std::atomic_store by nativeInit / nativeClear (which
+// serialize on a mutex); every other entry point takes a reference with
+// std::atomic_load, so teardown can't free the manager under a caller.
+extern std::shared_ptr<PeerAudioManager> g_peerAudioManager;
+
+// Forward local mic activity from the audio engine to the live
+// PeerAudioManager, if any. Safe from any non-real-time thread.
+void peerAudioManagerNoteLocalActivity();
 
 #endif  // PEER_AUDIO_MANAGER_H
@@ -22,9 +22,12 @@
 //     platform speaker loudness/protection processing — the loudspeaker was
 //     near-silent on the Pixel while a non-MMAP device (moto) was loud.
 //     PerformanceMode::None + SharingMode::Shared keep playout on the normal
-//     mixer path so the speaker DSP applies. Output is write()-driven from the
-//     input callback, so dropping LowLatency does not change callback burst
-//     sizing.
+//     mixer path so the speaker DSP applies.
+//
+// The output stream's data callback drives the engine (it reads the mic
+// too), and its buffer is held at kPlaybackBufferBursts bursts: one playing,
+// one being filled — the least that doesn't underrun on every scheduling
+// hiccup, and so the output latency.
 
 #include <oboe/Definitions.h>
 
@@ -37,5 +40,6 @@ inline constexpr oboe::PerformanceMode kPlaybackPerformanceMode =
     oboe::PerformanceMode::None;
 inline constexpr oboe::SharingMode kPlaybackSharingMode =
     oboe::SharingMode::Shared;
+inline constexpr int kPlaybackBufferBursts = 2;
 
 }  // namespace audio_engine_config
@@ -51,6 +51,19 @@ public:
         const int32_t rawDelay = static_cast<int32_t>(
             static_cast<uint32_t>(recvMs) - senderTsMs);
 
+        // Warm start: adopt the seeded baseline as if it had just been
+        // observed — but only if this first frame is plausibly on the same
+        // clock epoch (see kWarmStartLagToleranceMs). A seed above rawDelay is
+        // simply dominated below.
+        if (seedPending_) {
+            seedPending_ = false;
+            const int64_t diff = static_cast<int64_t>(rawDelay) - seedRawDelay_;
+            if (diff >= -audio_config::kWarmStartLagToleranceMs &&
+                diff <= audio_config::kWarmStartLagToleranceMs) {
+                window_.push_back({recvMs, seedRawDelay_});
+            }
+        }
+
         // Monotonic-min deque: keep delays increasing front->back so the front
         // is always the window minimum. Drop larger trailing entries the new
         // sample dominates.
@@ -70,6 +83,18 @@ public:
         return lastExcessMs_;
     }
 
+    // The current baseline (window-minimum raw delay), for warm-starting a
+    // later link from the same sender. Meaningless while !hasBaseline().
+    bool hasBaseline() const { return !window_.empty(); }
+    int32_t baselineRawDelay() const { return baselineRawDelay_; }
+
+    // Offer a baseline learned on a previous link from the same sender. It is
+    // checked against, and then windowed alongside, the next feed().
+    void seedBaseline(int32_t rawDelay) {
+        seedRawDelay_ = rawDelay;
+        seedPending_ = true;
+    }
+
     // Staleness of the most recent feed(), in ms (>= 0).
     int64_t lastExcessMs() const { return lastExcessMs_; }
 
@@ -84,6 +109,7 @@ public:
         window_.clear();
         baselineRawDelay_ = 0;
         lastExcessMs_ = 0;
+        seedPending_ = false;
     }
 
 private:
@@ -94,6 +120,8 @@ private:
     std::deque<Sample> window_;
     int32_t baselineRawDelay_{0};
     int64_t lastExcessMs_{0};
+    bool seedPending_{false};
+    int32_t seedRawDelay_{0};
 };
 
 #endif  // PLAYOUT_LAG_ESTIMATOR_H
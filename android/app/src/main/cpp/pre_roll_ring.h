@@ -0,0 +1,80 @@
+#ifndef PRE_ROLL_RING_H
+#define PRE_ROLL_RING_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "audio_config.h"
+
+// The last few hundred milliseconds of local mic audio at the codec rate,
+// captured whether or not the mic is muted, for the push-to-talk pre-roll
+// (audio_config::kPreRoll).
+//
+// **Why.** A talkspurt's first syllable used to be lost: the outbound gate
+// only opens on the first loud frame, a muted PTT mic is zeros until the key
+// goes down, and a parked mixer tick needs a wake before it mixes anything.
+// The audio from just before all of that is here, so the tick can send it
+// ahead of the live stream when a talkspurt opens.
+//
+// **Protocol.** The audio callback write()s every capture burst, with
+// whether the mic was keyed (unmuted) at the time; it never waits and never
+// fails — the oldest samples are simply overwritten. The mixer tick
+// copyBefore()s the newest history, minus what the mixer's own mic ring
+// still holds for the live stream.
+//
+// **Threading.** One producer, one consumer, lock-free. A copy that the
+// producer overtakes mid-read (it would have to write a whole ring's worth,
+// ~340 ms, during the copy) is detected, seqlock-style, and reported as
+// nothing rather than returned torn. The samples are relaxed atomics so the
+// overlap is a detected race, not undefined behaviour.
+class PreRollRing {
+public:
+    static constexpr size_t kCapacity = audio_config::kPreRollRingSamples;
+    static_assert((kCapacity & (kCapacity - 1)) == 0,
+                  "kCapacity must be a power of two so we can use a mask");
+
+    // ---- Producer (audio callback) ----
+
+    void write(const int16_t* samples, size_t n, bool keyed) {
+        const uint64_t w = written_.load(std::memory_order_relaxed);
+        // Announce the overwrite before doing it, so a reader that started
+        // before it can tell.
+        writing_.store(w + n, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        for (size_t i = 0; i < n; ++i) {
+            samples_[(w + i) & (kCapacity - 1)].store(samples[i], std::memory_order_relaxed);
+        }
+        keyed_.store(keyed, std::memory_order_relaxed);
+        written_.store(w + n, std::memory_order_release);
+    }
+
+    // ---- Consumer (mixer tick) ----
+
+    // Whether the mic was keyed at the last write.
+    bool keyed() const { return keyed_.load(std::memory_order_relaxed); }
+
+    // Copy the `n` samples that end `skipNewest` samples before the newest
+    // into `out`. Returns `n`, or 0 when the history doesn't reach that far
+    // back (yet) or the producer overwrote it during the copy.
+    size_t copyBefore(int16_t* out, size_t n, size_t skipNewest) const {
+        const uint64_t w = written_.load(std::memory_order_acquire);
+        if (n == 0 || n + skipNewest > kCapacity || w < n + skipNewest) return 0;
+        const uint64_t start = w - skipNewest - n;
+        for (size_t i = 0; i < n; ++i) {
+            out[i] = samples_[(start + i) & (kCapacity - 1)].load(std::memory_order_relaxed);
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        // Anything written from start + kCapacity on landed on our samples.
+        if (writing_.load(std::memory_order_relaxed) > start + kCapacity) return 0;
+        return n;
+    }
+
+private:
+    std::atomic<int16_t> samples_[kCapacity]{};
+    std::atomic<uint64_t> written_{0};  // samples ever written
+    std::atomic<uint64_t> writing_{0};  // written_ once the current write lands
+    std::atomic<bool> keyed_{true};
+};
+
+#endif  // PRE_ROLL_RING_H
@@ -216,4 +216,123 @@ private:
     int historyIdx_ = 0;
 };
 
+// Fine-grained variable-ratio resampler for clock-drift correction at the
+// codec rate. Unlike the fixed 2:1 classes above, this one converts by a ratio
+// a few hundred ppm either side of 1.0 that changes slowly at run time (see
+// ClockDriftEstimator): it lets the decode path consume a peer's PCM at the
+// *sender's* clock rate while emitting exactly one 20 ms frame per mixer tick
+// on ours.
+//
+// **Pull model.** The caller `write()`s decoded PCM into an internal
+// reservoir, asks `inputNeeded(n)` how much more it must supply before `n`
+// outputs can be produced, and `read()`s the outputs. When the sender runs
+// fast the reservoir slowly drains and, every few thousand ticks, the caller
+// has to pull a second frame in one tick; when it runs slow the reservoir
+// slowly fills and the caller skips a pull. Either way the peer's jitter
+// buffer is drained at the rate it is filled, and the correction is a sub-
+// sample phase slide rather than a dropped or repeated frame.
+//
+// **Interpolation.** 4-point cubic Hermite. At ratios this close to unity
+// the interpolant moves by a fraction of a sample per second, so it is
+// transparent for speech; a step of exactly 1.0 reproduces the input
+// bit-for-bit. The reservoir starts primed with the interpolator's two
+// lookahead samples (zeros), so at unity ratio each written frame yields
+// exactly one frame out — the two-sample (83 µs) delay is the whole cost.
+//
+// **Real-time safety.** Fixed-size storage, no heap after construction, no
+// locks. Not thread-safe; owned by one peer and used under its mutex.
+class VariableRatioResampler {
+public:
+    // Reservoir capacity in samples: two worst-case Opus frames plus the
+    // interpolator's history, so a double pull never has to drop input.
+    static constexpr int kCapacity = 2 * audio_config::kCodecMaxFrameSize + 4;
+
+    VariableRatioResampler() { reset(); }
+
+    // Input samples consumed per output sample. > 1 compresses (sender fast),
+    // < 1 stretches (sender slow).
+    void setStep(double step) { step_ = step; }
+    double step() const { return step_; }
+
+    // Append `numIn` input samples. Returns how many fit; the remainder is
+    // dropped (only possible if the caller ignores inputNeeded()).
+    int write(const int16_t* in, int numIn) {
+        compact();
+        const int n = std::min(numIn, kCapacity - len_);
+        for (int i = 0; i < n; ++i) {
+            buf_[len_ + i] = static_cast<float>(in[i]);
+        }
+        len_ += std::max(n, 0);
+        return std::max(n, 0);
+    }
+
+    // How many more input samples must be written before `numOut` outputs can
+    // be read. <= 0 means there is already enough (the magnitude is the
+    // surplus).
+    int inputNeeded(int numOut) const {
+        if (numOut <= 0) return 0;
+        const double last = pos_ + static_cast<double>(numOut - 1) * step_;
+        // The interpolator reads up to floor(last) + 2.
+        return static_cast<int>(std::floor(last)) + 3 - len_;
+    }
+
+    // Input samples buffered past the read position (rounded down).
+    int buffered() const {
+        return std::max(0, len_ - static_cast<int>(std::floor(pos_)) - 2);
+    }
+
+    // Produce up to `numOut` samples into `out`. Returns the count produced,
+    // which is less than `numOut` only if the reservoir ran dry.
+    int read(int16_t* out, int numOut) {
+        int produced = 0;
+        while (produced < numOut) {
+            const int i = static_cast<int>(std::floor(pos_));
+            if (i + 2 >= len_) break;
+            const float t = static_cast<float>(pos_ - i);
+            const float y0 = buf_[i - 1];
+            const float y1 = buf_[i];
+            const float y2 = buf_[i + 1];
+            const float y3 = buf_[i + 2];
+            // Catmull-Rom form of the cubic Hermite.
+            const float c1 = 0.5f * (y2 - y0);
+            const float c2 = y0 - 2.5f * y1 + 2.0f * y2 - 0.5f * y3;
+            const float c3 = 0.5f * (y3 - y0) + 1.5f * (y1 - y2);
+            const float v = ((c3 * t + c2) * t + c1) * t + y1;
+            const long s = std::lround(v);
+            out[produced++] = static_cast<int16_t>(
+                std::clamp<long>(s, INT16_MIN, INT16_MAX));
+            pos_ += step_;
+        }
+        return produced;
+    }
+
+    // Clear the reservoir and rewind to unity ratio. Use on peer re-register
+    // so a new link doesn't start by replaying the old one's tail.
+    void reset() {
+        std::fill(std::begin(buf_), std::end(buf_), 0.0f);
+        // One zero of history so the first output has a left neighbour, plus
+        // the two lookahead zeros (see the class comment).
+        len_ = 3;
+        pos_ = 1.0;
+        step_ = 1.0;
+    }
+
+private:
+    // Slide consumed samples out, keeping the one-sample left neighbour the
+    // interpolator needs.
+    void compact() {
+        const int drop = static_cast<int>(std::floor(pos_)) - 1;
+        if (drop <= 0) return;
+        const int keep = std::max(len_ - drop, 0);
+        std::copy(buf_ + drop, buf_ + drop + keep, buf_);
+        len_ = keep;
+        pos_ -= drop;
+    }
+
+    float buf_[kCapacity] = {};
+    int len_ = 0;
+    double pos_ = 0.0;
+    double step_ = 1.0;
+};
+
 #endif  // RESAMPLER_H
@@ -0,0 +1,108 @@
+#ifndef TALKING_STATE_H
+#define TALKING_STATE_H
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+#include "audio_config.h"
+
+// Which peers are talking, as one bit per peer handle slot (bit
+// `handle % kPeerHandleSlots`), plus each slot's latest decoded RMS level.
+//
+// **Why.** Every VAD edge used to make the mixer tick build a jobjectArray of
+// NewStringUTF MACs and call up into Kotlin from inside the 20 ms tick. Now
+// the tick only publishes a word here; a separate, ordinary-priority notifier
+// thread waits for the word to change and hands it to Kotlin as a single int.
+// Kotlin already knows each peer's handle, so it maps bits back to MACs
+// itself. JNI never runs on the tick.
+//
+// **Coalescing.** The notifier always sends the latest mask, not each edge:
+// edges that land while it's busy collapse into one update, and an edge that
+// reverts before it wakes sends nothing.
+//
+// **Threading.** publish() and setLevel() from the mixer thread; reads from
+// anywhere. publish() takes the wait mutex only when the mask changed, which
+// is at most a VAD edge, never a steady tick.
+class TalkingState {
+public:
+    static constexpr size_t kSlots = audio_config::kPeerHandleSlots;
+    static_assert(kSlots <= 32, "the talking mask is one bit per handle slot");
+
+    // ---- Mixer thread ----
+
+    // Publish the talking set. Returns true (and wakes the notifier) if it
+    // differs from the last one.
+    bool publish(uint32_t mask) {
+        if (mask_.exchange(mask, std::memory_order_acq_rel) == mask) return false;
+        std::lock_guard<std::mutex> lock(mutex_);
+        cv_.notify_one();
+        return true;
+    }
+
+    // Record slot `slot`'s latest decoded RMS, in int16 sample units.
+    void setLevel(size_t slot, uint16_t rms) {
+        levels_[slot].store(rms, std::memory_order_relaxed);
+    }
+
+    // ---- Anyone ----
+
+    uint32_t mask() const { return mask_.load(std::memory_order_acquire); }
+    uint16_t level(size_t slot) const {
+        return levels_[slot].load(std::memory_order_relaxed);
+    }
+
+    // ---- Notifier thread ----
+
+    // Block until the mask differs from `lastSent` or a resend was requested;
+    // store it in `*mask` and return true. Returns false once stop() is
+    // called.
+    bool waitForChange(uint32_t lastSent, uint32_t* mask) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cv_.wait(lock, [&] {
+            return stopped_ || resend_ || mask_.load() != lastSent;
+        });
+        if (stopped_) return false;
+        resend_ = false;
+        *mask = mask_.load();
+        return true;
+    }
+
+    // The receiver changed (a new callback): send the current mask even if
+    // it hasn't changed since the last send.
+    void requestResend() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        resend_ = true;
+        cv_.notify_one();
+    }
+
+    // Release the notifier (waitForChange() returns false) until restart().
+    void stop() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopped_ = true;
+        cv_.notify_all();
+    }
+    void restart() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopped_ = false;
+    }
+
+    // Forget everyone (the peer table was cleared).
+    void reset() {
+        publish(0);
+        for (auto& l : levels_) l.store(0, std::memory_order_relaxed);
+    }
+
+private:
+    std::atomic<uint32_t> mask_{0};
+    std::array<std::atomic<uint16_t>, kSlots> levels_{};
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    bool stopped_{false};
+    bool resend_{false};
+};
+
+#endif  // TALKING_STATE_H
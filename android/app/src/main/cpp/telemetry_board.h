@@ -0,0 +1,90 @@
+#ifndef TELEMETRY_BOARD_H
+#define TELEMETRY_BOARD_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+
+#include "audio_config.h"
+
+// Every peer's marshaled LinkTelemetry, one seqlock-guarded record per peer
+// handle slot, published by the mixer thread and read without locks.
+//
+// **Why.** Pollers (the Dart LinkQualityReporter, the voice debug dashboard)
+// used to fetch telemetry one peer at a time, and each fetch took the
+// registry lock and the peer's state mutex — the lock the mixer tick holds
+// across decode — then allocated a jintArray. A dashboard polling eight
+// peers could hold up a tick. Now the mixer, which already holds each peer's
+// lock during its decode step, copies the counters out here every
+// kTelemetryPublishTicks, and a reader copies the whole room out with no
+// lock at all: polling rate can't reach audio timing.
+//
+// **Seqlock.** A record's `version` is odd while the writer is inside it.
+// The reader copies the fields between two reads of `version` and retries if
+// they differ or are odd. The fields are relaxed atomics, so a torn read is
+// detected and discarded rather than being a data race. `version` also
+// counts publishes: a reader can tell a fresh record from a repeat.
+//
+// **Threading.** One writer (the mixer thread); any number of readers.
+// Readers never block the writer. A record outlives its peer until its slot
+// is reused, so readers filter records by handle against the live registry.
+class TelemetryBoard {
+public:
+    static constexpr size_t kRecords = audio_config::kPeerHandleSlots;
+    static constexpr size_t kFields = audio_config::kTelemetryFieldCount;
+    // A reader that keeps colliding with the writer gives up on the record
+    // rather than spin through a tick; it was only a poll.
+    static constexpr int kMaxReadAttempts = 64;
+
+    // Writer: replace record `index` with `fields` for peer `handle`.
+    void publish(size_t index, int32_t handle, const int32_t* fields) {
+        Record& r = records_[index];
+        const uint32_t v = r.version.load(std::memory_order_relaxed);
+        r.version.store(v + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        r.handle.store(handle, std::memory_order_relaxed);
+        for (size_t i = 0; i < kFields; ++i) {
+            r.fields[i].store(fields[i], std::memory_order_relaxed);
+        }
+        r.version.store(v + 2, std::memory_order_release);
+    }
+
+    // Reader: a consistent copy of record `index`. False if the record was
+    // never published or the writer kept it busy for kMaxReadAttempts tries.
+    bool read(size_t index, int32_t* handle, int32_t* fields,
+              uint32_t* version = nullptr) const {
+        const Record& r = records_[index];
+        for (int attempt = 0; attempt < kMaxReadAttempts; ++attempt) {
+            const uint32_t v1 = r.version.load(std::memory_order_acquire);
+            if (v1 == 0) return false;
+            if (v1 & 1u) {
+                std::this_thread::yield();
+                continue;
+            }
+            const int32_t h = r.handle.load(std::memory_order_relaxed);
+            for (size_t i = 0; i < kFields; ++i) {
+                fields[i] = r.fields[i].load(std::memory_order_relaxed);
+            }
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (r.version.load(std::memory_order_relaxed) == v1) {
+                *handle = h;
+                if (version) *version = v1 / 2;
+                return true;
+            }
+        }
+        return false;
+    }
+
+private:
+    struct alignas(64) Record {
+        std::atomic<uint32_t> version{0};
+        std::atomic<int32_t> handle{0};
+        std::array<std::atomic<int32_t>, kFields> fields{};
+    };
+
+    std::array<Record, kRecords> records_{};
+};
+
+#endif  // TELEMETRY_BOARD_H
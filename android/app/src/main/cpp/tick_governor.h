@@ -0,0 +1,117 @@
+#ifndef TICK_GOVERNOR_H
+#define TICK_GOVERNOR_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+
+#include "audio_config.h"
+
+// Keeps the mixer tick's CPU inside its budget by trading encoder quality
+// for time (audio_config::kGovernorIntervalTicks and friends).
+//
+// **Why.** Every peer's encoder ran at Opus's maximum complexity with FEC on,
+// and every peer's VAD read every sample, whatever the phone could afford. A
+// host with 8 guests runs 8 encoders a tick; on a slow phone the only sign
+// of trouble was "Mixer tick fell behind" and the dropouts that came with it.
+//
+// **Policy.** record() takes each tick's decode, mix and encode time. Once an
+// interval, the mean total decides: over budget steps the level down the
+// ladder at once, a run of calm intervals steps it back up. planFor() turns
+// the level into one peer's settings — encoder complexity, FEC, the RMS
+// stride — with protected peers (talking, or on a weak link) trailing the
+// level by kGovernorProtectLevels, so they're the last to lose anything.
+//
+// **Threading.** record() belongs to the mixer thread. level() and the
+// interval means are atomics, readable from any thread for telemetry and
+// logs.
+class TickGovernor {
+public:
+    // What one peer gets at a given level.
+    struct Plan {
+        int complexity;
+        bool fec;
+        int rmsStride;
+    };
+
+    static Plan planFor(int level, bool protectedPeer) {
+        const int l = std::max(
+            0, protectedPeer ? level - audio_config::kGovernorProtectLevels : level);
+        return {audio_config::kGovernorComplexity[l],
+                l < audio_config::kGovernorFecOffLevel,
+                l >= audio_config::kGovernorRmsStrideLevel ? audio_config::kGovernorRmsStride
+                                                           : 1};
+    }
+
+    // One tick's work, by phase, and the tick's interval (shorter under the
+    // low-latency profile). Returns true when it closed an interval that
+    // changed the level.
+    bool record(uint32_t decodeUs, uint32_t mixUs, uint32_t encodeUs,
+                uint32_t tickUs = kTickUs) {
+        decodeUs_ += decodeUs;
+        mixUs_ += mixUs;
+        encodeUs_ += encodeUs;
+        tickUs_ += tickUs;
+        if (++ticks_ < audio_config::kGovernorIntervalTicks) return false;
+
+        const uint64_t n = static_cast<uint64_t>(ticks_);
+        meanDecodeUs_.store(static_cast<uint32_t>(decodeUs_ / n), std::memory_order_relaxed);
+        meanMixUs_.store(static_cast<uint32_t>(mixUs_ / n), std::memory_order_relaxed);
+        meanEncodeUs_.store(static_cast<uint32_t>(encodeUs_ / n), std::memory_order_relaxed);
+        const uint64_t meanUs = (decodeUs_ + mixUs_ + encodeUs_) / n;
+        const uint64_t meanTickUs = tickUs_ / n;
+        ticks_ = 0;
+        decodeUs_ = mixUs_ = encodeUs_ = tickUs_ = 0;
+
+        const int before = level();
+        int next = before;
+        if (meanUs > meanTickUs * audio_config::kGovernorBudgetPct / 100) {
+            next = std::min(before + 1, audio_config::kGovernorMaxLevel);
+            calmIntervals_ = 0;
+        } else if (meanUs < meanTickUs * audio_config::kGovernorRecoverPct / 100) {
+            if (++calmIntervals_ >= audio_config::kGovernorRecoverIntervals) {
+                next = std::max(before - 1, 0);
+                calmIntervals_ = 0;
+            }
+        } else {
+            calmIntervals_ = 0;
+        }
+        level_.store(next, std::memory_order_relaxed);
+        return next != before;
+    }
+
+    int level() const { return level_.load(std::memory_order_relaxed); }
+
+    // Mean µs per tick of each phase over the last completed interval.
+    uint32_t meanDecodeUs() const { return meanDecodeUs_.load(std::memory_order_relaxed); }
+    uint32_t meanMixUs() const { return meanMixUs_.load(std::memory_order_relaxed); }
+    uint32_t meanEncodeUs() const { return meanEncodeUs_.load(std::memory_order_relaxed); }
+
+    void reset() {
+        ticks_ = 0;
+        calmIntervals_ = 0;
+        decodeUs_ = mixUs_ = encodeUs_ = tickUs_ = 0;
+        level_.store(0, std::memory_order_relaxed);
+        meanDecodeUs_.store(0, std::memory_order_relaxed);
+        meanMixUs_.store(0, std::memory_order_relaxed);
+        meanEncodeUs_.store(0, std::memory_order_relaxed);
+    }
+
+    static constexpr uint32_t kTickUs =
+        static_cast<uint32_t>(audio_config::kMixerTickIntervalMs) * 1000;
+
+private:
+
+    int ticks_{0};
+    int calmIntervals_{0};
+    uint64_t decodeUs_{0};
+    uint64_t mixUs_{0};
+    uint64_t encodeUs_{0};
+    uint64_t tickUs_{0};
+    std::atomic<int> level_{0};
+    std::atomic<uint32_t> meanDecodeUs_{0};
+    std::atomic<uint32_t> meanMixUs_{0};
+    std::atomic<uint32_t> meanEncodeUs_{0};
+};
+
+#endif  // TICK_GOVERNOR_H
@@ -0,0 +1,111 @@
+#ifndef TICK_HISTOGRAM_H
+#define TICK_HISTOGRAM_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "audio_config.h"
+
+// Fixed-bucket latency histogram for the mixer tick: how late each wake-up
+// landed after its deadline, and how long the tick's work took.
+//
+// **Why.** Tick jitter is invisible today but sets two budgets: the jitter
+// buffer has to absorb it on the decode side, and the playout ring's slack
+// (kPlayoutMaxRingFillFrames) has to absorb it on the output side. Knowing
+// the p99 wake lateness and work time tells us whether those budgets are
+// right on a given device.
+//
+// **Windows.** record() bins into the live window. rollWindow() computes the
+// window's p50 / p99 / max, publishes them, and clears the buckets; the
+// published values are what telemetry reads. Percentiles resolve to the
+// upper edge of their bucket (kTickHistBucketUs); a percentile landing in
+// the overflow bucket reads as the window max.
+//
+// **Threading.** Lock-free. record() and rollWindow() belong to one writer
+// (the mixer thread) and use relaxed atomics only, so recording never
+// blocks the tick. Readers may call the published accessors from any thread;
+// each value is individually atomic, but a reader racing a roll can see p99
+// from one window and max from the next — fine for telemetry.
+class TickHistogram {
+public:
+    static constexpr size_t kBuckets = audio_config::kTickHistBuckets;
+    static constexpr uint32_t kBucketUs = audio_config::kTickHistBucketUs;
+
+    TickHistogram() { clearWindow(); }
+
+    void record(uint32_t us) {
+        size_t bucket = us / kBucketUs;
+        if (bucket > kBuckets) bucket = kBuckets;  // overflow bucket
+        buckets_[bucket].fetch_add(1, std::memory_order_relaxed);
+        count_.fetch_add(1, std::memory_order_relaxed);
+        if (us > windowMaxUs_.load(std::memory_order_relaxed)) {
+            windowMaxUs_.store(us, std::memory_order_relaxed);
+        }
+    }
+
+    // Samples in the live window.
+    uint32_t count() const { return count_.load(std::memory_order_relaxed); }
+
+    // q-quantile (0 < q <= 1) of the live window, in µs. 0 when empty.
+    uint32_t percentileUs(double q) const {
+        const uint32_t n = count();
+        if (n == 0) return 0;
+        // Rank of the q-quantile sample, 1-based, rounded up.
+        uint32_t rank = static_cast<uint32_t>(q * n);
+        if (static_cast<double>(rank) < q * n) ++rank;
+        if (rank == 0) rank = 1;
+        uint32_t seen = 0;
+        for (size_t i = 0; i < kBuckets; ++i) {
+            seen += buckets_[i].load(std::memory_order_relaxed);
+            if (seen >= rank) {
+                return static_cast<uint32_t>((i + 1) * kBucketUs);
+            }
+        }
+        return windowMaxUs();
+    }
+
+    uint32_t windowMaxUs() const {
+        return windowMaxUs_.load(std::memory_order_relaxed);
+    }
+
+    // Publish the live window's summary and start a new window. An empty
+    // window publishes nothing, so an idle stretch keeps the last readout.
+    void rollWindow() {
+        if (count() == 0) return;
+        p50Us_.store(percentileUs(0.50), std::memory_order_relaxed);
+        p99Us_.store(percentileUs(0.99), std::memory_order_relaxed);
+        maxUs_.store(windowMaxUs(), std::memory_order_relaxed);
+        clearWindow();
+    }
+
+    // Summary of the most recently completed window, in µs.
+    uint32_t publishedP50Us() const { return p50Us_.load(std::memory_order_relaxed); }
+    uint32_t publishedP99Us() const { return p99Us_.load(std::memory_order_relaxed); }
+    uint32_t publishedMaxUs() const { return maxUs_.load(std::memory_order_relaxed); }
+
+    void reset() {
+        clearWindow();
+        p50Us_.store(0, std::memory_order_relaxed);
+        p99Us_.store(0, std::memory_order_relaxed);
+        maxUs_.store(0, std::memory_order_relaxed);
+    }
+
+private:
+    void clearWindow() {
+        for (auto& b : buckets_) b.store(0, std::memory_order_relaxed);
+        count_.store(0, std::memory_order_relaxed);
+        windowMaxUs_.store(0, std::memory_order_relaxed);
+    }
+
+    // kBuckets linear buckets plus one overflow bucket.
+    std::atomic<uint32_t> buckets_[kBuckets + 1];
+    std::atomic<uint32_t> count_{0};
+    std::atomic<uint32_t> windowMaxUs_{0};
+
+    std::atomic<uint32_t> p50Us_{0};
+    std::atomic<uint32_t> p99Us_{0};
+    std::atomic<uint32_t> maxUs_{0};
+};
+
+#endif  // TICK_HISTOGRAM_H
@@ -0,0 +1,150 @@
+#ifndef VOICE_BUNDLE_H
+#define VOICE_BUNDLE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "audio_config.h"
+
+// Multi-frame VoiceFrame payloads ("bundles") — the layout, the negotiation
+// and the limits are in audio_config.h, next to kMaxBundleFrames.
+//
+// **Why.** Every 20 ms frame used to be its own L2CAP SDU: a 2-byte length
+// prefix and an 8-byte VoiceFrame header on an ~80-byte payload at 32 kbps
+// (over 10 % overhead), and its own ring slot, socket write and connection
+// event. A congested BLE link spends as much on SDU count as on bytes;
+// bundling 2–3 frames cuts both at the price of 20–40 ms of latency, which
+// is why the link controller only bundles when it's congested and has the
+// latency headroom.
+//
+// **Receive side.** isBundle() tells a bundle from an Opus packet, and
+// unpack() hands back the frames one by one so each lands in its own
+// jitter-buffer slot under its own seq. Header-only arithmetic; no state.
+//
+// **Send side.** BundleAccumulator holds the frames encoded so far (the
+// mixer tick encodes straight into it) until flush() packs them into a ring
+// slot. Mixer thread only.
+namespace voice_bundle {
+
+// Bytes a bundle of `frames` frames adds on top of the frames themselves.
+constexpr size_t overheadBytes(size_t frames) {
+    return audio_config::kBundleHeaderBytes +
+           audio_config::kBundleLengthBytes * (frames - 1);
+}
+
+inline bool isBundle(const uint8_t* payload, size_t len) {
+    return len >= audio_config::kBundleHeaderBytes &&
+           payload[0] == audio_config::kBundleMagic0 &&
+           payload[1] == audio_config::kBundleMagic1;
+}
+
+// Split a bundle, calling sink(size_t index, const uint8_t* frame,
+// size_t frameLen) per frame in order. Returns the frame count, or -1 —
+// before calling the sink at all — if the bundle is malformed: a count of
+// 0, 1 or over kMaxBundleFrames, lengths that overrun the payload, or an
+// empty frame.
+template <typename Sink>
+int unpack(const uint8_t* payload, size_t len, Sink&& sink) {
+    if (!isBundle(payload, len)) return -1;
+    const size_t count = payload[2];
+    if (count < 2 || count > audio_config::kMaxBundleFrames) return -1;
+    const size_t headerLen = overheadBytes(count);
+    if (len < headerLen) return -1;
+
+    size_t lens[audio_config::kMaxBundleFrames];
+    size_t total = headerLen;
+    for (size_t i = 0; i + 1 < count; ++i) {
+        const uint8_t* p = payload + audio_config::kBundleHeaderBytes +
+                           audio_config::kBundleLengthBytes * i;
+        lens[i] = (static_cast<size_t>(p[0]) << 8) | p[1];
+        if (lens[i] == 0) return -1;
+        total += lens[i];
+    }
+    if (total >= len) return -1;  // the last frame needs at least one byte
+    lens[count - 1] = len - total;
+
+    const uint8_t* frame = payload + headerLen;
+    for (size_t i = 0; i < count; ++i) {
+        sink(i, frame, lens[i]);
+        frame += lens[i];
+    }
+    return static_cast<int>(count);
+}
+
+}  // namespace voice_bundle
+
+class BundleAccumulator {
+public:
+    static constexpr size_t kMaxFrames = audio_config::kMaxBundleFrames;
+    static constexpr size_t kFrameCap = audio_config::kBundleFrameMaxBytes;
+    static_assert(voice_bundle::overheadBytes(kMaxFrames) + kMaxFrames * kFrameCap <=
+                      audio_config::kOutboundSlotBytes -
+                          audio_config::kVoiceFrameLengthPrefixBytes -
+                          audio_config::kVoiceFrameHeaderBytes,
+                  "a full bundle must fit one outbound ring slot");
+
+    // Where to encode the next frame (kFrameCap bytes), or nullptr when
+    // kMaxFrames are already pending.
+    uint8_t* nextFrame() { return count_ < kMaxFrames ? frames_[count_] : nullptr; }
+
+    // The frame just encoded into nextFrame() is `len` bytes; the first
+    // frame of a bundle supplies the VoiceFrame header's seq and timestamp.
+    void add(uint32_t seq, uint32_t senderTsMs, size_t len) {
+        if (count_ == 0) {
+            firstSeq_ = seq;
+            firstTsMs_ = senderTsMs;
+        }
+        lens_[count_++] = len;
+    }
+
+    size_t count() const { return count_; }
+    uint32_t firstSeq() const { return firstSeq_; }
+    uint32_t firstTsMs() const { return firstTsMs_; }
+
+    // Payload bytes flush() will write.
+    size_t payloadBytes() const {
+        size_t total = count_ > 1 ? voice_bundle::overheadBytes(count_) : 0;
+        for (size_t i = 0; i < count_; ++i) total += lens_[i];
+        return total;
+    }
+
+    // Write the pending frames to `dst` as one VoiceFrame payload — a
+    // bundle, or the bare Opus frame when only one is pending — and clear.
+    // Returns the payload length (0 if nothing was pending). `dst` must hold
+    // payloadBytes(); kFrameCap is sized so kMaxFrames always fit a slot.
+    size_t flush(uint8_t* dst) {
+        const size_t n = count_;
+        const size_t total = payloadBytes();
+        count_ = 0;
+        if (n == 0) return 0;
+        if (n == 1) {
+            std::memcpy(dst, frames_[0], lens_[0]);
+            return total;
+        }
+        dst[0] = audio_config::kBundleMagic0;
+        dst[1] = audio_config::kBundleMagic1;
+        dst[2] = static_cast<uint8_t>(n);
+        uint8_t* p = dst + audio_config::kBundleHeaderBytes;
+        for (size_t i = 0; i + 1 < n; ++i) {
+            *p++ = static_cast<uint8_t>(lens_[i] >> 8);
+            *p++ = static_cast<uint8_t>(lens_[i]);
+        }
+        for (size_t i = 0; i < n; ++i) {
+            std::memcpy(p, frames_[i], lens_[i]);
+            p += lens_[i];
+        }
+        return total;
+    }
+
+    void clear() { count_ = 0; }
+
+private:
+    uint8_t frames_[kMaxFrames][kFrameCap];
+    size_t lens_[kMaxFrames]{};
+    size_t count_{0};
+    uint32_t firstSeq_{0};
+    uint32_t firstTsMs_{0};
+};
+
+#endif  // VOICE_BUNDLE_H
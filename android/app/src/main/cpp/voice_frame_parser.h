@@ -0,0 +1,186 @@
+#ifndef VOICE_FRAME_PARSER_H
+#define VOICE_FRAME_PARSER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#include "audio_config.h"
+#include "voice_header.h"
+
+// Incremental parser for the L2CAP voice byte stream (docs/protocol.md,
+// "VoiceFrame"): a 2-byte big-endian length prefix, then that many bytes of
+// VoiceFrame — an 8-byte header (seq, senderTsMs; both uint32 BE) followed by
+// the Opus payload. A prefix with audio_config::kCompactHeaderFlag set
+// carries a compact header instead (voice_header.h), which the parser
+// extends back to a full seq and senderTsMs before the sink sees it.
+//
+// **Why.** The Kotlin receive loop used to read each frame into a fresh
+// ByteArray, parse the header in Kotlin, copyOfRange the payload into a
+// second array, and pin that across JNI: three allocations and copies per
+// 20 ms frame per peer. Now it reads whatever the socket has into one reused
+// direct ByteBuffer and hands the raw bytes here, so a single JNI crossing
+// delivers every frame the read picked up.
+//
+// **Zero-copy.** A frame lying wholly inside the fed bytes goes to the sink
+// as a pointer into them. Only a frame split across reads is copied, into a
+// fixed carry buffer, until its last byte arrives.
+//
+// **Validation** (as the protocol doc specifies): a length prefix of 0 or
+// over kVoiceFrameMaxBytes is fatal — the stream is desynchronised, and the
+// caller must close the channel; feed() returns -1 from then on until
+// reset(). A VoiceFrame too short to hold the header plus at least one
+// payload byte is dropped and counted, and parsing carries on — unless it is
+// exactly a header and the caller passed a control sink: that is a
+// link-control frame (audio_config::kLinkControlBundleOffer), delivered as
+// (seq, senderTsMs) and not counted. A compact-header frame that arrives
+// before any full header has nothing to extend against, and is dropped and
+// counted too.
+//
+// **Threading.** Not thread-safe. One parser per stream, fed only by that
+// stream's receive thread.
+class VoiceFrameParser {
+public:
+    static constexpr size_t kPrefixBytes = audio_config::kVoiceFrameLengthPrefixBytes;
+    static constexpr size_t kHeaderBytes = audio_config::kVoiceFrameHeaderBytes;
+    static constexpr size_t kMaxFrameBytes = audio_config::kVoiceFrameMaxBytes;
+    static constexpr size_t kCompactHeaderBytes = audio_config::kCompactHeaderBytes;
+
+    // Parse `n` stream bytes, calling
+    //   sink(uint32_t seq, uint32_t senderTsMs, const uint8_t* payload,
+    //        size_t payloadLen)
+    // once per complete, valid VoiceFrame, in stream order. `payload` is only
+    // valid during the call. Returns the number of frames delivered, or -1 on
+    // a fatal framing error.
+    template <typename Sink>
+    int feed(const uint8_t* data, size_t n, Sink&& sink) {
+        return feed(data, n, sink, nullptr);
+    }
+
+    // As above, also calling
+    //   control(uint32_t seq, uint32_t senderTsMs)
+    // for each header-only (link-control) frame. Those don't count towards
+    // the return value.
+    template <typename Sink, typename ControlSink>
+    int feed(const uint8_t* data, size_t n, Sink&& sink, ControlSink&& control) {
+        if (failed_) return -1;
+        int delivered = 0;
+        size_t pos = 0;
+        while (pos < n) {
+            // Fast path: nothing carried over and the whole frame is here.
+            if (carryLen_ == 0 && n - pos >= kPrefixBytes) {
+                const size_t prefix = readBe16(data + pos);
+                const size_t len = prefix & ~size_t{audio_config::kCompactHeaderFlag};
+                if (!validLength(len)) return fail();
+                if (n - pos - kPrefixBytes >= len) {
+                    delivered += deliver(data + pos + kPrefixBytes, len,
+                                         prefix != len, sink, control);
+                    pos += kPrefixBytes + len;
+                    continue;
+                }
+            }
+
+            // Slow path: accumulate the prefix, then the frame, in carry_.
+            const size_t want = carryLen_ < kPrefixBytes
+                                    ? kPrefixBytes - carryLen_
+                                    : kPrefixBytes + expectedLen_ - carryLen_;
+            const size_t take = want < n - pos ? want : n - pos;
+            std::memcpy(carry_ + carryLen_, data + pos, take);
+            carryLen_ += take;
+            pos += take;
+            if (carryLen_ == kPrefixBytes) {
+                const size_t prefix = readBe16(carry_);
+                expectedLen_ = prefix & ~size_t{audio_config::kCompactHeaderFlag};
+                if (!validLength(expectedLen_)) return fail();
+            } else if (carryLen_ == kPrefixBytes + expectedLen_) {
+                const bool compact = readBe16(carry_) != expectedLen_;
+                delivered += deliver(carry_ + kPrefixBytes, expectedLen_, compact,
+                                     sink, control);
+                carryLen_ = 0;
+                expectedLen_ = 0;
+            }
+        }
+        return delivered;
+    }
+
+    // VoiceFrames dropped as too short to carry a header and payload.
+    uint64_t shortFrameCount() const { return shortFrames_; }
+
+    // Compact-header frames dropped for want of a full header before them.
+    uint64_t unanchoredFrameCount() const { return unanchoredFrames_; }
+
+    bool failed() const { return failed_; }
+
+    // Forget any partial frame and clear a fatal error — for a new stream.
+    void reset() {
+        carryLen_ = 0;
+        expectedLen_ = 0;
+        failed_ = false;
+        headers_.reset();
+    }
+
+private:
+    static size_t readBe16(const uint8_t* p) {
+        return (static_cast<size_t>(p[0]) << 8) | p[1];
+    }
+
+    static uint32_t readBe32(const uint8_t* p) {
+        return (static_cast<uint32_t>(p[0]) << 24) |
+               (static_cast<uint32_t>(p[1]) << 16) |
+               (static_cast<uint32_t>(p[2]) << 8) | static_cast<uint32_t>(p[3]);
+    }
+
+    static bool validLength(size_t len) {
+        return len > 0 && len <= kMaxFrameBytes;
+    }
+
+    int fail() {
+        failed_ = true;
+        return -1;
+    }
+
+    template <typename Sink, typename ControlSink>
+    int deliver(const uint8_t* frame, size_t len, bool compact, Sink& sink,
+                ControlSink& control) {
+        if (compact) {
+            uint32_t seq;
+            uint32_t senderTsMs;
+            if (len <= kCompactHeaderBytes) {
+                ++shortFrames_;
+                return 0;
+            }
+            if (!headers_.expand(frame, seq, senderTsMs)) {
+                ++unanchoredFrames_;
+                return 0;
+            }
+            sink(seq, senderTsMs, frame + kCompactHeaderBytes, len - kCompactHeaderBytes);
+            return 1;
+        }
+        if (len <= kHeaderBytes) {
+            if constexpr (!std::is_null_pointer_v<std::decay_t<ControlSink>>) {
+                if (len == kHeaderBytes) {
+                    control(readBe32(frame), readBe32(frame + 4));
+                    return 0;
+                }
+            }
+            ++shortFrames_;
+            return 0;
+        }
+        const uint32_t seq = readBe32(frame);
+        const uint32_t senderTsMs = readBe32(frame + 4);
+        headers_.noteFull(seq, senderTsMs);
+        sink(seq, senderTsMs, frame + kHeaderBytes, len - kHeaderBytes);
+        return 1;
+    }
+
+    uint8_t carry_[kPrefixBytes + kMaxFrameBytes];
+    size_t carryLen_{0};
+    size_t expectedLen_{0};
+    bool failed_{false};
+    uint64_t shortFrames_{0};
+    uint64_t unanchoredFrames_{0};
+    CompactHeaderDecoder headers_;
+};
+
+#endif  // VOICE_FRAME_PARSER_H
@@ -0,0 +1,88 @@
+#ifndef VOICE_HEADER_H
+#define VOICE_HEADER_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include "audio_config.h"
+
+// Compact VoiceFrame headers — the layout, the negotiation and the resync
+// rules are in audio_config.h, next to kCompactHeaderFlag.
+//
+// **Why.** At kBitrateLow a 20 ms frame is ~40 bytes of Opus behind 10 bytes
+// of prefix and header; on a host serving several peers over one radio,
+// those bytes are connection-event airtime that could carry audio. Five of
+// the eight header bytes are redundant frame to frame.
+//
+// **Send side.** CompactHeaderEncoder decides, frame by frame, whether the
+// receiver can still extend a compact header unambiguously; the outbound
+// ring writes whichever form it is told. Mixer thread only.
+//
+// **Receive side.** CompactHeaderDecoder keeps the last frame's seq and
+// timestamp and extends compact headers against it. One per stream, on the
+// stream's receive thread (VoiceFrameParser owns it).
+class CompactHeaderEncoder {
+public:
+    // Whether voice frame (seq, senderTsMs) may go out with a compact header.
+    // Call once per voice frame, in send order. `epoch` is anything that
+    // changes when the receiver may have missed frames since the last call
+    // (OutboundFrameRing::continuityEpoch()).
+    bool next(uint32_t seq, uint32_t senderTsMs, uint64_t epoch) {
+        const uint32_t step = seq - lastSeq_;
+        const int64_t skewMs = static_cast<int32_t>(
+            senderTsMs - lastTsMs_ - step * static_cast<uint32_t>(audio_config::kFrameDurationMs));
+        const bool compact =
+            primed_ && epoch == epoch_ && sinceFull_ < audio_config::kCompactResyncFrames &&
+            step >= 1 && step <= audio_config::kCompactMaxSeqStep &&
+            skewMs >= -audio_config::kCompactMaxTsSkewMs &&
+            skewMs <= audio_config::kCompactMaxTsSkewMs;
+        sinceFull_ = compact ? sinceFull_ + 1 : 0;
+        primed_ = true;
+        lastSeq_ = seq;
+        lastTsMs_ = senderTsMs;
+        epoch_ = epoch;
+        return compact;
+    }
+
+private:
+    bool primed_{false};
+    uint32_t lastSeq_{0};
+    uint32_t lastTsMs_{0};
+    uint64_t epoch_{0};
+    uint32_t sinceFull_{0};
+};
+
+class CompactHeaderDecoder {
+public:
+    // A full header arrived: the reference for the compact ones after it.
+    void noteFull(uint32_t seq, uint32_t senderTsMs) {
+        primed_ = true;
+        seq_ = seq;
+        tsMs_ = senderTsMs;
+    }
+
+    // Extend the kCompactHeaderBytes at `h`. False — drop the frame — when
+    // no full header has arrived on this stream yet.
+    bool expand(const uint8_t* h, uint32_t& seq, uint32_t& senderTsMs) {
+        if (!primed_) return false;
+        seq = seq_ + static_cast<uint32_t>(
+                         static_cast<int8_t>(static_cast<uint8_t>(h[0] - seq_)));
+        const uint32_t predicted =
+            tsMs_ + (seq - seq_) * static_cast<uint32_t>(audio_config::kFrameDurationMs);
+        const uint16_t low = static_cast<uint16_t>((h[1] << 8) | h[2]);
+        senderTsMs = predicted + static_cast<uint32_t>(static_cast<int16_t>(
+                                     static_cast<uint16_t>(low - predicted)));
+        seq_ = seq;
+        tsMs_ = senderTsMs;
+        return true;
+    }
+
+    void reset() { primed_ = false; }
+
+private:
+    bool primed_{false};
+    uint32_t seq_{0};
+    uint32_t tsMs_{0};
+};
+
+#endif  // VOICE_HEADER_H
@@ -85,6 +85,13 @@ class AudioEngineManager {
         nativeSetDuckingVolume(volume)
     }
 
+    /**
+     * Audio xruns since the engine's streams last opened: `[mic overruns,
+     * playout underruns]`. Both stay 0 on devices whose audio path doesn't
+     * report them, and when the engine isn't running.
+     */
+    fun xRunCounts(): IntArray = nativeGetXRunCounts()
+
     /**
      * Enables a single-device loopback validation path. When enabled, the
      * native audio callback routes local mic PCM into a synthetic mixer peer
@@ -104,4 +111,5 @@ class AudioEngineManager {
     private external fun nativeResumeStreams(): Boolean
     private external fun nativeSetDuckingVolume(volume: Float)
     private external fun nativeSetLoopbackTestMode(enabled: Boolean): Boolean
+    private external fun nativeGetXRunCounts(): IntArray
 }
@@ -7,7 +7,8 @@ import java.io.DataInputStream
 import java.io.IOException
 import java.io.InputStream
 import java.io.OutputStream
-import java.util.concurrent.LinkedBlockingQueue
+import java.nio.ByteBuffer
+import java.nio.channels.Channels
 import java.util.concurrent.atomic.AtomicBoolean
 
 /**
@@ -21,20 +22,27 @@ import java.util.concurrent.atomic.AtomicBoolean
  * boundaries deterministic across OEMs (some kernels coalesce multiple
  * SDUs into one userspace `read`), every L2CAP write is preceded by a
  * 2-byte big-endian length prefix carrying the size of the VoiceFrame
- * payload that follows. Receivers read the prefix, then exactly that
- * many bytes, then dispatch the inner bytes to [onVoiceFrame] — exactly
- * the same payload the original v1 spec described, just framed at the
- * transport layer instead of relying on packet boundaries.
+ * payload that follows — exactly the same payload the original v1 spec
+ * described, just framed at the transport layer instead of relying on
+ * packet boundaries. The receive side doesn't reassemble frames itself: it
+ * reads whatever bytes the socket has into one reused direct [ByteBuffer]
+ * and hands them to [onVoiceBytes] along with the socket's
+ * [PeerAudioManager.VoiceStream], whose native parser does the prefix
+ * reassembly and header validation — several frames per JNI crossing, no
+ * per-frame allocation.
  *
  * **Thread model**: each connected socket owns one *writer* thread and
- * one *reader* thread. Producers (audio capture, heartbeats, …) call
- * [sendToHost] / [sendToClient], which push onto a bounded
- * [LinkedBlockingQueue]; the writer drains the queue and serialises
- * writes onto the socket so concurrent producers can never tear a frame.
- * The reader runs the framed-read loop. [stop] signals shutdown via a
- * sentinel + socket close, then joins both threads with a short timeout
- * so callers (the foreground service) can fully tear down between
- * sessions without leaking threads.
+ * one *reader* thread. The send side has no Kotlin queue: the native mixer
+ * encodes each outbound frame, already length-prefixed, into the peer's
+ * native outbound ring ([PeerAudioManager.OutboundRing], claimed through
+ * [attachOutbound]), and the writer thread parks in native until a frame
+ * is ready, then writes it straight from the ring's direct [ByteBuffer].
+ * The ring sheds stale and over-backlog frames before the writer sees
+ * them. The writer is the only thread that touches the socket's output,
+ * so frames can never tear. The reader runs the read loop. [stop] flags
+ * shutdown and closes the socket, then joins both threads with a short
+ * timeout so callers (the foreground service) can fully tear down
+ * between sessions without leaking threads.
  *
  * **Known risks** documented in issue #46:
  *  - `listenUsingInsecureL2capChannel` is flaky on some OEMs; guest side
@@ -44,7 +52,20 @@ import java.util.concurrent.atomic.AtomicBoolean
  */
 class L2capVoiceTransport(
     private val bluetoothAdapter: BluetoothAdapter,
-    private val onVoiceFrame: (String, ByteArray) -> Unit,
+    /**
+     * Raw inbound bytes: (address, the socket's native stream parser, a
+     * direct buffer holding the bytes at [0, length), length). Returns the
+     * frames parsed, or -1 on a fatal framing error, which closes the
+     * channel. The buffer is reused as soon as this returns.
+     */
+    private val onVoiceBytes: (String, PeerAudioManager.VoiceStream, ByteBuffer, Int) -> Int,
+    /**
+     * Claim the native outbound ring for the peer at an address, or null if
+     * that peer isn't registered yet (the writer retries).
+     */
+    private val attachOutbound: (String) -> PeerAudioManager.OutboundRing?,
+    /** The first frame from a newly attached outbound ring is on the wire. */
+    private val onFirstVoiceFrameSent: (String) -> Unit,
     private val onClientConnected: (String) -> Unit,
     private val onError: (String) -> Unit,
 ) {
@@ -53,35 +74,18 @@ class L2capVoiceTransport(
         private val BACKOFF_MS = longArrayOf(250, 500, 1000, 2000, 5000)
 
         /**
-         * Per-socket send queue capacity. At one frame per 20 ms, this is
-         * the worst-case send-side latency the queue can inject before the
-         * drop-oldest policy ([enqueueFrame]) kicks in. Voice is
-         * latency-sensitive, so we keep this shallow: 6 frames is ~120 ms,
-         * enough to ride out a brief link stall without the queue itself
-         * becoming a multi-second backlog under full-duplex contention.
-         * (Was 64 ≈ 1.3 s, which pinned playout ~1.3 s stale once the link
-         * couldn't keep up.)
+         * Per-peer send backlog cap, in frames. Mirrors
+         * `audio_config::kOutboundQueueFrames`: the native outbound ring keeps
+         * only the newest 6 frames (~120 ms) for the writer and drops the
+         * oldest beyond that, so a brief link stall can't turn into a
+         * multi-second backlog under full-duplex contention. The ring also
+         * sheds any frame that waited over `kOutboundStaleBudgetMs` (200 ms)
+         * for the wire — the sender-side half of the "favour the freshest
+         * audio" policy, for when the kernel L2CAP TX buffer backs up and
+         * `write()` blocks.
          */
         const val SEND_QUEUE_CAPACITY = 6
 
-        /**
-         * Freshness budget for a queued frame. Voice is real-time: a frame
-         * that has waited longer than this before the writer could put it on
-         * the wire is already stale, and writing it only deepens the latency
-         * the listener hears. The writer drops such frames instead.
-         *
-         * This is the sender-side half of the end-to-end "favour the freshest
-         * audio" policy (the receiver caps its jitter buffer + playout ring the
-         * same way). It matters because the bottleneck is usually *below* this
-         * shallow app queue: once the kernel/controller L2CAP TX buffer backs
-         * up, `OutputStream.write()` blocks, queued frames age past this budget,
-         * and we shed them rather than letting the backlog grow unbounded.
-         * 200 ms ≈ 10 frames: comfortably past the [SEND_QUEUE_CAPACITY] (120
-         * ms) so a healthy link never trips it, tight enough that a congested
-         * one can't pin playout seconds stale.
-         */
-        const val STALE_FRAME_BUDGET_MS = 200L
-
         /** Length-prefix size: 2 bytes big-endian. */
         const val LENGTH_PREFIX_SIZE = 2
 
@@ -93,6 +97,30 @@ class L2capVoiceTransport(
          */
         const val MAX_FRAME_SIZE = 4096
 
+        /**
+         * Length-prefix bit marking a compact-header VoiceFrame (mirrors
+         * `audio_config::kCompactHeaderFlag`); the length is the bits below
+         * it. Native writes it, native parses it — the writer only has to
+         * mask it off to know how many bytes to send.
+         */
+        private const val COMPACT_HEADER_FLAG = 0x8000
+
+        /**
+         * Receive buffer size: one maximal frame plus its prefix, so a single
+         * read can always complete a frame; typical reads carry a few
+         * ~100-byte frames.
+         */
+        private const val RECV_BUFFER_SIZE = LENGTH_PREFIX_SIZE + MAX_FRAME_SIZE
+
+        /**
+         * How long the writer parks in native per wait before re-checking
+         * for shutdown. Well inside [JOIN_TIMEOUT_MS].
+         */
+        private const val OUTBOUND_WAIT_MS = 100
+
+        /** Retry interval while the socket's peer isn't registered yet. */
+        private const val OUTBOUND_ATTACH_RETRY_MS = 20L
+
         /** How long to wait for worker threads to drain on [stop]. */
         private const val JOIN_TIMEOUT_MS = 500L
     }
@@ -104,21 +132,12 @@ class L2capVoiceTransport(
      */
     private class SocketIo(
         val socket: BluetoothSocket,
-        val sendQueue: LinkedBlockingQueue<QueuedFrame>,
+        /** Set on teardown; the writer exits at its next wake. */
+        val closed: AtomicBoolean = AtomicBoolean(false),
         var recvThread: Thread? = null,
         var writerThread: Thread? = null,
     )
 
-    /**
-     * A frame waiting on the send queue, stamped with the monotonic time it was
-     * enqueued so the writer can shed it if it goes stale before reaching the
-     * wire (see [STALE_FRAME_BUDGET_MS]).
-     */
-    private class QueuedFrame(val bytes: ByteArray, val enqueuedNanos: Long)
-
-    /** Sentinel pushed onto the send queue to terminate the writer thread. */
-    private val shutdownSentinel = QueuedFrame(ByteArray(0), 0L)
-
     // Host-side: server socket + accepted client sockets
     private var serverSocket: android.bluetooth.BluetoothServerSocket? = null
     private var activePsm: Int = -1
@@ -168,7 +187,7 @@ class L2capVoiceTransport(
                 // Insert into the map *before* starting threads so the recv
                 // thread's finally-block remove() can never fire ahead of the
                 // put() if the peer disconnects immediately.
-                val io = SocketIo(client, LinkedBlockingQueue(SEND_QUEUE_CAPACITY))
+                val io = SocketIo(client)
                 synchronized(clientSockets) { clientSockets[addr] = io }
                 startSocketIoThreads(addr, io)
                 onClientConnected(addr)
@@ -185,12 +204,6 @@ class L2capVoiceTransport(
         }
     }
 
-    /** Send [frame] to a connected client at [addr]. No-op if not connected. */
-    fun sendToClient(addr: String, frame: ByteArray) {
-        val io = synchronized(clientSockets) { clientSockets[addr] } ?: return
-        enqueueFrame(io, frame)
-    }
-
     // ── Guest side ─────────────────────────────────────────────────────────
 
     /**
@@ -207,7 +220,7 @@ class L2capVoiceTransport(
         }
         // Tear down any existing guest connection before dialling a new one.
         // Snapshot under the lock, then join the worker threads outside it
-        // so we never block other callers (sendToHost, stop) while waiting.
+        // so we never block other callers (stop) while waiting.
         val prev = synchronized(this) {
             val p = guestIo
             guestIo = null
@@ -229,7 +242,7 @@ class L2capVoiceTransport(
                 Thread.sleep(delay)
                 sock = device.createInsecureL2capChannel(psm)
                 sock.connect()
-                val io = SocketIo(sock, LinkedBlockingQueue(SEND_QUEUE_CAPACITY))
+                val io = SocketIo(sock)
                 synchronized(this) { guestIo = io }
                 startSocketIoThreads(macAddress, io)
                 Log.i(TAG, "L2CAP connected to $macAddress PSM 0x${psm.toString(16)}")
@@ -243,12 +256,6 @@ class L2capVoiceTransport(
         return false
     }
 
-    /** Send [frame] to the host (guest-side path). */
-    fun sendToHost(frame: ByteArray) {
-        val io = synchronized(this) { guestIo } ?: return
-        enqueueFrame(io, frame)
-    }
-
     // ── Per-socket worker plumbing ─────────────────────────────────────────
 
     /**
@@ -267,14 +274,16 @@ class L2capVoiceTransport(
     }
 
     /**
-     * Drain the per-socket queue and write each frame as a
-     * length-prefixed payload. Exits when the writer pulls
-     * [shutdownSentinel] off the queue, on I/O error, or on interrupt.
+     * Write the peer's outbound frames to the socket as the native mixer
+     * produces them. Attaches to the peer's [PeerAudioManager.OutboundRing]
+     * (retrying until the peer is registered), parks in native until a frame
+     * is ready, and writes it — length prefix, header and payload, exactly as
+     * the ring holds it — from the ring's direct buffer. Re-attaches if the
+     * peer is unregistered and registered again under the same address.
+     * Exits once [SocketIo.closed] is set, on I/O error, or on interrupt.
      *
-     * This is the *only* thread that touches the socket's [OutputStream]
-     * — concurrent producers push to [SocketIo.sendQueue] but never
-     * write directly to the socket. That's what eliminates the
-     * torn-frame race that issue #101 reports.
+     * This is the *only* thread that touches the socket's [OutputStream],
+     * which is what eliminates the torn-frame race that issue #101 reports.
      *
      * The OutputStream is opened lazily here rather than at thread-spawn
      * time because [BluetoothSocket.getOutputStream] can throw if the
@@ -289,86 +298,108 @@ class L2capVoiceTransport(
             Log.w(TAG, "Writer for $addr couldn't open output stream: ${e.message}")
             return
         }
+        val channel = Channels.newChannel(out)
+        var ring: PeerAudioManager.OutboundRing? = null
+        // Our own view of the ring's buffer, so setting position/limit per
+        // frame never disturbs anyone else's.
+        var view: ByteBuffer? = null
+        var sentOnRing = 0L
         var sent = 0L
-        var droppedStale = 0L
         try {
-            while (true) {
-                val queued = io.sendQueue.take()
-                if (queued === shutdownSentinel) break
-                val frame = queued.bytes
-                if (frame.isEmpty()) continue
-                if (frame.size > MAX_FRAME_SIZE) {
-                    Log.w(TAG, "Dropping oversized frame (${frame.size}B) for $addr")
+            while (!io.closed.get()) {
+                val r = ring ?: attachOutbound(addr)
+                if (r == null) {
+                    Thread.sleep(OUTBOUND_ATTACH_RETRY_MS)
                     continue
                 }
-                // Favour the freshest audio: if this frame waited past the
-                // budget (the link couldn't drain it in time), drop it rather
-                // than writing seconds-old audio into the kernel L2CAP TX
-                // buffer — which we can neither flush nor drain. This is what
-                // gives the otherwise-reliable, ordered CoC stream UDP-like
-                // "shed late packets" behaviour at the app layer.
-                if (isFrameStale(System.nanoTime() - queued.enqueuedNanos,
-                                 STALE_FRAME_BUDGET_MS)) {
-                    if (++droppedStale % 50L == 0L) {
-                        Log.i(TAG, "VOICE-DIAG tx $addr dropped $droppedStale stale frames")
-                    }
+                if (ring == null) {
+                    ring = r
+                    view = r.buffer.duplicate()
+                    sentOnRing = 0L
+                }
+                val v = view ?: break
+                val offset = r.acquire(OUTBOUND_WAIT_MS)
+                if (offset == PeerAudioManager.OutboundRing.EMPTY) continue
+                if (offset == PeerAudioManager.OutboundRing.CLOSED) {
+                    r.close()
+                    ring = null
                     continue
                 }
+                val frameLen = (((v.get(offset).toInt() and 0xFF) shl 8) or
+                    (v.get(offset + 1).toInt() and 0xFF)) and COMPACT_HEADER_FLAG.inv()
+                v.clear()
+                v.position(offset)
+                v.limit(offset + LENGTH_PREFIX_SIZE + frameLen)
                 try {
-                    writeFramed(out, frame)
-                    // VOICE-DIAG: per-direction send rate + backlog. One leg
-                    // showing 0 sent pinpoints a one-direction-audio failure.
-                    if (++sent % 50L == 0L) {
-                        Log.i(TAG, "VOICE-DIAG tx $addr sent=$sent qDepth=${io.sendQueue.size}")
-                    }
+                    while (v.hasRemaining()) channel.write(v)
+                    out.flush()
                 } catch (e: IOException) {
                     Log.i(TAG, "Writer for $addr ended after $sent frames: ${e.message}")
                     break
+                } finally {
+                    r.release()
+                }
+                if (sentOnRing++ == 0L) onFirstVoiceFrameSent(addr)
+                // VOICE-DIAG: per-direction send rate. One leg showing 0 sent
+                // pinpoints a one-direction-audio failure.
+                if (++sent % 50L == 0L) {
+                    Log.i(TAG, "VOICE-DIAG tx $addr sent=$sent")
                 }
             }
         } catch (_: InterruptedException) {
             Thread.currentThread().interrupt()
+        } finally {
+            ring?.close()
         }
     }
 
     private fun receiveLoop(addr: String, io: SocketIo) {
         val socket = io.socket
         var recv = 0L
+        // Owned by this thread for the life of the socket: the native parser
+        // carries a frame split across reads over to the next one.
+        val stream = PeerAudioManager.VoiceStream()
         try {
-            val input = DataInputStream(socket.inputStream)
+            val channel = Channels.newChannel(socket.inputStream)
+            val buf = ByteBuffer.allocateDirect(RECV_BUFFER_SIZE)
             while (socket.isConnected) {
-                val frame = try {
-                    readFramed(input)
+                buf.clear()
+                val n = try {
+                    channel.read(buf)
                 } catch (e: IOException) {
                     Log.i(TAG, "Receive loop ended for $addr after $recv frames: ${e.message}")
                     break
-                } ?: break // EOF
-                if (frame.size < 8) {
-                    // VoiceFrame requires the 8-byte header — drop and keep
-                    // reading; a malformed peer can't lock us out.
-                    Log.w(TAG, "Frame from $addr shorter than VoiceFrame header — dropping")
-                    continue
+                }
+                if (n < 0) break // EOF
+                if (n == 0) continue
+                // Frames shorter than the VoiceFrame header are dropped by the
+                // parser and reading continues; a bad length prefix means the
+                // stream is desynchronised, so close the channel.
+                val frames = onVoiceBytes(addr, stream, buf, n)
+                if (frames < 0) {
+                    Log.w(TAG, "Invalid frame length prefix from $addr — closing channel")
+                    break
                 }
                 // VOICE-DIAG: per-direction receive rate. A registered+mixing
                 // peer with recv stuck at 0 means the inbound leg is dead.
-                if (++recv % 50L == 0L) {
+                val before = recv
+                recv += frames
+                if (recv / 50L != before / 50L) {
                     Log.i(TAG, "VOICE-DIAG rx $addr recv=$recv")
                 }
-                onVoiceFrame(addr, frame)
             }
         } catch (e: IOException) {
-            // Defensive — DataInputStream construction shouldn't throw, but
-            // BluetoothSocket.getInputStream() can if the socket closed
-            // racy with this thread starting.
+            // Defensive — BluetoothSocket.getInputStream() can throw if the
+            // socket closed racy with this thread starting.
             Log.i(TAG, "Receive loop init failed for $addr: ${e.message}")
         } finally {
+            stream.close()
             // Signal the writer to stop *before* dropping references — if
-            // the peer disconnected silently, the writer is parked on
-            // queue.take() forever, which is the leak Copilot flagged.
-            // Clearing the queue plus offering the sentinel guarantees
-            // the writer wakes up and exits.
-            io.sendQueue.clear()
-            io.sendQueue.offer(shutdownSentinel)
+            // the peer disconnected silently, nothing else would end its
+            // wait loop, which is the leak Copilot flagged. It sees the
+            // flag at its next wake (at most OUTBOUND_WAIT_MS) and exits,
+            // handing the outbound ring back for the next link.
+            io.closed.set(true)
             // Drop both the host-side (clientSockets) and guest-side (guestIo)
             // reference for whichever socket this loop was bound to. The
             // guest check is identity-based (socket ===) so a fresh
@@ -383,36 +414,14 @@ class L2capVoiceTransport(
     }
 
     /**
-     * Push [frame] onto [io]'s send queue. If the queue is full
-     * (producers outpacing the link), drop the *oldest* frame — voice is
-     * latency-sensitive, and stale audio is worse than missing audio.
-     *
-     * The poll+offer pair is wrapped in a `while` loop so a competing
-     * producer that refills the queue between our poll and our offer
-     * can't cause us to silently drop the *newest* frame instead of the
-     * oldest. Each loop iteration drops one and tries to add one;
-     * progress is bounded by the queue capacity.
-     */
-    private fun enqueueFrame(io: SocketIo, frame: ByteArray) {
-        if (frame.isEmpty()) return
-        val queued = QueuedFrame(frame, System.nanoTime())
-        while (!io.sendQueue.offer(queued)) {
-            io.sendQueue.poll() // drop oldest, retry the offer
-        }
-    }
-
-    /**
-     * Cleanly stop a socket's I/O workers: enqueue the shutdown
-     * sentinel, close the socket to unblock the reader, then join both
-     * threads with a bounded timeout. Anything still alive after
-     * the timeout gets interrupted as a fallback.
+     * Cleanly stop a socket's I/O workers: flag shutdown, close the socket
+     * to unblock the reader, then join both threads with a bounded timeout.
+     * Anything still alive after the timeout gets interrupted as a fallback.
      */
     private fun stopSocketIo(io: SocketIo) {
-        // Signal the writer first; clearing the queue avoids one last
-        // enqueued frame slipping out after stop.
-        io.sendQueue.clear()
-        io.sendQueue.offer(shutdownSentinel)
-        // Closing the socket unblocks readFully() in the recv loop and
+        // Signal the writer first so no further frame goes out after stop.
+        io.closed.set(true)
+        // Closing the socket unblocks read() in the recv loop and
         // breaks any in-progress write() in the writer loop.
         try { io.socket.close() } catch (_: IOException) {}
 
@@ -479,21 +488,15 @@ class L2capVoiceTransport(
         synchronized(clientSockets) { clientSockets.keys.toList() }
 }
 
-/**
- * True if a frame that has waited [ageNanos] on the send queue has exceeded
- * the [budgetMs] freshness budget and should be dropped rather than written.
- * Pulled out as a pure function so the writer's drop decision is unit-testable
- * without standing up real Bluetooth sockets and threads.
- */
-internal fun isFrameStale(ageNanos: Long, budgetMs: Long): Boolean =
-    ageNanos > budgetMs * 1_000_000L
-
 // ── Framing helpers (package-private for unit tests) ───────────────────────
 
 /**
  * Write [frame] to [out] as a 2-byte big-endian length prefix followed by
  * the frame bytes. The length carries only the frame size — the prefix
  * itself is *not* counted, matching common framed-protocol convention.
+ * The send path itself writes frames the native outbound ring already
+ * framed this way (outbound_frame_ring.h); this is the Kotlin reference
+ * writer the framing tests pin the wire format with.
  *
  * Throws [IllegalArgumentException] if the frame exceeds
  * [L2capVoiceTransport.MAX_FRAME_SIZE]; throws [IOException] if the
@@ -517,7 +520,9 @@ internal fun writeFramed(out: OutputStream, frame: ByteArray) {
 }
 
 /**
- * Read one length-prefixed frame from [input]. Returns the frame bytes
+ * Read one length-prefixed frame from [input]. The receive loop itself
+ * parses natively (voice_frame_parser.h); this is the Kotlin reference
+ * reader the framing tests pin the wire format with. Returns the frame bytes
  * (without the length prefix), or `null` on clean EOF *before* any bytes
  * of a new frame have been read.
  *
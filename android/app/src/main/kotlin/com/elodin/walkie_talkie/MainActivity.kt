@@ -12,6 +12,7 @@ import android.util.Log
 import android.os.Handler
 import android.os.Looper
 import java.lang.ref.WeakReference
+import java.nio.ByteBuffer
 
 class MainActivity : FlutterActivity() {
     companion object {
@@ -72,12 +73,16 @@ class MainActivity : FlutterActivity() {
     // transitions that happen on the main thread.
     @Volatile private var peerAudioManager: PeerAudioManager? = null
     @Volatile private var audioMixerManager: AudioMixerManager? = null
-    private var isVoiceHost: Boolean = false
+    // Voice settings from Flutter, kept across voice sessions: each
+    // startVoice builds a fresh PeerAudioManager, which starts at the native
+    // defaults until these are applied to it.
+    @Volatile private var lowLatencyProfile: Boolean = false
+    @Volatile private var preRoll: Boolean = false
     // Incremented in stopVoice so any in-flight registerVoicePeer retries
     // from a prior session become no-ops in the new one.
     @Volatile private var voiceSessionId: Int = 0
     // Per-session first-frame sentinels. ConcurrentHashMap.newKeySet gives
-    // a thread-safe Set (mutated from JNI mixer + L2CAP recv threads and
+    // a thread-safe Set (mutated from the L2CAP writer + recv threads and
     // cleared on the main thread in stopVoice).
     private val firstEncodedFramePeers: MutableSet<String> =
         java.util.concurrent.ConcurrentHashMap.newKeySet()
@@ -249,6 +254,26 @@ class MainActivity : FlutterActivity() {
                         result.error("INVALID_ARGUMENT", "macAddress and muted are required", null)
                     }
                 }
+                "setLowLatencyProfile" -> {
+                    val enabled = call.argument<Boolean>("enabled")
+                    if (enabled != null) {
+                        lowLatencyProfile = enabled
+                        peerAudioManager?.setLowLatencyProfile(enabled)
+                        result.success(true)
+                    } else {
+                        result.error("INVALID_ARGUMENT", "enabled is required", null)
+                    }
+                }
+                "setPreRoll" -> {
+                    val enabled = call.argument<Boolean>("enabled")
+                    if (enabled != null) {
+                        preRoll = enabled
+                        peerAudioManager?.setPreRoll(enabled)
+                        result.success(true)
+                    } else {
+                        result.error("INVALID_ARGUMENT", "enabled is required", null)
+                    }
+                }
                 "startAdvertising" -> {
                     val sessionUuid = call.argument<String>("sessionUuid")
                     val displayName = call.argument<String>("displayName")
@@ -428,13 +453,14 @@ class MainActivity : FlutterActivity() {
                     if (bt == null) {
                         result.error("BT_UNAVAILABLE", "BluetoothAdapter is null", null)
                     } else {
-                        isVoiceHost = true
                         if (voiceTransport == null) {
                             voiceTransport = L2capVoiceTransport(
                                 bluetoothAdapter = bt,
-                                onVoiceFrame = { addr, frameBytes ->
-                                    dispatchVoiceFrame(addr, frameBytes)
+                                onVoiceBytes = { addr, stream, buf, len ->
+                                    dispatchVoiceBytes(addr, stream, buf, len)
                                 },
+                                attachOutbound = { addr -> peerAudioManager?.attachOutbound(addr) },
+                                onFirstVoiceFrameSent = { addr -> noteFirstEncodedFrame(addr) },
                                 onClientConnected = { addr ->
                                     registerVoicePeer(addr)
                                     sendEventToFlutter(mapOf(
@@ -471,9 +497,11 @@ class MainActivity : FlutterActivity() {
                             if (voiceTransport == null) {
                                 voiceTransport = L2capVoiceTransport(
                                     bluetoothAdapter = bt,
-                                    onVoiceFrame = { addr, frameBytes ->
-                                        dispatchVoiceFrame(addr, frameBytes)
+                                    onVoiceBytes = { addr, stream, buf, len ->
+                                        dispatchVoiceBytes(addr, stream, buf, len)
                                     },
+                                    attachOutbound = { addr -> peerAudioManager?.attachOutbound(addr) },
+                                    onFirstVoiceFrameSent = { addr -> noteFirstEncodedFrame(addr) },
                                     onClientConnected = {},
                                     onError = { msg ->
                                         sendEventToFlutter(mapOf("type" to "error", "message" to msg))
@@ -537,27 +565,14 @@ class MainActivity : FlutterActivity() {
                     if (mac == null) {
                         result.error("INVALID_ARGUMENT", "macAddress is required", null)
                     } else {
-                        val t = peerAudioManager?.getTelemetry(mac)
-                        if (t == null) {
-                            result.success(null)
-                        } else {
-                            result.success(intArrayOf(
-                                t.underrunCount,
-                                t.lateFrameCount,
-                                t.targetDepthFrames,
-                                t.currentDepthFrames,
-                                t.currentBitrateBps,
-                                t.lostFrameCount,
-                                t.currentLagMs,
-                                t.staleDropCount,
-                                t.recvCount,
-                                t.lastSeq,
-                                t.ringUnderReadCount,
-                                t.ringOverwriteCount,
-                            ))
-                        }
+                        result.success(peerAudioManager?.getTelemetry(mac)?.toIntArray())
                     }
                 }
+                "getRoomTelemetry" -> {
+                    // Every peer in one native snapshot: MAC -> IntArray.
+                    val room = peerAudioManager?.getRoomTelemetry() ?: emptyMap()
+                    result.success(room.mapValues { it.value.toIntArray() })
+                }
                 "setPeerBitrate" -> {
                     val mac = call.argument<String>("macAddress")
                     val bps = call.argument<Int>("bps")
@@ -695,24 +710,13 @@ class MainActivity : FlutterActivity() {
             onResult?.invoke(false)
             return
         }
-        // Init the per-peer manager and wire its outbound callback to L2CAP.
+        // Init the per-peer manager. Outbound audio needs no callback: the
+        // L2CAP writer threads drain each peer's native outbound ring.
         val pm = PeerAudioManager()
         pm.init()
+        pm.setLowLatencyProfile(lowLatencyProfile)
+        pm.setPreRoll(preRoll)
         pm.setCallback(object : PeerAudioManager.AudioCallback {
-            override fun onMixedAudioReady(macAddress: String, opusData: ByteArray, seq: Int) {
-                if (firstEncodedFramePeers.add(macAddress)) {
-                    sendEventToFlutter(mapOf(
-                        "type" to "firstEncodedFrame",
-                        "address" to macAddress,
-                    ))
-                }
-                val frame = buildVoiceFrame(opusData, seq)
-                if (isVoiceHost) {
-                    voiceTransport?.sendToClient(macAddress, frame)
-                } else {
-                    voiceTransport?.sendToHost(frame)
-                }
-            }
             override fun onTalkingPeersChanged(peers: Set<String>) {
                 sendEventToFlutter(mapOf(
                     "type" to "talkingPeers",
@@ -758,36 +762,25 @@ class MainActivity : FlutterActivity() {
         // stopVoiceTransport call-site in the room exit path).
         voiceTransport?.stop()
         voiceTransport = null
-        isVoiceHost = false
     }
 
-    // Parse the 8-byte VoiceFrame header and push the Opus payload into the
-    // native peer manager. Drops silently on malformed or oversized frames.
-    private fun dispatchVoiceFrame(addr: String, frameBytes: ByteArray) {
-        if (frameBytes.size < 8) return
-        val seq = ((frameBytes[0].toInt() and 0xFF) shl 24) or
-                  ((frameBytes[1].toInt() and 0xFF) shl 16) or
-                  ((frameBytes[2].toInt() and 0xFF) shl 8) or
-                  (frameBytes[3].toInt() and 0xFF)
-        // Bytes 4-7: senderTsMs (low 32 bits of the sender's encode-time on a
-        // MONOTONIC clock — SystemClock.elapsedRealtime, ms-since-boot, not
-        // wall-clock; see buildVoiceFrame). Previously parsed-and-discarded; now
-        // forwarded so native can estimate end-to-end staleness and drop frames
-        // that arrived too late.
-        val senderTsMs = ((frameBytes[4].toInt() and 0xFF) shl 24) or
-                         ((frameBytes[5].toInt() and 0xFF) shl 16) or
-                         ((frameBytes[6].toInt() and 0xFF) shl 8) or
-                         (frameBytes[7].toInt() and 0xFF)
-        val opusPayload = frameBytes.copyOfRange(8, frameBytes.size)
-        if (firstDecodedFramePeers.add(addr)) {
+    // Hand raw L2CAP bytes from [addr] to its native stream parser, which
+    // reassembles and validates VoiceFrames and pushes each Opus payload into
+    // the native peer manager. The parser always runs, even before the peer is
+    // registered (handle -1), so the stream's framing stays in step. Returns
+    // the frames parsed, or -1 on a fatal framing error.
+    private fun dispatchVoiceBytes(
+        addr: String,
+        stream: PeerAudioManager.VoiceStream,
+        buf: ByteBuffer,
+        len: Int,
+    ): Int {
+        val handle = peerAudioManager?.peerHandle(addr) ?: -1
+        val frames = stream.ingest(handle, buf, len)
+        if (frames > 0 && firstDecodedFramePeers.add(addr)) {
             sendEventToFlutter(mapOf("type" to "firstDecodedFrame", "address" to addr))
         }
-        peerAudioManager?.onVoiceFrameReceived(
-            addr,
-            opusPayload,
-            seq.toLong() and 0xFFFFFFFFL,
-            senderTsMs.toLong() and 0xFFFFFFFFL,
-        )
+        return frames
     }
 
     // Register addr as a peer in the native manager and add its mixer slot.
@@ -817,26 +810,15 @@ class MainActivity : FlutterActivity() {
         }
     }
 
-    // Encode [opusData] + [seq] into the 8-byte VoiceFrame wire format (big-endian).
-    private fun buildVoiceFrame(opusData: ByteArray, seq: Int): ByteArray {
-        // senderTsMs is a MONOTONIC timestamp (SystemClock.elapsedRealtime, ms
-        // since boot incl. deep sleep), not wall-clock. The receiver's staleness
-        // estimator pairs it with its own monotonic steady_clock; using
-        // System.currentTimeMillis() here would expose senderTsMs to NTP / manual
-        // clock jumps, and a backward jump >= the stale budget would make every
-        // frame look stale and black out audio for a full baseline window.
-        val ts = (android.os.SystemClock.elapsedRealtime() and 0xFFFFFFFFL).toInt()
-        val frame = ByteArray(8 + opusData.size)
-        frame[0] = ((seq ushr 24) and 0xFF).toByte()
-        frame[1] = ((seq ushr 16) and 0xFF).toByte()
-        frame[2] = ((seq ushr 8) and 0xFF).toByte()
-        frame[3] = (seq and 0xFF).toByte()
-        frame[4] = ((ts ushr 24) and 0xFF).toByte()
-        frame[5] = ((ts ushr 16) and 0xFF).toByte()
-        frame[6] = ((ts ushr 8) and 0xFF).toByte()
-        frame[7] = (ts and 0xFF).toByte()
-        System.arraycopy(opusData, 0, frame, 8, opusData.size)
-        return frame
+    // Called on a writer thread when a peer's first outbound frame of the
+    // session reaches the wire.
+    private fun noteFirstEncodedFrame(addr: String) {
+        if (firstEncodedFramePeers.add(addr)) {
+            sendEventToFlutter(mapOf(
+                "type" to "firstEncodedFrame",
+                "address" to addr,
+            ))
+        }
     }
 
     private fun sendEventToFlutter(event: Map<String, Any>) {
@@ -1,20 +1,155 @@
 package com.elodin.walkie_talkie
 
 import android.util.Log
+import java.io.Closeable
+import java.nio.ByteBuffer
+import java.nio.ByteOrder
+import java.util.concurrent.ConcurrentHashMap
 
 class PeerAudioManager {
     companion object {
         private const val TAG = "PeerAudioManager"
 
+        // Mirror audio_config::kTelemetryFieldCount / kPeerHandleSlots: a
+        // telemetry record is the peer's handle plus TELEMETRY_FIELDS ints,
+        // and the board holds one per handle slot. A handle's slot is also
+        // its bit in the native talking mask.
+        const val TELEMETRY_FIELDS = 26
+        private const val TELEMETRY_RECORD_INTS = 1 + TELEMETRY_FIELDS
+        private const val PEER_HANDLE_SLOTS = 16
+
         init {
             System.loadLibrary("walkie_talkie_audio")
         }
+
+        // Native VoiceFrame stream parser (voice_frame_parser.h). Static:
+        // a stream outlives any one PeerAudioManager instance.
+        @JvmStatic private external fun nativeCreateVoiceStream(): Long
+        @JvmStatic private external fun nativeDestroyVoiceStream(stream: Long)
+        @JvmStatic private external fun nativeIngestVoiceStream(
+            stream: Long,
+            handle: Int,
+            buffer: ByteBuffer,
+            length: Int,
+        ): Int
+
+        // Native per-peer outbound ring (outbound_frame_ring.h).
+        @JvmStatic private external fun nativeAttachOutbound(handle: Int): Long
+        @JvmStatic private external fun nativeDetachOutbound(ring: Long)
+        @JvmStatic private external fun nativeOutboundBuffer(ring: Long): ByteBuffer?
+        @JvmStatic private external fun nativeOutboundAcquire(ring: Long, timeoutMs: Int): Int
+        @JvmStatic private external fun nativeOutboundRelease(ring: Long)
+    }
+
+    /**
+     * Native parser for one inbound L2CAP voice byte stream: reassembles the
+     * 2-byte length prefix, validates the VoiceFrame header, and pushes each
+     * frame straight into the native jitter buffer. One per socket, used only
+     * by that socket's receive thread; [close] it when the loop ends.
+     */
+    class VoiceStream : Closeable {
+        private var stream = nativeCreateVoiceStream()
+
+        /**
+         * Parse the first [length] bytes of the direct [buffer] for the peer
+         * with [handle] (see [peerHandle]; -1 drops the frames but keeps the
+         * framing in step). Returns the frames parsed, or -1 on a fatal
+         * framing error — the channel must be closed.
+         */
+        fun ingest(handle: Int, buffer: ByteBuffer, length: Int): Int {
+            if (stream == 0L) return -1
+            return nativeIngestVoiceStream(stream, handle, buffer, length)
+        }
+
+        override fun close() {
+            if (stream != 0L) {
+                nativeDestroyVoiceStream(stream)
+                stream = 0L
+            }
+        }
+    }
+
+    /**
+     * One peer's native outbound ring, claimed by that peer's L2CAP writer
+     * thread. The mixer encodes each frame straight into a ring slot in its
+     * final wire form (length prefix, VoiceFrame header, Opus payload); the
+     * writer [acquire]s the slot's offset in [buffer], writes it to the socket,
+     * and [release]s it. No JNI upcall or allocation per frame.
+     *
+     * Only one writer can hold a peer's ring at a time — [PeerAudioManager.attachOutbound]
+     * returns null until the previous holder has [close]d it.
+     */
+    class OutboundRing internal constructor(private var ring: Long) : Closeable {
+        /** Direct view of the ring's slots; frames sit at [acquire]'s offsets. */
+        val buffer: ByteBuffer = nativeOutboundBuffer(ring)
+            ?: throw IllegalStateException("outbound ring has no buffer")
+
+        /**
+         * Wait up to [timeoutMs] for the next frame. Returns its offset in
+         * [buffer] (the 2-byte length prefix comes first), [EMPTY] on timeout,
+         * or [CLOSED] once the peer is unregistered — [close] and re-attach.
+         */
+        fun acquire(timeoutMs: Int): Int =
+            if (ring == 0L) CLOSED else nativeOutboundAcquire(ring, timeoutMs)
+
+        /** The frame [acquire] returned is on the wire; free its slot. */
+        fun release() {
+            if (ring != 0L) nativeOutboundRelease(ring)
+        }
+
+        override fun close() {
+            if (ring != 0L) {
+                nativeDetachOutbound(ring)
+                ring = 0L
+            }
+        }
+
+        companion object {
+            // Mirror OutboundFrameRing::kEmpty / kClosed.
+            const val EMPTY = -1
+            const val CLOSED = -2
+        }
     }
 
     private var callback: AudioCallback? = null
 
+    // MAC -> native peer handle (the device ID nativeRegisterPeer returns).
+    // The per-frame and polling calls pass the handle, which native resolves
+    // lock-free; an unknown MAC maps to -1, which native treats as an
+    // unregistered peer.
+    private val handles = ConcurrentHashMap<String, Int>()
+
+    private fun handleOf(macAddress: String): Int = handles[macAddress] ?: -1
+
+    // Destination for nativeReadTelemetry, allocated once. Native writes it
+    // in native byte order; guarded by its own monitor so two pollers can't
+    // interleave a read and a parse.
+    private val telemetryBuffer: ByteBuffer =
+        ByteBuffer.allocateDirect(PEER_HANDLE_SLOTS * TELEMETRY_RECORD_INTS * 4)
+            .order(ByteOrder.nativeOrder())
+
+    /** The native handle for [macAddress], or -1 if it isn't registered. */
+    fun peerHandle(macAddress: String): Int = handleOf(macAddress)
+
+    /**
+     * Claim [macAddress]'s outbound ring for the calling writer thread, or
+     * null if the peer isn't registered or another writer still holds it.
+     */
+    fun attachOutbound(macAddress: String): OutboundRing? {
+        val handle = handleOf(macAddress)
+        if (handle < 0) return null
+        val ring = nativeAttachOutbound(handle)
+        if (ring == 0L) return null
+        return try {
+            OutboundRing(ring)
+        } catch (e: IllegalStateException) {
+            nativeDetachOutbound(ring)
+            Log.e(TAG, "attachOutbound($macAddress) failed: ${e.message}")
+            null
+        }
+    }
+
     interface AudioCallback {
-        fun onMixedAudioReady(macAddress: String, opusData: ByteArray, seq: Int)
         fun onTalkingPeersChanged(peers: Set<String>)
     }
 
@@ -25,11 +160,15 @@ class PeerAudioManager {
 
     fun registerPeer(macAddress: String): Int {
         val deviceId = nativeRegisterPeer(macAddress)
+        if (deviceId >= 0) {
+            handles[macAddress] = deviceId
+        }
         Log.i(TAG, "Registered peer $macAddress with device ID $deviceId")
         return deviceId
     }
 
     fun unregisterPeer(macAddress: String) {
+        handles.remove(macAddress)
         nativeUnregisterPeer(macAddress)
         Log.i(TAG, "Unregistered peer $macAddress")
     }
@@ -83,16 +222,61 @@ class PeerAudioManager {
             Log.w(TAG, "Dropping voice frame from $macAddress: senderTsMs=$senderTsMs out of range")
             return
         }
-        nativeOnVoiceFrameReceived(macAddress, opusData, seq, senderTsMs)
+        nativeOnVoiceFrameReceived(handleOf(macAddress), opusData, seq, senderTsMs)
     }
 
     fun clear() {
+        handles.clear()
         nativeClear()
     }
 
     /**
-     * Per-peer link telemetry snapshot — used by the host to drive dynamic
-     * bitrate and by the UI to expose link health. Mirrors the C++
+     * Decode inbound frames on arrival (on the calling receive thread) instead
+     * of on the native mixer tick. Spreads Opus decode across the per-peer
+     * receive threads and shortens the tick; loss concealment still happens
+     * at playout time. Off by default; safe to toggle mid-session.
+     */
+    fun setDecodeOnArrival(enabled: Boolean) {
+        nativeSetDecodeOnArrival(enabled)
+        Log.i(TAG, "Decode on arrival: $enabled")
+    }
+
+    /**
+     * Stop sending each peer its mix while that mix is silent (Opus DTX in
+     * the hangover, comfort noise on the far end), instead of only once the
+     * whole room is quiet. On by default; safe to toggle mid-session.
+     */
+    fun setSilenceSuppression(enabled: Boolean) {
+        nativeSetSilenceSuppression(enabled)
+        Log.i(TAG, "Silence suppression: $enabled")
+    }
+
+    /**
+     * Ask the room for 10 ms frames and a 10 ms mixer tick instead of 20 ms:
+     * roughly half the framing and buffering latency, for same-room groups on
+     * a clean link. The room only switches once every peer has asked too,
+     * and switches back when one stops. Off by default; safe to toggle
+     * mid-session.
+     */
+    fun setLowLatencyProfile(enabled: Boolean) {
+        nativeSetLowLatencyProfile(enabled)
+        Log.i(TAG, "Low-latency profile: $enabled")
+    }
+
+    /**
+     * Push-to-talk pre-roll: when a talkspurt opens on a keyed mic, send the
+     * ~120 ms the mic heard just before it first, so the first syllable isn't
+     * clipped. Receivers play the short backlog slightly fast to catch up.
+     * Off by default; safe to toggle mid-session.
+     */
+    fun setPreRoll(enabled: Boolean) {
+        nativeSetPreRoll(enabled)
+        Log.i(TAG, "Pre-roll: $enabled")
+    }
+
+    /**
+     * Per-peer link telemetry snapshot — used by the LinkQuality reporter
+     * and by the UI to expose link health. Mirrors the C++
      * PeerAudioManager::LinkTelemetry struct (peer_audio_manager.h).
      *
      * `underrunCount` and `lateFrameCount` are lifetime totals; subtract
@@ -107,7 +291,7 @@ class PeerAudioManager {
         val targetDepthFrames: Int,
         val currentDepthFrames: Int,
         val currentBitrateBps: Int,
-        // True network loss (seq-gap). Drives bitrate adaptation; lateFrameCount
+        // True network loss (seq-gap). Drives bitrate control; lateFrameCount
         // is kept for observability only.
         val lostFrameCount: Int,
         // End-to-end staleness telemetry for the debug dashboard.
@@ -124,20 +308,76 @@ class PeerAudioManager {
         val ringUnderReadCount: Int,
         // Lifetime count of partial ring writes (producer faster than consumer).
         val ringOverwriteCount: Int,
-    )
+        // Estimated peer-clock skew vs ours in ppm (positive = peer fast);
+        // 0 until the native drift estimator converges. Signed.
+        val clockDriftPpm: Int,
+        // Mixer-tick scheduling health, mixer-wide (same on every peer): p99
+        // wake lateness and p99 tick work over the last 5 s window, in µs,
+        // plus lifetime ticks that overran into the next deadline.
+        val tickLateP99Us: Int,
+        val tickWorkP99Us: Int,
+        val tickOverrunCount: Int,
+        // Frames the receive path couldn't queue for the native mixer.
+        val arrivalDropCount: Int,
+        // Outbound ring: frames shed by the writer as stale or over-backlog,
+        // frames dropped because the writer held every slot, frames queued now.
+        val outboundStaleDropCount: Int,
+        val outboundFullDropCount: Int,
+        val outboundDepth: Int,
+        // Encodes the mixer skipped while this peer's outbound ring was congested.
+        val outboundSkipCount: Int,
+        // Native bitrate controller: lifetime backoffs, and the expected loss
+        // (%) it last gave the encoder. currentBitrateBps is its output.
+        val bitrateBackoffCount: Int,
+        val expectedLossPct: Int,
+        // Frames per outbound VoiceFrame (1 = unbundled; see voice_bundle.h).
+        val outboundFramesPerPacket: Int,
+        // Tick CPU governor (tick_governor.h): this link's encoder complexity,
+        // and the room-wide governor level.
+        val encoderComplexity: Int,
+        val governorLevel: Int,
+    ) {
+        /** The fields in native marshalTelemetry() order, for the method channel. */
+        fun toIntArray(): IntArray = intArrayOf(
+            underrunCount,
+            lateFrameCount,
+            targetDepthFrames,
+            currentDepthFrames,
+            currentBitrateBps,
+            lostFrameCount,
+            currentLagMs,
+            staleDropCount,
+            recvCount,
+            lastSeq,
+            ringUnderReadCount,
+            ringOverwriteCount,
+            clockDriftPpm,
+            tickLateP99Us,
+            tickWorkP99Us,
+            tickOverrunCount,
+            arrivalDropCount,
+            outboundStaleDropCount,
+            outboundFullDropCount,
+            outboundDepth,
+            outboundSkipCount,
+            bitrateBackoffCount,
+            expectedLossPct,
+            outboundFramesPerPacket,
+            encoderComplexity,
+            governorLevel,
+        )
+    }
 
     /**
-     * Adjust this peer's outbound encoder bitrate. The native side clamps to
-     * the {Low, Mid, High} range from audio_config.h. Returns the actual
-     * bitrate applied (after clamping), or -1 if the peer isn't registered.
-     *
-     * Intended caller: a future LinkQuality reporter that polls
-     * [getTelemetry] and steps bitrate down on sustained loss / underruns,
-     * back up on a clean window. Today no automated caller exists; this is
-     * scaffolding so the BLE control plane has a target API to wire to.
+     * Cap this peer's outbound encoder bitrate — a BitrateHint from the
+     * LinkQuality plane. The native per-peer controller picks the bitrate
+     * itself, within [Low, this cap] (audio_config.h), from backpressure,
+     * loss and lag it measures every few hundred ms; a cap below the current
+     * bitrate applies at once. Returns the bitrate in effect, or -1 if the
+     * peer isn't registered. Its decisions come back through [getTelemetry].
      */
     fun setPeerBitrate(macAddress: String, bps: Int): Int {
-        val applied = nativeSetPeerBitrate(macAddress, bps)
+        val applied = nativeSetPeerBitrate(handleOf(macAddress), bps)
         if (applied < 0) {
             Log.w(TAG, "setPeerBitrate($macAddress, $bps) failed: peer not registered")
         }
@@ -145,46 +385,96 @@ class PeerAudioManager {
     }
 
     fun setPeerVolume(macAddress: String, volume: Float) {
-        nativeSetPeerVolume(macAddress, volume)
+        nativeSetPeerVolume(handleOf(macAddress), volume)
     }
 
     fun setPeerMuted(macAddress: String, muted: Boolean) {
-        nativeSetPeerMuted(macAddress, muted)
+        nativeSetPeerMuted(handleOf(macAddress), muted)
+    }
+
+    /**
+     * Every registered peer's telemetry, by MAC, in one native call. The mixer
+     * publishes it to a lock-free board every 100 ms, so polling never
+     * contends with audio; a peer registered in the last 100 ms may be
+     * missing.
+     */
+    fun getRoomTelemetry(): Map<String, LinkTelemetry> {
+        val macs = HashMap<Int, String>()
+        for ((mac, handle) in handles) macs[handle] = mac
+        val room = HashMap<String, LinkTelemetry>()
+        synchronized(telemetryBuffer) {
+            val count = nativeReadTelemetry(telemetryBuffer)
+            for (i in 0 until count) {
+                val base = i * TELEMETRY_RECORD_INTS * 4
+                val mac = macs[telemetryBuffer.getInt(base)] ?: continue
+                room[mac] = parseTelemetry(base + 4)
+            }
+        }
+        return room
     }
 
-    /** Returns null if the peer isn't registered. */
+    /** Returns null if the peer isn't registered (or not yet published). */
     fun getTelemetry(macAddress: String): LinkTelemetry? {
-        val raw = nativeGetTelemetry(macAddress) ?: return null
-        if (raw.size != 12) {
-            Log.w(TAG, "getTelemetry returned unexpected array size ${raw.size}")
-            return null
+        val handle = handleOf(macAddress)
+        if (handle < 0) return null
+        synchronized(telemetryBuffer) {
+            val count = nativeReadTelemetry(telemetryBuffer)
+            for (i in 0 until count) {
+                val base = i * TELEMETRY_RECORD_INTS * 4
+                if (telemetryBuffer.getInt(base) == handle) {
+                    return parseTelemetry(base + 4)
+                }
+            }
         }
-        return LinkTelemetry(
-            underrunCount = raw[0],
-            lateFrameCount = raw[1],
-            targetDepthFrames = raw[2],
-            currentDepthFrames = raw[3],
-            currentBitrateBps = raw[4],
-            lostFrameCount = raw[5],
-            currentLagMs = raw[6],
-            staleDropCount = raw[7],
-            recvCount = raw[8],
-            lastSeq = raw[9],
-            ringUnderReadCount = raw[10],
-            ringOverwriteCount = raw[11],
-        )
+        return null
     }
 
-    // Called from native code (JNI callback)
-    @Suppress("unused")
-    private fun onMixedAudioReady(macAddress: String, opusData: ByteArray, seq: Int) {
-        callback?.onMixedAudioReady(macAddress, opusData, seq)
+    // One record's fields, starting at byte [offset] of telemetryBuffer.
+    private fun parseTelemetry(offset: Int): LinkTelemetry {
+        fun field(i: Int) = telemetryBuffer.getInt(offset + i * 4)
+        return LinkTelemetry(
+            underrunCount = field(0),
+            lateFrameCount = field(1),
+            targetDepthFrames = field(2),
+            currentDepthFrames = field(3),
+            currentBitrateBps = field(4),
+            lostFrameCount = field(5),
+            currentLagMs = field(6),
+            staleDropCount = field(7),
+            recvCount = field(8),
+            lastSeq = field(9),
+            ringUnderReadCount = field(10),
+            ringOverwriteCount = field(11),
+            clockDriftPpm = field(12),
+            tickLateP99Us = field(13),
+            tickWorkP99Us = field(14),
+            tickOverrunCount = field(15),
+            arrivalDropCount = field(16),
+            outboundStaleDropCount = field(17),
+            outboundFullDropCount = field(18),
+            outboundDepth = field(19),
+            outboundSkipCount = field(20),
+            bitrateBackoffCount = field(21),
+            expectedLossPct = field(22),
+            outboundFramesPerPacket = field(23),
+            encoderComplexity = field(24),
+            governorLevel = field(25),
+        )
     }
 
-    // Called from native code (JNI callback) when any peer's VAD state changes.
+    // Called from native code (the talking-set notifier thread, never the
+    // mixer tick) when the set of talking peers changes. Bit
+    // (handle % PEER_HANDLE_SLOTS) is set for each talking peer; we map bits
+    // back to MACs through our own handle table.
     @Suppress("unused")
-    private fun onTalkingPeersChanged(peers: Array<String>) {
-        callback?.onTalkingPeersChanged(peers.toSet())
+    private fun onTalkingMaskChanged(mask: Int) {
+        val talking = HashSet<String>()
+        for ((mac, handle) in handles) {
+            if (mask and (1 shl (handle and (PEER_HANDLE_SLOTS - 1))) != 0) {
+                talking.add(mac)
+            }
+        }
+        callback?.onTalkingPeersChanged(talking)
     }
 
     // Native methods
@@ -195,9 +485,13 @@ class PeerAudioManager {
     private external fun nativeStopMixerThread()
     private external fun nativeSetCallback(callback: Any)
     private external fun nativeClear()
-    private external fun nativeOnVoiceFrameReceived(macAddress: String, opusData: ByteArray, seq: Long, senderTsMs: Long)
-    private external fun nativeSetPeerBitrate(macAddress: String, bps: Int): Int
-    private external fun nativeGetTelemetry(macAddress: String): IntArray?
-    private external fun nativeSetPeerVolume(macAddress: String, volume: Float)
-    private external fun nativeSetPeerMuted(macAddress: String, muted: Boolean)
+    private external fun nativeOnVoiceFrameReceived(handle: Int, opusData: ByteArray, seq: Long, senderTsMs: Long)
+    private external fun nativeSetPeerBitrate(handle: Int, bps: Int): Int
+    private external fun nativeReadTelemetry(dst: ByteBuffer): Int
+    private external fun nativeSetPeerVolume(handle: Int, volume: Float)
+    private external fun nativeSetPeerMuted(handle: Int, muted: Boolean)
+    private external fun nativeSetDecodeOnArrival(enabled: Boolean)
+    private external fun nativeSetSilenceSuppression(enabled: Boolean)
+    private external fun nativeSetLowLatencyProfile(enabled: Boolean)
+    private external fun nativeSetPreRoll(enabled: Boolean)
 }
@@ -12,7 +12,7 @@ import '../theme/app_theme.dart';
 
 /// In-app voice debug dashboard.
 ///
-/// Polls per-peer link telemetry from the native `PeerAudioManager` on a timer,
+/// Polls the room's link telemetry from the native `PeerAudioManager` on a timer,
 /// feeds it through a [VoiceTelemetryMonitor], and renders the live picture a
 /// human watching a struggling call wants: receive throughput (should sit near
 /// 50/s), the current head-of-stream seq, end-to-end staleness (lag) now and on
@@ -79,6 +79,11 @@ class _VoiceDebugDashboardScreenState extends State<VoiceDebugDashboardScreen> {
       final state = widget.cubit.state;
       final active = <String>{};
       if (state is SessionRoom) {
+        // One native snapshot covers every peer, so a big room costs one
+        // platform round-trip per poll — and all peers share one timestamp.
+        final room = await widget.audioService.getRoomTelemetry();
+        if (!mounted) return;
+        final sampleMs = DateTime.now().millisecondsSinceEpoch;
         for (final peer in state.roster) {
           // Resolve each roster peer to a MAC. Our own entry (and peers we
           // have no L2CAP link to) resolve to null and are skipped, so the
@@ -86,13 +91,8 @@ class _VoiceDebugDashboardScreenState extends State<VoiceDebugDashboardScreen> {
           final mac = widget.cubit.macForPeerId(peer.peerId);
           if (mac == null) continue;
           active.add(peer.peerId);
-          final snap = await widget.audioService.getLinkTelemetry(mac);
-          if (!mounted) return;
+          final snap = room[mac];
           if (snap != null) {
-            // Stamp per-snapshot, not once before the loop: getLinkTelemetry is
-            // awaited serially, so a shared pre-loop timestamp would record
-            // later peers with too-early a time and skew their derived rates.
-            final sampleMs = DateTime.now().millisecondsSinceEpoch;
             _monitor.add(peer.peerId, snap, sampleMs);
             _labels[peer.peerId] = peer.displayName;
           }
@@ -8,11 +8,11 @@ import 'package:flutter/foundation.dart';
 /// wall-clock to get the rates the protocol's `LinkQuality` carries.
 @immutable
 class LinkTelemetrySnapshot {
-  /// Number of int fields the native `nativeGetTelemetry` marshals into the
-  /// IntArray, kept in lockstep with the `kTelemetryFieldCount` constant in
-  /// `android/app/src/main/cpp/peer_audio_manager.cpp`. New fields are
-  /// appended, so this is the single number both sides bump together.
-  static const int fieldCount = 12;
+  /// Number of int fields native `PeerAudioManager::marshalTelemetry`
+  /// emits per peer, kept in lockstep with `audio_config::kTelemetryFieldCount`
+  /// (`android/app/src/main/cpp/audio_config.h`). New fields are appended, so
+  /// this is the single number both sides bump together.
+  static const int fieldCount = 26;
 
   /// Lifetime mixer-tick underruns for this peer's stream.
   final int underrunCount;
@@ -66,6 +66,67 @@ class LinkTelemetrySnapshot {
   /// value means the playout consumer is falling behind the producer.
   final int ringOverwriteCount;
 
+  /// Estimated skew of the peer's encode clock against ours, in ppm
+  /// (positive = the peer's clock runs fast). The native drift resampler
+  /// consumes the peer's audio at this rate so the jitter buffer stays flat.
+  /// Reads 0 until the native estimator has ~10 s of stream to fit. Signed.
+  final int clockDriftPpm;
+
+  /// p99 of how late the native mixer tick woke past its deadline, in µs,
+  /// over the last completed 5 s stats window. Mixer-wide: every peer's
+  /// snapshot carries the same value. Tick jitter has to be absorbed by the
+  /// jitter buffer and the playout ring, so this is the number to watch when
+  /// depth or underruns look wrong on a particular device.
+  final int tickLateP99Us;
+
+  /// p99 of the native mixer tick's work time (decode, mix-minus, encode),
+  /// in µs, over the same window. Mixer-wide.
+  final int tickWorkP99Us;
+
+  /// Lifetime count of mixer ticks whose lateness plus work ran past the next
+  /// tick's deadline. Mixer-wide.
+  final int tickOverrunCount;
+
+  /// Lifetime frames the receive path couldn't queue for the native mixer
+  /// (its per-peer arrival queue was full). Non-zero means the mixer tick fell
+  /// a whole queue behind the radio.
+  final int arrivalDropCount;
+
+  /// Lifetime outbound frames the L2CAP writer shed as stale or over-backlog
+  /// before sending — our uplink toward this peer can't keep up.
+  final int outboundStaleDropCount;
+
+  /// Lifetime outbound frames dropped because the writer still held every
+  /// ring slot (stuck in a blocking socket write).
+  final int outboundFullDropCount;
+
+  /// Outbound frames queued for this peer right now.
+  final int outboundDepth;
+
+  /// Lifetime encodes the mixer skipped because this peer's outbound queue
+  /// was congested — backpressure, rather than encoding frames to shed.
+  final int outboundSkipCount;
+
+  /// Lifetime multiplicative backoffs by the native bitrate controller.
+  /// [currentBitrateBps] is the controller's current decision.
+  final int bitrateBackoffCount;
+
+  /// The expected packet loss (%) the native controller last handed the
+  /// encoder — its smoothed view of loss on this link.
+  final int expectedLossPct;
+
+  /// Opus frames the native encoder currently packs into each outbound
+  /// VoiceFrame: 1 normally, 2–3 while it bundles on a congested link.
+  final int outboundFramesPerPacket;
+
+  /// Opus complexity (0–10) the native encoder for this link runs at: 10
+  /// until the tick CPU governor steps it down.
+  final int encoderComplexity;
+
+  /// The tick CPU governor's level, 0 (everything at full quality) up to 4.
+  /// Room-wide, so every peer's snapshot carries the same value.
+  final int governorLevel;
+
   const LinkTelemetrySnapshot({
     required this.underrunCount,
     required this.lateFrameCount,
@@ -79,8 +140,68 @@ class LinkTelemetrySnapshot {
     required this.lastSeq,
     this.ringUnderReadCount = 0,
     this.ringOverwriteCount = 0,
+    this.clockDriftPpm = 0,
+    this.tickLateP99Us = 0,
+    this.tickWorkP99Us = 0,
+    this.tickOverrunCount = 0,
+    this.arrivalDropCount = 0,
+    this.outboundStaleDropCount = 0,
+    this.outboundFullDropCount = 0,
+    this.outboundDepth = 0,
+    this.outboundSkipCount = 0,
+    this.bitrateBackoffCount = 0,
+    this.expectedLossPct = 0,
+    this.outboundFramesPerPacket = 1,
+    this.encoderComplexity = 10,
+    this.governorLevel = 0,
   });
 
+  /// Parse one peer's native int fields (see [fieldCount]), or null if [raw]
+  /// isn't a list of exactly that many ints.
+  ///
+  /// Accepts `dynamic` rather than `List<int>`: the StandardMessageCodec
+  /// encodes Kotlin `IntArray` as `Int32List`, which does *not* satisfy
+  /// `is List<dynamic>` in every Dart runtime path — a typed-list cast can
+  /// throw before the elements even reach the parsing logic. Validating the
+  /// shape here works for both `Int32List` and plain `List`, and rejects a
+  /// truncated or padded response from a stale platform handler.
+  static LinkTelemetrySnapshot? fromFields(dynamic raw) {
+    if (raw is! List || raw.length != fieldCount) return null;
+    final values = raw.map((e) => e is int ? e : null).toList();
+    if (values.any((v) => v == null)) return null;
+    // uint32 counters cross JNI as jint, so values in [2^31, 2^32) arrive
+    // negative; toUnsigned(32) restores them.
+    return LinkTelemetrySnapshot(
+      underrunCount: values[0]!,
+      lateFrameCount: values[1]!,
+      targetDepthFrames: values[2]!,
+      currentDepthFrames: values[3]!,
+      currentBitrateBps: values[4]!,
+      lostFrameCount: values[5]!,
+      currentLagMs: values[6]!.toUnsigned(32),
+      staleDropCount: values[7]!,
+      recvCount: values[8]!.toUnsigned(32),
+      lastSeq: values[9]!.toUnsigned(32),
+      ringUnderReadCount: values[10]!.toUnsigned(32),
+      ringOverwriteCount: values[11]!.toUnsigned(32),
+      // Signed: a slow peer clock reads negative.
+      clockDriftPpm: values[12]!,
+      tickLateP99Us: values[13]!.toUnsigned(32),
+      tickWorkP99Us: values[14]!.toUnsigned(32),
+      tickOverrunCount: values[15]!.toUnsigned(32),
+      arrivalDropCount: values[16]!.toUnsigned(32),
+      outboundStaleDropCount: values[17]!.toUnsigned(32),
+      outboundFullDropCount: values[18]!.toUnsigned(32),
+      outboundDepth: values[19]!.toUnsigned(32),
+      outboundSkipCount: values[20]!.toUnsigned(32),
+      bitrateBackoffCount: values[21]!.toUnsigned(32),
+      expectedLossPct: values[22]!,
+      outboundFramesPerPacket: values[23]!.toUnsigned(32),
+      encoderComplexity: values[24]!.toUnsigned(32),
+      governorLevel: values[25]!.toUnsigned(32),
+    );
+  }
+
   @override
   bool operator ==(Object other) =>
       identical(this, other) ||
@@ -96,10 +217,24 @@ class LinkTelemetrySnapshot {
           recvCount == other.recvCount &&
           lastSeq == other.lastSeq &&
           ringUnderReadCount == other.ringUnderReadCount &&
-          ringOverwriteCount == other.ringOverwriteCount;
+          ringOverwriteCount == other.ringOverwriteCount &&
+          clockDriftPpm == other.clockDriftPpm &&
+          tickLateP99Us == other.tickLateP99Us &&
+          tickWorkP99Us == other.tickWorkP99Us &&
+          tickOverrunCount == other.tickOverrunCount &&
+          arrivalDropCount == other.arrivalDropCount &&
+          outboundStaleDropCount == other.outboundStaleDropCount &&
+          outboundFullDropCount == other.outboundFullDropCount &&
+          outboundDepth == other.outboundDepth &&
+          outboundSkipCount == other.outboundSkipCount &&
+          bitrateBackoffCount == other.bitrateBackoffCount &&
+          expectedLossPct == other.expectedLossPct &&
+          outboundFramesPerPacket == other.outboundFramesPerPacket &&
+          encoderComplexity == other.encoderComplexity &&
+          governorLevel == other.governorLevel;
 
   @override
-  int get hashCode => Object.hash(
+  int get hashCode => Object.hashAll([
     underrunCount,
     lateFrameCount,
     lostFrameCount,
@@ -112,7 +247,21 @@ class LinkTelemetrySnapshot {
     lastSeq,
     ringUnderReadCount,
     ringOverwriteCount,
-  );
+    clockDriftPpm,
+    tickLateP99Us,
+    tickWorkP99Us,
+    tickOverrunCount,
+    arrivalDropCount,
+    outboundStaleDropCount,
+    outboundFullDropCount,
+    outboundDepth,
+    outboundSkipCount,
+    bitrateBackoffCount,
+    expectedLossPct,
+    outboundFramesPerPacket,
+    encoderComplexity,
+    governorLevel,
+  ]);
 }
 
 /// Service for communicating with native Android audio layer
@@ -288,6 +437,26 @@ class AudioService {
     {'macAddress': macAddress, 'muted': muted},
   );
 
+  /// Ask the room for 10 ms frames instead of 20 ms: roughly half the
+  /// framing and buffering latency, for same-room groups on a clean link.
+  /// The room only switches once every peer has asked too. Remembered
+  /// across voice sessions; off until set.
+  Future<bool> setLowLatencyProfile(bool enabled) => _invokeBool(
+    'setLowLatencyProfile',
+    'setting low-latency profile to $enabled',
+    {'enabled': enabled},
+  );
+
+  /// Push-to-talk pre-roll: when a talkspurt opens on keyed local voice,
+  /// send the ~120 ms of mic audio just before it first, so the first
+  /// syllable isn't clipped. Peers told about it speed through the burst.
+  /// Remembered across voice sessions; off until set.
+  Future<bool> setPreRoll(bool enabled) => _invokeBool(
+    'setPreRoll',
+    'setting pre-roll to $enabled',
+    {'enabled': enabled},
+  );
+
   /// Set the audio output routing for the voice stream.
   ///
   /// Routes the mixed audio output to the specified device type:
@@ -608,40 +777,13 @@ class AudioService {
   /// missed telemetry sample is non-fatal to the link.
   Future<LinkTelemetrySnapshot?> getLinkTelemetry(String macAddress) async {
     try {
-      // `invokeMethod<dynamic>` rather than `<List<dynamic>>`: the
-      // StandardMessageCodec encodes Kotlin `IntArray` as `Int32List`,
-      // which does *not* satisfy `is List<dynamic>` in every Dart
-      // runtime path — a typed-list cast can throw before the elements
-      // even reach the parsing logic. Accepting `dynamic` and validating
-      // the shape ourselves works for both `Int32List` and plain `List`.
+      // `invokeMethod<dynamic>` — see [LinkTelemetrySnapshot.fromFields] for
+      // why the typed-list form isn't safe here.
       final raw = await _methodChannel.invokeMethod<dynamic>(
         'getLinkTelemetry',
         <String, dynamic>{'macAddress': macAddress},
       );
-      if (raw is! List || raw.length != LinkTelemetrySnapshot.fieldCount) {
-        return null;
-      }
-      // Native returns a 12-element int array: [underruns, late, target,
-      // current, bitrate, lost, lagMs, staleDrops, recv, lastSeq,
-      // ringUnderReadCount, ringOverwriteCount]. New fields are appended so
-      // the historical 0-10 layout is undisturbed. Element-wise check guards
-      // against a truncated or padded response from a stale platform handler.
-      final values = raw.map((e) => e is int ? e : null).toList();
-      if (values.any((v) => v == null)) return null;
-      return LinkTelemetrySnapshot(
-        underrunCount: values[0]!,
-        lateFrameCount: values[1]!,
-        targetDepthFrames: values[2]!,
-        currentDepthFrames: values[3]!,
-        currentBitrateBps: values[4]!,
-        lostFrameCount: values[5]!,
-        currentLagMs: values[6]!.toUnsigned(32),
-        staleDropCount: values[7]!,
-        recvCount: values[8]!.toUnsigned(32),
-        lastSeq: values[9]!.toUnsigned(32),
-        ringUnderReadCount: values[10]!.toUnsigned(32),
-        ringOverwriteCount: values[11]!.toUnsigned(32),
-      );
+      return LinkTelemetrySnapshot.fromFields(raw);
     } catch (e) {
       if (kDebugMode) {
         debugPrint('Error getting link telemetry for $macAddress: $e');
@@ -650,15 +792,43 @@ class AudioService {
     }
   }
 
-  /// Adjust the per-peer outbound encoder bitrate. The native
-  /// `PeerAudioManager` clamps to {Low=16, Mid=32, High=48} kbps from
-  /// `audio_config.h`; out-of-band values get snapped to the nearest.
+  /// Every registered peer's telemetry, keyed by MAC, from one native
+  /// snapshot. Prefer this to per-peer [getLinkTelemetry] calls when polling
+  /// several peers: the native side copies the whole room out of a lock-free
+  /// board the mixer publishes every 100 ms, so a poll costs one platform
+  /// round-trip and never contends with audio. Entries that fail to parse are
+  /// dropped; any platform failure yields an empty map.
+  Future<Map<String, LinkTelemetrySnapshot>> getRoomTelemetry() async {
+    try {
+      final raw = await _methodChannel.invokeMethod<dynamic>(
+        'getRoomTelemetry',
+      );
+      if (raw is! Map) return const {};
+      final room = <String, LinkTelemetrySnapshot>{};
+      raw.forEach((mac, fields) {
+        if (mac is! String) return;
+        final snap = LinkTelemetrySnapshot.fromFields(fields);
+        if (snap != null) room[mac] = snap;
+      });
+      return room;
+    } catch (e) {
+      if (kDebugMode) debugPrint('Error getting room telemetry: $e');
+      return const {};
+    }
+  }
+
+  /// Cap the per-peer outbound encoder bitrate. The native
+  /// `PeerAudioManager` runs its own per-link controller (backpressure,
+  /// loss, lag gradient, every few hundred ms) and keeps the encoder within
+  /// [16 kbps, this cap]; a cap below the current bitrate applies at once,
+  /// a higher one is climbed to only as the link allows. The controller's
+  /// decisions come back through [getLinkTelemetry] (`currentBitrateBps`,
+  /// `bitrateBackoffCount`, `expectedLossPct`, `outboundFramesPerPacket`).
   ///
-  /// Returns the bitrate actually applied (after clamping), or `null` if
-  /// the call fails (peer not registered, native handler missing). The
-  /// bitrate adapter on the host calls this to adjust its own encoder
-  /// toward a guest; a guest receiving a `BitrateHint` calls this with
-  /// the host's MAC to throttle its uplink.
+  /// Returns the bitrate in effect, or `null` if the call fails (peer not
+  /// registered, native handler missing). The bitrate adapter on the host
+  /// calls this to cap its own encoder toward a guest; a guest receiving a
+  /// `BitrateHint` calls this with the host's MAC to cap its uplink.
   Future<int?> setPeerBitrate(String macAddress, int bps) async {
     try {
       final result = await _methodChannel.invokeMethod<int>(
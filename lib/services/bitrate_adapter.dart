@@ -43,10 +43,17 @@ enum BitrateLevel {
 }
 
 /// Host-side stateful adapter that consumes per-peer `LinkQuality` samples
-/// and decides when to step the encoder bitrate up or down. Pure logic —
-/// the cubit owns the actual `BitrateHint` send and the local
+/// and decides when to step the encoder bitrate **ceiling** up or down. Pure
+/// logic — the cubit owns the actual `BitrateHint` send and the local
 /// `setPeerBitrate` call against the native `PeerAudioManager`.
 ///
+/// **Ceiling, not setpoint.** The native per-link `BitrateController` moves
+/// the encoder itself every 300 ms on backpressure, loss and lag gradient —
+/// far faster than a 2 s reporter and 4 s dwell could. What this adapter
+/// adds is the *receiver's* view of the link (a guest's `LinkQuality`),
+/// which the sender can't measure; it bounds the native controller from
+/// above. The controller's decisions show in telemetry (`currentBitrateBps`).
+///
 /// **Threshold schedule** (per [docs/protocol.md] §"adaptive bitrate"):
 ///   * `lossPct > 12 %` sustained for [downHoldMid] → step to [BitrateLevel.low]
 ///     (16 kbps). Aggressive — we want to bail quickly when the
@@ -13,6 +13,21 @@ for required in \
     test/cpp/talking_event_queue_test.cpp \
     test/cpp/ring_buffer_test.cpp \
     test/cpp/playout_lag_estimator_test.cpp \
+    test/cpp/clock_drift_estimator_test.cpp \
+    test/cpp/tick_histogram_test.cpp \
+    test/cpp/voice_frame_parser_test.cpp \
+    test/cpp/outbound_frame_ring_test.cpp \
+    test/cpp/arrival_queue_test.cpp \
+    test/cpp/telemetry_board_test.cpp \
+    test/cpp/talking_state_test.cpp \
+    test/cpp/bitrate_controller_test.cpp \
+    test/cpp/voice_bundle_test.cpp \
+    test/cpp/voice_header_test.cpp \
+    test/cpp/comfort_noise_test.cpp \
+    test/cpp/opus_silence_test.cpp \
+    test/cpp/tick_governor_test.cpp \
+    test/cpp/opus_toc_test.cpp \
+    test/cpp/pre_roll_ring_test.cpp \
     test/cpp/opus_codec_test.cpp \
     test/cpp/vad_detector_test.cpp \
     test/cpp/playback_stream_config_test.cpp \
@@ -28,7 +43,22 @@ for required in \
     android/app/src/main/cpp/peer_audio_manager.h \
     android/app/src/main/cpp/jitter_buffer.cpp \
     android/app/src/main/cpp/jitter_buffer.h \
-    android/app/src/main/cpp/playout_lag_estimator.h; do
+    android/app/src/main/cpp/playout_lag_estimator.h \
+    android/app/src/main/cpp/clock_drift_estimator.h \
+    android/app/src/main/cpp/tick_histogram.h \
+    android/app/src/main/cpp/voice_frame_parser.h \
+    android/app/src/main/cpp/outbound_frame_ring.h \
+    android/app/src/main/cpp/arrival_queue.h \
+    android/app/src/main/cpp/telemetry_board.h \
+    android/app/src/main/cpp/talking_state.h \
+    android/app/src/main/cpp/bitrate_controller.h \
+    android/app/src/main/cpp/voice_bundle.h \
+    android/app/src/main/cpp/voice_header.h \
+    android/app/src/main/cpp/comfort_noise.h \
+    android/app/src/main/cpp/opus_silence.h \
+    android/app/src/main/cpp/tick_governor.h \
+    android/app/src/main/cpp/opus_toc.h \
+    android/app/src/main/cpp/pre_roll_ring.h; do
   if [ ! -f "$required" ]; then
     echo "$required missing — failing fast"
     exit 1
@@ -90,6 +120,141 @@ ${CXX:-g++} -std=c++17 -Wall -Wextra -pthread \
     -o build/cpp_test/playout_lag_estimator_test
 build/cpp_test/playout_lag_estimator_test
 
+# clock_drift_estimator_test exercises header-only clock_drift_estimator.h —
+# the per-peer sender-clock skew fit behind the drift-correcting resampler.
+${CXX:-g++} -std=c++17 -Wall -Wextra -pthread \
+    -I test/cpp \
+    -I android/app/src/main/cpp \
+    test/cpp/clock_drift_estimator_test.cpp \
+    -o build/cpp_test/clock_drift_estimator_test
+build/cpp_test/clock_drift_estimator_test
+
+# tick_histogram_test exercises header-only tick_histogram.h — the lock-free
+# wake-lateness / work-time histogram behind the mixer tick's jitter telemetry.
+${CXX:-g++} -std=c++17 -Wall -Wextra -pthread \
+    -I test/cpp \
+    -I android/app/src/main/cpp \
+    test/cpp/tick_histogram_test.cpp \
+    -o build/cpp_test/tick_histogram_test
+build/cpp_test/tick_histogram_test
+
+# voice_frame_parser_test exercises header-only voice_frame_parser.h — the
+# native L2CAP length-prefix reassembly and VoiceFrame header validation.
+${CXX:-g++} -std=c++17 -Wall -Wextra -pthread \
+    -I test/cpp \
+    -I android/app/src/main/cpp \
+    test/cpp/voice_frame_parser_test.cpp \
+    -o build/cpp_test/voice_frame_parser_test
+build/cpp_test/voice_frame_parser_test
+
+# outbound_frame_ring_test exercises header-only outbound_frame_ring.h — the
+# per-peer SPSC ring of wire-ready VoiceFrames the L2CAP writers drain.
+${CXX:-g++} -std=c++17 -Wall -Wextra -pthread \
+    -I test/cpp \
+    -I android/app/src/main/cpp \
+    test/cpp/outbound_frame_ring_test.cpp \
+    -o build/cpp_test/outbound_frame_ring_test
+build/cpp_test/outbound_frame_ring_test
+
+# arrival_queue_test exercises header-only arrival_queue.h — the per-peer
+# SPSC hand-off from the receive threads to the mixer tick.
+${CXX:-g++} -std=c++17 -Wall -Wextra -pthread \
+    -I test/cpp \
+    -I android/app/src/main/cpp \
+    test/cpp/arrival_queue_test.cpp \
+    -o build/cpp_test/arrival_queue_test
+build/cpp_test/arrival_queue_test
+
+# telemetry_board_test exercises header-only telemetry_board.h — the
+# seqlock board the mixer publishes per-peer telemetry to.
+${CXX:-g++} -std=c++17 -Wall -Wextra -pthread \
+    -I test/cpp \
+    -I android/app/src/main/cpp \
+    test/cpp/telemetry_board_test.cpp \
+    -o build/cpp_test/telemetry_board_test
+build/cpp_test/telemetry_board_test
+
+# talking_state_test exercises header-only talking_state.h — the talking
+# bitmask the mixer publishes and the notifier thread hands to Kotlin.
+${CXX:-g++} -std=c++17 -Wall -Wextra -pthread \
+    -I test/cpp \
+    -I android/app/src/main/cpp \
+    test/cpp/talking_state_test.cpp \
+    -o build/cpp_test/talking_state_test
+build/cpp_test/talking_state_test
+
+# bitrate_controller_test exercises header-only bitrate_controller.h — the
+# per-peer AIMD loop the mixer tick runs on each encoder.
+${CXX:-g++} -std=c++17 -Wall -Wextra -pthread \
+    -I test/cpp \
+    -I android/app/src/main/cpp \
+    test/cpp/bitrate_controller_test.cpp \
+    -o build/cpp_test/bitrate_controller_test
+build/cpp_test/bitrate_controller_test
+
+# voice_bundle_test exercises header-only voice_bundle.h — packing 2–3 Opus
+# frames into one VoiceFrame and splitting them again on receive.
+${CXX:-g++} -std=c++17 -Wall -Wextra -pthread \
+    -I test/cpp \
+    -I android/app/src/main/cpp \
+    test/cpp/voice_bundle_test.cpp \
+    -o build/cpp_test/voice_bundle_test
+build/cpp_test/voice_bundle_test
+
+# voice_header_test exercises header-only voice_header.h — when a compact
+# VoiceFrame header is safe to send, and extending one back on receive.
+${CXX:-g++} -std=c++17 -Wall -Wextra -pthread \
+    -I test/cpp \
+    -I android/app/src/main/cpp \
+    test/cpp/voice_header_test.cpp \
+    -o build/cpp_test/voice_header_test
+build/cpp_test/voice_header_test
+
+# comfort_noise_test exercises header-only comfort_noise.h — the noise a
+# receiver plays through a peer's announced pause.
+${CXX:-g++} -std=c++17 -Wall -Wextra -pthread \
+    -I test/cpp \
+    -I android/app/src/main/cpp \
+    test/cpp/comfort_noise_test.cpp \
+    -o build/cpp_test/comfort_noise_test
+build/cpp_test/comfort_noise_test
+
+# opus_silence_test exercises header-only opus_silence.h — which Opus packets
+# are known silence the receive path needn't decode.
+${CXX:-g++} -std=c++17 -Wall -Wextra -pthread \
+    -I test/cpp \
+    -I android/app/src/main/cpp \
+    test/cpp/opus_silence_test.cpp \
+    -o build/cpp_test/opus_silence_test
+build/cpp_test/opus_silence_test
+
+# tick_governor_test exercises header-only tick_governor.h — stepping encoder
+# complexity, FEC and RMS work to the mixer tick's CPU budget.
+${CXX:-g++} -std=c++17 -Wall -Wextra -pthread \
+    -I test/cpp \
+    -I android/app/src/main/cpp \
+    test/cpp/tick_governor_test.cpp \
+    -o build/cpp_test/tick_governor_test
+build/cpp_test/tick_governor_test
+
+# opus_toc_test exercises header-only opus_toc.h — how much audio an Opus
+# packet holds, for 10 ms and 20 ms frames alike.
+${CXX:-g++} -std=c++17 -Wall -Wextra -pthread \
+    -I test/cpp \
+    -I android/app/src/main/cpp \
+    test/cpp/opus_toc_test.cpp \
+    -o build/cpp_test/opus_toc_test
+build/cpp_test/opus_toc_test
+
+# pre_roll_ring_test exercises header-only pre_roll_ring.h — the capture
+# history the push-to-talk pre-roll is copied from.
+${CXX:-g++} -std=c++17 -Wall -Wextra -pthread \
+    -I test/cpp \
+    -I android/app/src/main/cpp \
+    test/cpp/pre_roll_ring_test.cpp \
+    -o build/cpp_test/pre_roll_ring_test
+build/cpp_test/pre_roll_ring_test
+
 # vad_detector_test exercises the two-sided hysteresis state machine extracted
 # from audio_engine.cpp (#248). Header-only; no extra link deps beyond the STL.
 ${CXX:-g++} -std=c++17 -Wall -Wextra -pthread \
@@ -0,0 +1,229 @@
+// Host-buildable test for BitrateController (header-only).
+//
+// Compile (see scripts/run_native_cpp_tests.sh):
+//   g++ -std=c++17 -Wall -Wextra -pthread -I android/app/src/main/cpp
+//       test/cpp/bitrate_controller_test.cpp -o build/cpp_test/bitrate_controller_test
+
+#include "bitrate_controller.h"
+
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+
+#define CHECK(cond)                                                          \
+    do {                                                                     \
+        if (!(cond)) {                                                       \
+            std::cerr << "CHECK failed: " #cond                              \
+                      << " (" << __FILE__ << ":" << __LINE__ << ")"          \
+                      << std::endl;                                          \
+            std::exit(1);                                                    \
+        }                                                                    \
+    } while (0)
+
+namespace {
+
+using Decision = BitrateController::Decision;
+
+// One interval's worth of inbound frames at 50 Hz.
+constexpr uint64_t kFramesPerInterval = audio_config::kBitrateControlTicks;
+
+// Lifetime counters for a simulated link, advanced one interval at a time.
+struct Link {
+    BitrateController::Sample s;
+
+    BitrateController::Sample clean() {
+        s.recvFrames += kFramesPerInterval;
+        return s;
+    }
+    BitrateController::Sample lossy(uint64_t lost) {
+        s.recvFrames += kFramesPerInterval - lost;
+        s.lostFrames += lost;
+        return s;
+    }
+    BitrateController::Sample congested() {
+        s.recvFrames += kFramesPerInterval;
+        s.congestionSkips += 2;
+        return s;
+    }
+};
+
+}  // namespace
+
+// The first sample only primes the deltas; then a clean link climbs one
+// step per interval up to kBitrateHigh and stays there.
+void testCleanLinkClimbsToHigh() {
+    BitrateController c;
+    Link link;
+    BitrateController::Output out = c.update(link.clean());
+    CHECK(out.decision == Decision::kHold);
+    CHECK(out.bitrateBps == audio_config::kDefaultBitrate);
+    CHECK(out.expectedLossPct == -1);
+
+    out = c.update(link.clean());
+    CHECK(out.decision == Decision::kIncrease);
+    CHECK(out.bitrateBps ==
+          audio_config::kDefaultBitrate + audio_config::kBitrateIncreaseStepBps);
+    CHECK(out.expectedLossPct == 0);
+
+    for (int i = 0; i < 100; ++i) out = c.update(link.clean());
+    CHECK(out.bitrateBps == audio_config::kBitrateHigh);
+    CHECK(out.decision == Decision::kHold);
+    CHECK(c.backoffCount() == 0);
+    std::cout << "Test Clean Link Climbs To High: PASSED" << std::endl;
+}
+
+// Backpressure cuts the bitrate multiplicatively, no faster than the
+// backoff spacing, and holds off increases for the hold after the last cut.
+void testBackpressureBacksOffAndHolds() {
+    BitrateController c(audio_config::kBitrateHigh);
+    Link link;
+    c.update(link.clean());
+
+    BitrateController::Output out = c.update(link.congested());
+    CHECK(out.decision == Decision::kBackoff);
+    const int cut = audio_config::kBitrateHigh * audio_config::kBitrateBackoffPercent / 100;
+    CHECK(out.bitrateBps == cut);
+
+    // Still congested, but inside the spacing: hold.
+    for (int i = 1; i < audio_config::kBitrateBackoffSpacingIntervals; ++i) {
+        out = c.update(link.congested());
+        CHECK(out.decision == Decision::kHold && out.bitrateBps == cut);
+    }
+    out = c.update(link.congested());
+    CHECK(out.decision == Decision::kBackoff);
+    CHECK(out.bitrateBps == cut * audio_config::kBitrateBackoffPercent / 100);
+    CHECK(c.backoffCount() == 2);
+
+    // Clean again: no increase until the hold has passed.
+    const int floor = out.bitrateBps;
+    for (int i = 1; i < audio_config::kBitrateIncreaseHoldIntervals; ++i) {
+        out = c.update(link.clean());
+        CHECK(out.decision == Decision::kHold && out.bitrateBps == floor);
+    }
+    out = c.update(link.clean());
+    CHECK(out.decision == Decision::kIncrease);
+
+    // A congested flag with no new skips counts too, and the cuts bottom out
+    // at kBitrateLow.
+    link.s.congested = true;
+    for (int i = 0; i < 50; ++i) out = c.update(link.clean());
+    CHECK(out.bitrateBps == audio_config::kBitrateLow);
+    std::cout << "Test Backpressure Backs Off And Holds: PASSED" << std::endl;
+}
+
+// Rising playout lag is overuse; lag that moves while no frames arrive is
+// stale and ignored.
+void testLagGradientBacksOff() {
+    BitrateController c;
+    Link link;
+    c.update(link.clean());
+
+    link.s.lagMs += audio_config::kBitrateLagRiseMs;
+    BitrateController::Output out = c.update(link.clean());
+    CHECK(out.decision == Decision::kBackoff);
+
+    // Lag high but steady: not rising, so no further cut.
+    for (int i = 0; i < audio_config::kBitrateBackoffSpacingIntervals; ++i) {
+        out = c.update(link.clean());
+        CHECK(out.decision == Decision::kHold);
+    }
+
+    // No frames this interval: the lag jump proves nothing.
+    link.s.lagMs += 5 * audio_config::kBitrateLagRiseMs;
+    out = c.update(link.s);
+    CHECK(out.decision == Decision::kHold);
+    CHECK(out.expectedLossPct == -1);
+    CHECK(c.backoffCount() == 1);
+    std::cout << "Test Lag Gradient Backs Off: PASSED" << std::endl;
+}
+
+// Loss is smoothed into the expected-loss hint; sustained heavy loss backs
+// off, moderate loss only holds.
+void testLossSmoothsAndBacksOff() {
+    BitrateController c;
+    Link link;
+    c.update(link.clean());
+
+    // 20% loss for one interval: smoothed to a quarter of it — inside the
+    // dead zone, so the bitrate holds.
+    BitrateController::Output out = c.update(link.lossy(3));
+    CHECK(out.expectedLossPct == 5);
+    CHECK(out.decision == Decision::kHold);
+    CHECK(out.bitrateBps == audio_config::kDefaultBitrate);
+
+    // Sustained, it crosses the backoff threshold.
+    out = c.update(link.lossy(3));
+    CHECK(out.decision == Decision::kHold);
+    out = c.update(link.lossy(3));
+    CHECK(out.decision == Decision::kBackoff);
+    CHECK(c.lossPct() > audio_config::kBitrateBackoffLossPct);
+    std::cout << "Test Loss Smooths And Backs Off: PASSED" << std::endl;
+}
+
+// The caller's ceiling caps every decision and applies at once.
+void testCeilingCaps() {
+    BitrateController c(audio_config::kBitrateHigh);
+    Link link;
+    link.s.ceilingBps = audio_config::kBitrateMid;
+    BitrateController::Output out = c.update(link.clean());
+    CHECK(out.bitrateBps == audio_config::kBitrateMid);
+    out = c.update(link.clean());
+    CHECK(out.bitrateBps == audio_config::kBitrateMid);
+    CHECK(out.decision == Decision::kHold);
+
+    link.s.ceilingBps = audio_config::kBitrateLow - 1;
+    out = c.update(link.clean());
+    CHECK(out.bitrateBps == audio_config::kBitrateLow);
+
+    link.s.ceilingBps = audio_config::kBitrateHigh;
+    out = c.update(link.clean());
+    CHECK(out.decision == Decision::kIncrease);
+    CHECK(out.bitrateBps ==
+          audio_config::kBitrateLow + audio_config::kBitrateIncreaseStepBps);
+    std::cout << "Test Ceiling Caps: PASSED" << std::endl;
+}
+
+// Backoffs bundle one more frame per VoiceFrame, clean intervals one fewer,
+// within the peer's offer and the lag headroom.
+void testFramesPerPacketFollowsBackoff() {
+    BitrateController c;
+    Link link;
+    link.s.maxFramesPerPacket = audio_config::kMaxBundleFrames;
+    c.update(link.clean());
+
+    BitrateController::Output out = c.update(link.congested());
+    CHECK(out.decision == Decision::kBackoff && out.framesPerPacket == 2);
+    for (int i = 0; i < 10; ++i) out = c.update(link.congested());
+    CHECK(out.framesPerPacket == static_cast<int>(audio_config::kMaxBundleFrames));
+
+    // Lag eats the headroom: at the budget, one frame per VoiceFrame.
+    link.s.lagMs = audio_config::kBundleLagBudgetMs;
+    out = c.update(link.congested());
+    CHECK(out.framesPerPacket == 1);
+    link.s.lagMs = 0;
+
+    // Clean after the hold: back down to one frame, a step at a time.
+    for (int i = 0; i < audio_config::kBitrateIncreaseHoldIntervals; ++i) {
+        out = c.update(link.clean());
+    }
+    CHECK(out.framesPerPacket == 1);
+
+    // A peer that never offered to unpack bundles gets none.
+    BitrateController legacy;
+    Link plain;
+    legacy.update(plain.clean());
+    for (int i = 0; i < 10; ++i) out = legacy.update(plain.congested());
+    CHECK(out.framesPerPacket == 1);
+    std::cout << "Test Frames Per Packet Follows Backoff: PASSED" << std::endl;
+}
+
+int main() {
+    testCleanLinkClimbsToHigh();
+    testBackpressureBacksOffAndHolds();
+    testLagGradientBacksOff();
+    testLossSmoothsAndBacksOff();
+    testCeilingCaps();
+    testFramesPerPacketFollowsBackoff();
+    std::cout << "All BitrateController tests passed!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,140 @@
+// Host-buildable test for ClockDriftEstimator (header-only).
+//
+// Compile (see scripts/run_native_cpp_tests.sh):
+//   g++ -std=c++17 -Wall -Wextra -pthread -I android/app/src/main/cpp
+//       test/cpp/clock_drift_estimator_test.cpp -o build/cpp_test/clock_drift_estimator_test
+
+#include "clock_drift_estimator.h"
+
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+
+#define CHECK(cond)                                                          \
+    do {                                                                     \
+        if (!(cond)) {                                                       \
+            std::cerr << "CHECK failed: " #cond                              \
+                      << " (" << __FILE__ << ":" << __LINE__ << ")"          \
+                      << std::endl;                                          \
+            std::exit(1);                                                    \
+        }                                                                    \
+    } while (0)
+
+namespace {
+
+// Simulate `seconds` of 50 Hz frames from a sender whose clock runs `ppm`
+// fast relative to ours. Frames leave the sender every 20 ms of *its* time,
+// which is 20 / (1 + ppm·1e-6) ms of ours. Each arrival gets a deterministic
+// one-sided jitter in [0, 40) ms on top of a fixed 30 ms transit, standing in
+// for BLE connection-event quantisation. `epochOffsetMs` is the arbitrary gap
+// between the two monotonic clocks.
+void feedStream(ClockDriftEstimator& est, double ppm, int seconds,
+                int64_t epochOffsetMs = 123456789, int64_t startRecvMs = 1000) {
+    const int frames = seconds * 50;
+    uint32_t lcg = 12345;
+    for (int i = 0; i < frames; ++i) {
+        const double senderMs = i * 20.0;
+        const double ourMs = senderMs / (1.0 + ppm * 1e-6);
+        lcg = lcg * 1103515245u + 12345u;
+        const int jitter = static_cast<int>((lcg >> 16) % 40);
+        const int64_t recvMs =
+            startRecvMs + static_cast<int64_t>(std::llround(ourMs)) + 30 + jitter;
+        const uint32_t senderTs =
+            static_cast<uint32_t>(static_cast<int64_t>(senderMs) + epochOffsetMs);
+        est.feed(senderTs, recvMs);
+    }
+}
+
+}  // namespace
+
+void testNotConvergedReadsZero() {
+    ClockDriftEstimator est;
+    feedStream(est, 200.0, 5);  // 5 s < kDriftMinBlocks blocks
+    CHECK(!est.converged());
+    CHECK(est.skewPpm() == 0.0);
+    CHECK(est.consumeStep() == 1.0);
+    std::cout << "Test Not Converged Reads Zero: PASSED" << std::endl;
+}
+
+void testMatchedClocksReadNearZero() {
+    ClockDriftEstimator est;
+    feedStream(est, 0.0, 40);
+    CHECK(est.converged());
+    CHECK(std::fabs(est.skewPpm()) < 20.0);
+    std::cout << "Test Matched Clocks Read Near Zero: PASSED" << std::endl;
+}
+
+void testFastSenderReadsPositive() {
+    ClockDriftEstimator est;
+    feedStream(est, 150.0, 60);
+    CHECK(est.converged());
+    CHECK(std::fabs(est.skewPpm() - 150.0) < 30.0);
+    CHECK(est.consumeStep() > 1.0);
+    std::cout << "Test Fast Sender Reads Positive: PASSED" << std::endl;
+}
+
+void testSlowSenderReadsNegative() {
+    ClockDriftEstimator est;
+    feedStream(est, -120.0, 60);
+    CHECK(est.converged());
+    CHECK(std::fabs(est.skewPpm() + 120.0) < 30.0);
+    CHECK(est.consumeStep() < 1.0);
+    std::cout << "Test Slow Sender Reads Negative: PASSED" << std::endl;
+}
+
+// The uint32 senderTsMs wrap must not show up as a slope.
+void testSenderTimestampWrap() {
+    ClockDriftEstimator est;
+    // Start the sender clock 10 s before the 2^32 ms wrap.
+    feedStream(est, 0.0, 40, static_cast<int64_t>(UINT32_MAX) - 10000);
+    CHECK(est.converged());
+    CHECK(std::fabs(est.skewPpm()) < 20.0);
+    std::cout << "Test Sender Timestamp Wrap: PASSED" << std::endl;
+}
+
+// A broken timestamp stream is clamped, not followed off a cliff.
+void testClampedToMaxCorrection() {
+    ClockDriftEstimator est;
+    feedStream(est, 5000.0, 40);
+    CHECK(est.converged());
+    CHECK(est.skewPpm() <= audio_config::kDriftMaxCorrectionPpm);
+    CHECK(est.skewPpm() > audio_config::kDriftMaxCorrectionPpm - 1.0);
+    std::cout << "Test Clamped To Max Correction: PASSED" << std::endl;
+}
+
+// A silence gap longer than the fit window evicts the stale blocks, so the
+// estimator re-converges on the new stretch instead of bridging the gap.
+void testLongGapEvictsWindow() {
+    ClockDriftEstimator est;
+    feedStream(est, 0.0, 30);
+    CHECK(est.converged());
+    feedStream(est, 0.0, 3, 123456789 + 200000, 1000 + 200000);
+    CHECK(!est.converged());
+    std::cout << "Test Long Gap Evicts Window: PASSED" << std::endl;
+}
+
+void testReset() {
+    ClockDriftEstimator est;
+    feedStream(est, 200.0, 40);
+    CHECK(est.converged());
+    est.reset();
+    CHECK(!est.converged());
+    CHECK(est.skewPpm() == 0.0);
+    feedStream(est, -200.0, 60);
+    CHECK(est.skewPpm() < 0.0);
+    std::cout << "Test Reset: PASSED" << std::endl;
+}
+
+int main() {
+    testNotConvergedReadsZero();
+    testMatchedClocksReadNearZero();
+    testFastSenderReadsPositive();
+    testSlowSenderReadsNegative();
+    testSenderTimestampWrap();
+    testClampedToMaxCorrection();
+    testLongGapEvictsWindow();
+    testReset();
+    std::cout << "All ClockDriftEstimator tests passed!" << std::endl;
+    return 0;
+}
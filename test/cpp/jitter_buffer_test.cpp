@@ -600,6 +600,134 @@ void testPeekFront() {
     std::cout << "Test Peek Front: PASSED" << std::endl;
 }
 
+// frameAt() walks the queue in playout order, and PCM attached through it
+// travels with the frame out of pop(). primed() flips on the first release.
+void testFrameAtCarriesAttachedPcm() {
+    JitterBuffer jb;
+    assert(jb.frameAt(0) == nullptr);
+    assert(!jb.primed());
+
+    const uint8_t data[1] = {0x0a};
+    assert(jb.push(20, data, 1));
+    assert(jb.push(21, data, 1));
+    assert(jb.frameAt(0)->seq == 20);
+    assert(jb.frameAt(1)->seq == 21);
+    assert(jb.frameAt(2) == nullptr);
+
+    jb.frameAt(0)->pcm.assign(4, 7);
+    auto f = jb.popAny();
+    assert(f.has_value() && f->seq == 20);
+    assert(f->pcm.size() == 4 && f->pcm[3] == 7);
+    assert(jb.primed());
+    // The next frame was never decoded ahead.
+    assert(jb.frameAt(0)->pcm.empty());
+
+    jb.reset();
+    assert(!jb.primed());
+    std::cout << "Test Frame At Carries Attached Pcm: PASSED" << std::endl;
+}
+
+void testFecSourceForHoleTargetsExactSeq() {
+    JitterBuffer jb;
+    const uint8_t data[1] = {0x5a};
+    // 20 arrives, then 23/24/25: a two-frame hole at 21-22. Only 23 follows a
+    // missing seq; 24 and 25 have their predecessors queued.
+    assert(jb.push(20, data, 1));
+    assert(jb.push(23, data, 1));
+    assert(jb.push(24, data, 1));
+    assert(jb.push(25, data, 1));
+    assert(!jb.frameAt(0)->recoversPrev);  // predecessor already played
+    assert(jb.frameAt(1)->recoversPrev);
+    assert(!jb.frameAt(2)->recoversPrev);
+
+    auto f = jb.pop();
+    assert(f.has_value() && f->seq == 20);
+    assert(jb.fecSourceForHole() == nullptr);
+
+    // Hole at 21: 23's LBRR describes 22, not 21 — PLC.
+    assert(!jb.pop().has_value());
+    assert(jb.fecSourceForHole() == nullptr);
+    // Hole at 22: 23 recovers it.
+    assert(!jb.pop().has_value());
+    const JitterBuffer::Frame* src = jb.fecSourceForHole();
+    assert(src != nullptr && src->seq == 23);
+
+    // A plain underrun never names a recovery frame.
+    f = jb.pop();
+    assert(f.has_value() && f->seq == 23);
+    assert(!jb.pop().has_value());  // depth 2 < target 3
+    assert(jb.fecSourceForHole() == nullptr);
+
+    // A late-filled hole clears its successor's mark.
+    assert(jb.push(27, data, 1));
+    assert(jb.frameAt(2)->seq == 27 && jb.frameAt(2)->recoversPrev);
+    assert(jb.push(26, data, 1));
+    assert(!jb.frameAt(3)->recoversPrev);
+    std::cout << "Test Fec Source For Hole Targets Exact Seq: PASSED" << std::endl;
+}
+
+void testFastStartReleasesEarlyThenRamps() {
+    JitterBuffer jb;
+    jb.setStartDepth(1);
+    const uint8_t data[1] = {0x11};
+    assert(jb.releaseDepth() == 1);
+    assert(!jb.ramping());
+
+    assert(jb.push(40, data, 1));
+    auto f = jb.pop();
+    assert(f.has_value() && f->seq == 40);
+    assert(jb.ramping());
+
+    // Still below target: one queued frame is enough during the ramp.
+    assert(jb.push(41, data, 1));
+    assert(jb.pop().has_value());
+
+    // Once the buffer reaches the target, the normal rule applies.
+    const size_t target = jb.targetDepth();
+    for (uint32_t s = 42; s < 42 + target; ++s) assert(jb.push(s, data, 1));
+    assert(jb.pop().has_value());
+    assert(!jb.ramping());
+    assert(jb.releaseDepth() == target);
+    while (jb.currentDepth() >= target) assert(jb.pop().has_value());
+    assert(!jb.pop().has_value());
+
+    // reset() cold-starts again, keeping the start depth.
+    jb.reset();
+    assert(jb.releaseDepth() == 1);
+    std::cout << "Test Fast Start Releases Early Then Ramps: PASSED" << std::endl;
+}
+
+void testSeedAdaptStateClamps() {
+    JitterBuffer jb;
+    jb.seedAdaptState({audio_config::kJitterMaxTargetDepth + 5, 3});
+    assert(jb.targetDepth() == audio_config::kJitterMaxTargetDepth);
+    assert(jb.adaptState().stableIntervals == 3);
+    jb.seedAdaptState({0, 0});
+    assert(jb.targetDepth() == audio_config::kJitterMinDepth);
+    std::cout << "Test Seed Adapt State Clamps: PASSED" << std::endl;
+}
+
+// An announced pause drains without an underrun; the frame that ends it
+// clears the announcement, and starving after that counts again.
+void testExpectedGapNotCountedAsUnderrun() {
+    JitterBuffer jb;
+    seedAtDepth(jb, 1, audio_config::kJitterInitialDepth);
+    const uint32_t next = 1 + audio_config::kJitterInitialDepth;
+    jb.expectGap(next);
+    while (jb.pop().has_value()) {
+    }
+    for (int i = 0; i < 5; ++i) assert(!jb.pop().has_value());
+    assert(jb.gapExpected());
+    assert(jb.underrunCount() == 0);
+
+    seedAtDepth(jb, next, audio_config::kJitterInitialDepth);
+    assert(!jb.gapExpected());
+    while (jb.pop().has_value()) {
+    }
+    assert(jb.underrunCount() == 1);
+    std::cout << "Test Expected Gap Not Counted As Underrun: PASSED" << std::endl;
+}
+
 }  // namespace
 
 int main() {
@@ -623,6 +751,11 @@ int main() {
         testLostFrameCountOnHole();
         testTargetDepthCapsAtMaxTarget();
         testPeekFront();
+        testFrameAtCarriesAttachedPcm();
+        testFecSourceForHoleTargetsExactSeq();
+        testFastStartReleasesEarlyThenRamps();
+        testSeedAdaptStateClamps();
+        testExpectedGapNotCountedAsUnderrun();
         std::cout << "All JitterBuffer tests passed!" << std::endl;
     } catch (const std::exception& e) {
         std::cerr << "Test failed: " << e.what() << std::endl;
@@ -79,6 +79,10 @@ struct JNIEnv {
 
     jsize GetArrayLength(jarray) { return 0; }
 
+    jobject NewDirectByteBuffer(void*, jlong) { return nullptr; }
+    void* GetDirectBufferAddress(jobject) { return nullptr; }
+    jlong GetDirectBufferCapacity(jobject) { return -1; }
+
     jclass FindClass(const char*) { return nullptr; }
 
     jobjectArray NewObjectArray(jsize, jclass, jobject) { return nullptr; }
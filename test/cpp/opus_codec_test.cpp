@@ -139,6 +139,29 @@ void testEncodeRejectsWrongFrameSize() {
     std::cout << "Test Encode Rejects Wrong Frame Size: PASSED" << std::endl;
 }
 
+// ── 10 ms and 20 ms frames alternate on one encoder ─────────────────────────
+//
+// The low-latency profile switches frame size at a tick boundary without
+// re-creating anything; the decoder reads each packet's duration from it.
+void testEncodesLowLatencyFrames() {
+    OpusEncoder enc;
+    OpusDecoder dec;
+    std::vector<int16_t> pcmIn = makeSineFrame(1000.0);
+    uint8_t encoded[audio_config::kMaxOpusPacketSize];
+    std::vector<int16_t> pcmOut(audio_config::kCodecMaxFrameSize, 0);
+    for (int frameSize : {audio_config::kLowLatencyCodecFrameSize,
+                          audio_config::kCodecFrameSize,
+                          audio_config::kLowLatencyCodecFrameSize}) {
+        int encodedSize = enc.encode(pcmIn.data(), frameSize, encoded,
+                                     audio_config::kMaxOpusPacketSize);
+        CHECK(encodedSize > 0);
+        int decoded = dec.decode(encoded, encodedSize, pcmOut.data(),
+                                 audio_config::kCodecMaxFrameSize);
+        CHECK(decoded == frameSize);
+    }
+    std::cout << "Test Encodes Low-Latency Frames: PASSED" << std::endl;
+}
+
 // ── setBitrate clamping ───────────────────────────────────────────────────────
 void testSetBitrateClampsToRange() {
     OpusEncoder enc;
@@ -244,6 +267,7 @@ int main() {
     testEncoderDecoderConstruct();
     testRoundTripFidelity1kHz();
     testEncodeRejectsWrongFrameSize();
+    testEncodesLowLatencyFrames();
     testSetBitrateClampsToRange();
     testDecodeMissingReturnsConcealedAudio();
     testDecodeFecDoesNotCrash();
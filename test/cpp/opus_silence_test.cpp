@@ -0,0 +1,57 @@
+// Host-buildable test for opus_silence.h (header-only).
+//
+// Compile (see scripts/run_native_cpp_tests.sh):
+//   g++ -std=c++17 -Wall -Wextra -pthread -I android/app/src/main/cpp
+//       test/cpp/opus_silence_test.cpp -o build/cpp_test/opus_silence_test
+
+#include "opus_silence.h"
+
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#define CHECK(cond)                                                          \
+    do {                                                                     \
+        if (!(cond)) {                                                       \
+            std::cerr << "CHECK failed: " #cond                              \
+                      << " (" << __FILE__ << ":" << __LINE__ << ")"          \
+                      << std::endl;                                          \
+            std::exit(1);                                                    \
+        }                                                                    \
+    } while (0)
+
+// A bare TOC (DTX) and a code-0 packet with a one-byte frame are silence,
+// whatever the mode and bandwidth bits say.
+void testDtxAndEmptyFramesAreSilent() {
+    for (int config = 0; config < 32; ++config) {
+        const uint8_t toc = static_cast<uint8_t>(config << 3);
+        const uint8_t bare[1] = {toc};
+        CHECK(opus_silence::isSilent(bare, 1));
+        const uint8_t tiny[2] = {toc, 0x00};
+        CHECK(opus_silence::isSilent(tiny, 2));
+    }
+    CHECK(opus_silence::isSilent(nullptr, 0));
+    CHECK(opus_silence::isSilent(std::vector<uint8_t>{0x78}));
+    std::cout << "Test DTX And Empty Frames Are Silent: PASSED" << std::endl;
+}
+
+// Anything with a real frame in it decodes — including two-byte packets of
+// the multi-frame codes, whose second byte isn't frame data.
+void testRealFramesAreNotSilent() {
+    const uint8_t three[3] = {0x78, 0x01, 0x02};
+    CHECK(!opus_silence::isSilent(three, 3));
+    for (uint8_t code = 1; code <= 3; ++code) {
+        const uint8_t multi[2] = {static_cast<uint8_t>(0x78 | code), 0x02};
+        CHECK(!opus_silence::isSilent(multi, 2));
+    }
+    CHECK(!opus_silence::isSilent(std::vector<uint8_t>(60, 0x55)));
+    std::cout << "Test Real Frames Are Not Silent: PASSED" << std::endl;
+}
+
+int main() {
+    testDtxAndEmptyFramesAreSilent();
+    testRealFramesAreNotSilent();
+    std::cout << "All opus_silence tests passed!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,89 @@
+// Host-buildable test for opus_toc.h (header-only).
+//
+// Compile (see scripts/run_native_cpp_tests.sh):
+//   g++ -std=c++17 -Wall -Wextra -pthread -I android/app/src/main/cpp
+//       test/cpp/opus_toc_test.cpp -o build/cpp_test/opus_toc_test
+
+#include "opus_toc.h"
+
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+
+#define CHECK(cond)                                                          \
+    do {                                                                     \
+        if (!(cond)) {                                                       \
+            std::cerr << "CHECK failed: " #cond                              \
+                      << " (" << __FILE__ << ":" << __LINE__ << ")"          \
+                      << std::endl;                                          \
+            std::exit(1);                                                    \
+        }                                                                    \
+    } while (0)
+
+namespace {
+
+uint8_t toc(int config, int code) { return static_cast<uint8_t>(config << 3 | code); }
+
+}  // namespace
+
+// Every configuration maps to the duration RFC 6716's table gives it, in
+// each mode's own cycle.
+void testFrameDurationPerConfig() {
+    // SILK-only, NB/MB/WB: 10, 20, 40, 60 ms.
+    for (int bw = 0; bw < 3; ++bw) {
+        CHECK(opus_toc::frameDurationUs(toc(bw * 4 + 0, 0)) == 10000);
+        CHECK(opus_toc::frameDurationUs(toc(bw * 4 + 1, 0)) == 20000);
+        CHECK(opus_toc::frameDurationUs(toc(bw * 4 + 2, 0)) == 40000);
+        CHECK(opus_toc::frameDurationUs(toc(bw * 4 + 3, 0)) == 60000);
+    }
+    // Hybrid, SWB/FB: 10, 20 ms.
+    CHECK(opus_toc::frameDurationUs(toc(12, 0)) == 10000);
+    CHECK(opus_toc::frameDurationUs(toc(13, 0)) == 20000);
+    CHECK(opus_toc::frameDurationUs(toc(14, 0)) == 10000);
+    CHECK(opus_toc::frameDurationUs(toc(15, 0)) == 20000);
+    // CELT-only, NB/WB/SWB/FB: 2.5, 5, 10, 20 ms.
+    for (int bw = 0; bw < 4; ++bw) {
+        CHECK(opus_toc::frameDurationUs(toc(16 + bw * 4 + 0, 0)) == 2500);
+        CHECK(opus_toc::frameDurationUs(toc(16 + bw * 4 + 1, 0)) == 5000);
+        CHECK(opus_toc::frameDurationUs(toc(16 + bw * 4 + 2, 0)) == 10000);
+        CHECK(opus_toc::frameDurationUs(toc(16 + bw * 4 + 3, 0)) == 20000);
+    }
+    // The stereo bit doesn't change it.
+    CHECK(opus_toc::frameDurationUs(static_cast<uint8_t>(toc(9, 0) | 0x4)) == 20000);
+    std::cout << "Test Frame Duration Per Config: PASSED" << std::endl;
+}
+
+// Codes 1 and 2 hold two frames, code 3 as many as its count byte says.
+void testPacketDurationCountsFrames() {
+    const uint8_t one[] = {toc(8, 0), 0x12, 0x34};  // SILK WB 10 ms
+    CHECK(opus_toc::packetDurationUs(one, sizeof(one)) == 10000);
+    const uint8_t two[] = {toc(9, 1), 0x12, 0x34};
+    CHECK(opus_toc::packetDurationUs(two, sizeof(two)) == 40000);
+    const uint8_t vbr[] = {toc(9, 2), 0x01, 0x12, 0x34};
+    CHECK(opus_toc::packetDurationUs(vbr, sizeof(vbr)) == 40000);
+    const uint8_t three[] = {toc(9, 3), 0x03, 0x12, 0x34};
+    CHECK(opus_toc::packetDurationUs(three, sizeof(three)) == 60000);
+    // The count byte's VBR and padding flags aren't part of the count.
+    const uint8_t flagged[] = {toc(8, 3), 0xC3, 0x01, 0x12};
+    CHECK(opus_toc::packetDurationUs(flagged, sizeof(flagged)) == 30000);
+    // A bare TOC (DTX) is still one frame's worth of time.
+    const uint8_t dtx[] = {toc(9, 0)};
+    CHECK(opus_toc::packetDurationUs(dtx, sizeof(dtx)) == 20000);
+    std::cout << "Test Packet Duration Counts Frames: PASSED" << std::endl;
+}
+
+// Too short to say: nothing at all, or code 3 without its count.
+void testTruncatedPacketsHaveNoDuration() {
+    CHECK(opus_toc::packetDurationUs(nullptr, 0) == 0);
+    const uint8_t code3[] = {toc(9, 3)};
+    CHECK(opus_toc::packetDurationUs(code3, sizeof(code3)) == 0);
+    std::cout << "Test Truncated Packets Have No Duration: PASSED" << std::endl;
+}
+
+int main() {
+    testFrameDurationPerConfig();
+    testPacketDurationCountsFrames();
+    testTruncatedPacketsHaveNoDuration();
+    std::cout << "All opus_toc tests passed!" << std::endl;
+    return 0;
+}
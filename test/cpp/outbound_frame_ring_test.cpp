@@ -0,0 +1,196 @@
+// Host-buildable test for OutboundFrameRing (header-only).
+//
+// Compile (see scripts/run_native_cpp_tests.sh):
+//   g++ -std=c++17 -Wall -Wextra -pthread -I android/app/src/main/cpp
+//       test/cpp/outbound_frame_ring_test.cpp -o build/cpp_test/outbound_frame_ring_test
+
+#include "outbound_frame_ring.h"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <thread>
+
+#define CHECK(cond)                                                          \
+    do {                                                                     \
+        if (!(cond)) {                                                       \
+            std::cerr << "CHECK failed: " #cond                              \
+                      << " (" << __FILE__ << ":" << __LINE__ << ")"          \
+                      << std::endl;                                          \
+            std::exit(1);                                                    \
+        }                                                                    \
+    } while (0)
+
+namespace {
+
+// Commit one frame whose payload is `len` copies of `fill`.
+bool pushFrame(OutboundFrameRing& ring, uint32_t seq, size_t len, uint8_t fill,
+               int64_t nowMs) {
+    uint8_t* dst = ring.writeSlot();
+    if (!dst) return false;
+    std::memset(dst, fill, len);
+    ring.commit(seq, 0x01020304u, len, nowMs);
+    return true;
+}
+
+uint32_t seqAt(OutboundFrameRing& ring, int offset) {
+    const uint8_t* p = ring.storage() + offset + OutboundFrameRing::kPrefixBytes;
+    return (static_cast<uint32_t>(p[0]) << 24) | (static_cast<uint32_t>(p[1]) << 16) |
+           (static_cast<uint32_t>(p[2]) << 8) | p[3];
+}
+
+}  // namespace
+
+// A committed slot is the exact wire form: prefix, header, payload.
+void testCommitWritesWireFrame() {
+    OutboundFrameRing ring;
+    CHECK(ring.peek(0) == OutboundFrameRing::kEmpty);
+    CHECK(pushFrame(ring, 0xA1B2C3D4u, 3, 0x5A, 0));
+
+    const int off = ring.peek(0);
+    CHECK(off == 0);
+    const uint8_t* p = ring.storage() + off;
+    CHECK(p[0] == 0x00 && p[1] == 8 + 3);
+    CHECK(seqAt(ring, off) == 0xA1B2C3D4u);
+    CHECK(p[6] == 0x01 && p[7] == 0x02 && p[8] == 0x03 && p[9] == 0x04);
+    CHECK(p[10] == 0x5A && p[12] == 0x5A);
+
+    // peek() doesn't consume; release() does.
+    CHECK(ring.peek(0) == off);
+    ring.release();
+    CHECK(ring.peek(0) == OutboundFrameRing::kEmpty);
+    CHECK(ring.depth() == 0);
+    std::cout << "Test Commit Writes Wire Frame: PASSED" << std::endl;
+}
+
+// The consumer keeps only the newest kOutboundQueueFrames; with every slot
+// held, the producer is refused and the drop is counted.
+void testBacklogTrimsOldestAndFullRingRefuses() {
+    OutboundFrameRing ring;
+    for (uint32_t s = 0; s < OutboundFrameRing::kSlots; ++s) {
+        CHECK(pushFrame(ring, s, 10, 0, 0));
+    }
+    CHECK(ring.writeSlot() == nullptr);
+    ring.noteFullDrop();
+    CHECK(ring.fullDropCount() == 1);
+
+    const int off = ring.peek(0);
+    const uint32_t firstKept =
+        static_cast<uint32_t>(OutboundFrameRing::kSlots - audio_config::kOutboundQueueFrames);
+    CHECK(seqAt(ring, off) == firstKept);
+    CHECK(ring.depth() == audio_config::kOutboundQueueFrames);
+    CHECK(ring.staleDropCount() == firstKept);
+    CHECK(ring.writeSlot() != nullptr);
+    std::cout << "Test Backlog Trims Oldest And Full Ring Refuses: PASSED" << std::endl;
+}
+
+// A frame that waited past the stale budget is shed, not sent. The boundary
+// is exclusive: exactly at the budget is still fresh.
+void testStaleFramesShed() {
+    const int64_t budget = audio_config::kOutboundStaleBudgetMs;
+    OutboundFrameRing ring;
+    CHECK(pushFrame(ring, 1, 10, 0, 0));
+    CHECK(pushFrame(ring, 2, 10, 0, 50));
+
+    int off = ring.peek(budget);
+    CHECK(seqAt(ring, off) == 1);
+    off = ring.peek(budget + 1);
+    CHECK(seqAt(ring, off) == 2);
+    CHECK(ring.staleDropCount() == 1);
+    CHECK(ring.peek(50 + 2000) == OutboundFrameRing::kEmpty);
+    CHECK(ring.staleDropCount() == 2);
+    std::cout << "Test Stale Frames Shed: PASSED" << std::endl;
+}
+
+// acquire() parks until the producer commits, times out on a silent ring,
+// and returns kClosed once the peer is gone.
+void testAcquireWakesTimesOutAndCloses() {
+    OutboundFrameRing ring;
+    CHECK(ring.acquire(5) == OutboundFrameRing::kEmpty);
+
+    std::thread producer([&] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        const int64_t now = std::chrono::duration_cast<std::chrono::milliseconds>(
+                                std::chrono::steady_clock::now().time_since_epoch())
+                                .count();
+        pushFrame(ring, 7, 10, 0, now);
+    });
+    const int off = ring.acquire(2000);
+    producer.join();
+    CHECK(off >= 0 && seqAt(ring, off) == 7);
+    ring.release();
+
+    std::thread closer([&] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        ring.close();
+    });
+    CHECK(ring.acquire(2000) == OutboundFrameRing::kClosed);
+    closer.join();
+    std::cout << "Test Acquire Wakes Times Out And Closes: PASSED" << std::endl;
+}
+
+// The producer can see how long the backlog has waited; skips are counted.
+void testOldestAgeAndSkips() {
+    OutboundFrameRing ring;
+    CHECK(ring.oldestAgeMs(100) == 0);
+    CHECK(pushFrame(ring, 1, 10, 0, 100));
+    CHECK(pushFrame(ring, 2, 10, 0, 120));
+    CHECK(ring.oldestAgeMs(150) == 50);
+    CHECK(ring.peek(150) >= 0);
+    ring.release();
+    CHECK(ring.oldestAgeMs(150) == 30);
+    ring.release();
+    CHECK(ring.oldestAgeMs(150) == 0);
+
+    ring.noteCongestionSkip();
+    ring.noteCongestionSkip();
+    CHECK(ring.congestionSkipCount() == 2);
+    std::cout << "Test Oldest Age And Skips: PASSED" << std::endl;
+}
+
+// Only one writer may consume at a time.
+void testClaimIsExclusive() {
+    OutboundFrameRing ring;
+    CHECK(ring.claim());
+    CHECK(!ring.claim());
+    ring.unclaim();
+    CHECK(ring.claim());
+    std::cout << "Test Claim Is Exclusive: PASSED" << std::endl;
+}
+
+// A compact-header frame sits flush against its payload: peek() points past
+// the unused header bytes, at a flagged prefix. A new writer changes the
+// continuity epoch, as a drop does.
+void testCompactHeaderCommit() {
+    OutboundFrameRing ring;
+    uint8_t* dst = ring.writeSlot();
+    std::memset(dst, 0x5A, 3);
+    ring.commit(0x1234, 0xAABBCCDDu, 3, 0, true);
+
+    const int off = ring.peek(0);
+    CHECK(off == static_cast<int>(OutboundFrameRing::kHeaderBytes -
+                                  OutboundFrameRing::kCompactHeaderBytes));
+    const uint8_t* p = ring.storage() + off;
+    CHECK(p[0] == 0x80 && p[1] == 3 + 3);
+    CHECK(p[2] == 0x34 && p[3] == 0xCC && p[4] == 0xDD);
+    CHECK(p[5] == 0x5A && p[7] == 0x5A);
+
+    const uint64_t epoch = ring.continuityEpoch();
+    CHECK(ring.claim());
+    CHECK(ring.continuityEpoch() != epoch);
+    std::cout << "Test Compact Header Commit: PASSED" << std::endl;
+}
+
+int main() {
+    testCommitWritesWireFrame();
+    testBacklogTrimsOldestAndFullRingRefuses();
+    testStaleFramesShed();
+    testAcquireWakesTimesOutAndCloses();
+    testOldestAgeAndSkips();
+    testClaimIsExclusive();
+    testCompactHeaderCommit();
+    std::cout << "All OutboundFrameRing tests passed!" << std::endl;
+    return 0;
+}
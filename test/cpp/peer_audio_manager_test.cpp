@@ -30,9 +30,13 @@
 
 #include "peer_audio_manager.h"
 
+#include <chrono>
 #include <cstdint>
+#include <cstring>
 #include <iostream>
 #include <string>
+#include <thread>
+#include <vector>
 
 // CHECK is preferred over assert(): assert() is a no-op when NDEBUG is
 // defined (release/optimized builds), which would let tests pass silently
@@ -49,9 +53,10 @@
 
 namespace {
 
-// Minimal one-byte payload used wherever audio content doesn't matter.
-const uint8_t kFakeOpus[1] = {0xAB};
-const int kFakeOpusLen = 1;
+// Minimal payload used wherever audio content doesn't matter: a code-0
+// packet just long enough not to read as known silence (opus_silence.h).
+const uint8_t kFakeOpus[3] = {0x78, 0x01, 0x02};
+const int kFakeOpusLen = 3;
 const std::string kMacA = "AA:BB:CC:DD:EE:FF";
 const std::string kMacB = "11:22:33:44:55:66";
 
@@ -68,6 +73,33 @@ uint32_t freshSenderTs() {
     return t;
 }
 
+// Poll `pred` every 10 ms for up to `timeoutMs`. Returns its final value.
+template <typename Pred>
+bool waitFor(Pred pred, int timeoutMs) {
+    const auto deadline = std::chrono::steady_clock::now() +
+                          std::chrono::milliseconds(timeoutMs);
+    while (!pred()) {
+        if (std::chrono::steady_clock::now() >= deadline) return false;
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    return true;
+}
+
+// Push one frame and move it into the jitter buffer the way the mixer tick
+// would. True iff the jitter buffer accepted it.
+template <typename Peer>
+bool pushAccepted(PeerAudioManager& mgr, const Peer& peer, uint32_t seq) {
+    return mgr.onVoiceFramePushed(peer, seq, freshSenderTs(), kFakeOpus,
+                                  kFakeOpusLen) &&
+           mgr.drainArrivals(peer) == 1;
+}
+
+// Park takes kIdleParkAfterTicks quiet ticks; allow generous slack for a
+// loaded CI host.
+constexpr int kParkTimeoutMs =
+    audio_config::kIdleParkAfterTicks * audio_config::kMixerTickIntervalMs * 2 +
+    1000;
+
 }  // namespace
 
 // Verify that onVoiceFramePushed returns false for an unregistered peer —
@@ -87,7 +119,7 @@ void testNormalSeqAccepted() {
     mgr.registerPeer(kMacA);
 
     for (uint32_t seq = 1; seq <= 10; ++seq) {
-        CHECK(mgr.onVoiceFramePushed(kMacA, seq, freshSenderTs(), kFakeOpus, kFakeOpusLen));
+        CHECK(pushAccepted(mgr, kMacA, seq));
     }
 
     mgr.clear();
@@ -112,7 +144,7 @@ void testHighUint32SeqCastAndAccepted() {
     // static_cast<uint32_t> used in nativeOnVoiceFrameReceived.
     for (int64_t seqJlong = 0x7FFFFFFDLL; seqJlong != 0x80000002LL; ++seqJlong) {
         uint32_t seq = static_cast<uint32_t>(seqJlong);
-        CHECK(mgr.onVoiceFramePushed(kMacA, seq, freshSenderTs(), kFakeOpus, kFakeOpusLen));
+        CHECK(pushAccepted(mgr, kMacA, seq));
     }
 
     mgr.clear();
@@ -129,12 +161,12 @@ void testUint32RolloverAccepted() {
     mgr.registerPeer(kMacA);
 
     // 3 frames ending at the max uint32 value.
-    CHECK(mgr.onVoiceFramePushed(kMacA, 0xFFFFFFFDu, freshSenderTs(), kFakeOpus, kFakeOpusLen));
-    CHECK(mgr.onVoiceFramePushed(kMacA, 0xFFFFFFFEu, freshSenderTs(), kFakeOpus, kFakeOpusLen));
-    CHECK(mgr.onVoiceFramePushed(kMacA, 0xFFFFFFFFu, freshSenderTs(), kFakeOpus, kFakeOpusLen));
+    CHECK(pushAccepted(mgr, kMacA, 0xFFFFFFFDu));
+    CHECK(pushAccepted(mgr, kMacA, 0xFFFFFFFEu));
+    CHECK(pushAccepted(mgr, kMacA, 0xFFFFFFFFu));
     // 2 frames after the rollover: treated as forward frames by unsigned delta.
-    CHECK(mgr.onVoiceFramePushed(kMacA, 0x00000000u, freshSenderTs(), kFakeOpus, kFakeOpusLen));
-    CHECK(mgr.onVoiceFramePushed(kMacA, 0x00000001u, freshSenderTs(), kFakeOpus, kFakeOpusLen));
+    CHECK(pushAccepted(mgr, kMacA, 0x00000000u));
+    CHECK(pushAccepted(mgr, kMacA, 0x00000001u));
 
     mgr.clear();
     std::cout << "Test uint32 Rollover Accepted: PASSED" << std::endl;
@@ -149,11 +181,11 @@ void testSeqGapAcceptedByJitterBuffer() {
     mgr.registerPeer(kMacA);
 
     for (uint32_t seq = 1; seq <= 4; ++seq) {
-        CHECK(mgr.onVoiceFramePushed(kMacA, seq, freshSenderTs(), kFakeOpus, kFakeOpusLen));
+        CHECK(pushAccepted(mgr, kMacA, seq));
     }
 
     // Seqs 5-25 are absent (burst loss). Seq 26 must still be accepted.
-    CHECK(mgr.onVoiceFramePushed(kMacA, 26, freshSenderTs(), kFakeOpus, kFakeOpusLen));
+    CHECK(pushAccepted(mgr, kMacA, 26));
 
     mgr.clear();
     std::cout << "Test Seq Gap Accepted By JitterBuffer: PASSED" << std::endl;
@@ -164,9 +196,9 @@ void testDuplicateRejected() {
     PeerAudioManager mgr;
     mgr.registerPeer(kMacA);
 
-    CHECK(mgr.onVoiceFramePushed(kMacA, 42, freshSenderTs(), kFakeOpus, kFakeOpusLen));
-    CHECK(!mgr.onVoiceFramePushed(kMacA, 42, freshSenderTs(), kFakeOpus, kFakeOpusLen));  // dup
-    CHECK(mgr.onVoiceFramePushed(kMacA, 43, freshSenderTs(), kFakeOpus, kFakeOpusLen));
+    CHECK(pushAccepted(mgr, kMacA, 42));
+    CHECK(!pushAccepted(mgr, kMacA, 42));  // dup
+    CHECK(pushAccepted(mgr, kMacA, 43));
 
     mgr.clear();
     std::cout << "Test Duplicate Rejected: PASSED" << std::endl;
@@ -182,6 +214,9 @@ void testPeerVadInitiallyNotTalking() {
     // because the mixer thread was never started.
     CHECK(!mgr.isPeerTalking(kMacA));
     CHECK(!mgr.isPeerTalking(kMacB));  // unregistered peer also returns false
+    CHECK(mgr.talkingMask() == 0);
+    CHECK(mgr.peerLevel(mgr.getDeviceId(kMacA)) == 0);
+    CHECK(mgr.peerLevel(-1) == 0);
 
     mgr.clear();
     std::cout << "Test Peer VAD Initially Not Talking: PASSED" << std::endl;
@@ -197,9 +232,9 @@ void testReRegisterSameDeviceIdAndResetsJitter() {
     int id1 = mgr.registerPeer(kMacA);
 
     // Seed the jitter buffer: seqs 1–3 are now queued.
-    CHECK(mgr.onVoiceFramePushed(kMacA, 1, freshSenderTs(), kFakeOpus, kFakeOpusLen));
-    CHECK(mgr.onVoiceFramePushed(kMacA, 2, freshSenderTs(), kFakeOpus, kFakeOpusLen));
-    CHECK(mgr.onVoiceFramePushed(kMacA, 3, freshSenderTs(), kFakeOpus, kFakeOpusLen));
+    CHECK(pushAccepted(mgr, kMacA, 1));
+    CHECK(pushAccepted(mgr, kMacA, 2));
+    CHECK(pushAccepted(mgr, kMacA, 3));
 
     // Re-register the same MAC — simulates a fast GATT reconnect or role swap.
     int id2 = mgr.registerPeer(kMacA);
@@ -209,9 +244,9 @@ void testReRegisterSameDeviceIdAndResetsJitter() {
 
     // The jitter buffer was reset: seq 1 is no longer in the queue, so it must
     // be accepted as a fresh arrival rather than rejected as a duplicate.
-    CHECK(mgr.onVoiceFramePushed(kMacA, 1, freshSenderTs(), kFakeOpus, kFakeOpusLen));
+    CHECK(pushAccepted(mgr, kMacA, 1));
     // In-order continuation must also be accepted.
-    CHECK(mgr.onVoiceFramePushed(kMacA, 2, freshSenderTs(), kFakeOpus, kFakeOpusLen));
+    CHECK(pushAccepted(mgr, kMacA, 2));
 
     mgr.clear();
     std::cout << "Test Re-Register Same DeviceId And Resets Jitter: PASSED" << std::endl;
@@ -224,18 +259,654 @@ void testMultiplePeersAreIndependent() {
     mgr.registerPeer(kMacA);
     mgr.registerPeer(kMacB);
 
-    CHECK(mgr.onVoiceFramePushed(kMacA, 1, freshSenderTs(), kFakeOpus, kFakeOpusLen));
-    CHECK(mgr.onVoiceFramePushed(kMacB, 100, freshSenderTs(), kFakeOpus, kFakeOpusLen));
-    CHECK(mgr.onVoiceFramePushed(kMacA, 2, freshSenderTs(), kFakeOpus, kFakeOpusLen));
+    CHECK(pushAccepted(mgr, kMacA, 1));
+    CHECK(pushAccepted(mgr, kMacB, 100));
+    CHECK(pushAccepted(mgr, kMacA, 2));
 
     // Duplicate on B must not affect A.
-    CHECK(!mgr.onVoiceFramePushed(kMacB, 100, freshSenderTs(), kFakeOpus, kFakeOpusLen));
-    CHECK(mgr.onVoiceFramePushed(kMacA, 3, freshSenderTs(), kFakeOpus, kFakeOpusLen));
+    CHECK(!pushAccepted(mgr, kMacB, 100));
+    CHECK(pushAccepted(mgr, kMacA, 3));
 
     mgr.clear();
     std::cout << "Test Multiple Peers Are Independent: PASSED" << std::endl;
 }
 
+// Joins draw their state from the warm pool, and each is replaced: a room
+// filling past the pool's size still gets working, independent peers, and
+// the pool is full again after every join.
+void testJoinsDrawFromWarmPool() {
+    PeerAudioManager mgr;
+    CHECK(mgr.warmSpareCount() == audio_config::kPeerWarmSpares);
+    const std::string macs[] = {kMacA, kMacB, "CC:CC:CC:CC:CC:CC", "DD:DD:DD:DD:DD:DD"};
+    static_assert(sizeof(macs) / sizeof(macs[0]) > audio_config::kPeerWarmSpares,
+                  "the room must outgrow the pool");
+    int lastId = 0;
+    for (const std::string& mac : macs) {
+        const int id = mgr.registerPeer(mac);
+        CHECK(id > lastId);
+        lastId = id;
+        CHECK(mgr.warmSpareCount() == audio_config::kPeerWarmSpares);
+    }
+    for (const std::string& mac : macs) {
+        CHECK(pushAccepted(mgr, mac, 1));
+        CHECK(!pushAccepted(mgr, mac, 1));
+    }
+    mgr.clear();
+    std::cout << "Test Joins Draw From Warm Pool: PASSED" << std::endl;
+}
+
+// The receive path only queues: nothing reaches the jitter buffer until a
+// drain, a drain moves everything queued, and a full queue refuses (rather
+// than blocks) the receive thread.
+void testArrivalsQueueUntilDrained() {
+    PeerAudioManager mgr;
+    mgr.registerPeer(kMacA);
+
+    for (uint32_t seq = 1; seq <= 3; ++seq) {
+        CHECK(mgr.onVoiceFramePushed(kMacA, seq, freshSenderTs(), kFakeOpus,
+                                     kFakeOpusLen));
+    }
+    CHECK(mgr.getTelemetry(kMacA).recvCount == 0);
+    CHECK(mgr.drainArrivals(kMacA) == 3);
+    CHECK(mgr.getTelemetry(kMacA).recvCount == 3);
+    CHECK(mgr.drainArrivals(kMacA) == 0);
+
+    for (uint32_t i = 0; i < audio_config::kArrivalQueueSlots; ++i) {
+        CHECK(mgr.onVoiceFramePushed(kMacA, 100 + i, freshSenderTs(), kFakeOpus,
+                                     kFakeOpusLen));
+    }
+    CHECK(!mgr.onVoiceFramePushed(kMacA, 200, freshSenderTs(), kFakeOpus,
+                                  kFakeOpusLen));
+    CHECK(mgr.drainArrivals(kMacA) > 0);
+    CHECK(mgr.drainArrivals("no-such-peer") == 0);
+
+    mgr.clear();
+    std::cout << "Test Arrivals Queue Until Drained: PASSED" << std::endl;
+}
+
+// A registered-but-silent room parks the mixer tick, and the next arriving
+// frame wakes it. The frame itself must be accepted (the park reset the
+// jitter buffer to cold start, so any seq is fresh) — waking must not cost
+// the first frame.
+void testIdleMixerParksAndWakesOnFrame() {
+    PeerAudioManager mgr;
+    mgr.registerPeer(kMacA);
+    CHECK(mgr.startMixerThread());
+    CHECK(waitFor([&] { return mgr.isMixerParked(); }, kParkTimeoutMs));
+
+    CHECK(mgr.onVoiceFramePushed(kMacA, 5000, freshSenderTs(), kFakeOpus, kFakeOpusLen));
+    CHECK(waitFor([&] { return !mgr.isMixerParked(); }, 500));
+
+    mgr.clear();
+    std::cout << "Test Idle Mixer Parks And Wakes On Frame: PASSED" << std::endl;
+}
+
+// Local mic activity wakes a parked tick, and stop must not hang on a parked
+// thread.
+void testParkedMixerWakesOnLocalActivityAndStops() {
+    PeerAudioManager mgr;
+    mgr.registerPeer(kMacA);
+    CHECK(mgr.startMixerThread());
+    CHECK(waitFor([&] { return mgr.isMixerParked(); }, kParkTimeoutMs));
+
+    mgr.noteLocalActivity();
+    CHECK(waitFor([&] { return !mgr.isMixerParked(); }, 500));
+
+    // Quiet again: it re-parks, and stopping from parked joins promptly.
+    CHECK(waitFor([&] { return mgr.isMixerParked(); }, kParkTimeoutMs));
+    mgr.stopMixerThread();
+    CHECK(!mgr.isMixerParked());
+
+    mgr.clear();
+    std::cout << "Test Parked Mixer Wakes On Local Activity And Stops: PASSED"
+              << std::endl;
+}
+
+// A peer that stops sending gets a bounded PLC tail and then goes dormant.
+// Frames arriving wake it: once the lead-in reaches the target depth the
+// buffer drains (decoding resumed), and when the stream stops again the peer
+// goes back to sleep.
+void testSilentPeerGoesDormantAndResumes() {
+    PeerAudioManager mgr;
+    mgr.registerPeer(kMacA);
+    CHECK(!mgr.isPeerDormant(kMacA));
+    CHECK(mgr.startMixerThread());
+    // Never primed: the tail runs from the first tick.
+    CHECK(waitFor([&] { return mgr.isPeerDormant(kMacA); }, 1000));
+
+    const auto target = mgr.getTelemetry(kMacA).jitterTargetDepth;
+    for (uint32_t seq = 100; seq < 100 + target; ++seq) {
+        CHECK(mgr.onVoiceFramePushed(kMacA, seq, freshSenderTs(), kFakeOpus,
+                                     kFakeOpusLen));
+    }
+    CHECK(waitFor([&] { return mgr.getTelemetry(kMacA).jitterCurrentDepth == 0; },
+                  1000));
+    CHECK(waitFor([&] { return mgr.isPeerDormant(kMacA); }, 1000));
+
+    mgr.clear();
+    CHECK(!mgr.isPeerDormant(kMacA));
+    std::cout << "Test Silent Peer Goes Dormant And Resumes: PASSED" << std::endl;
+}
+
+// Decode-on-arrival keeps playout identical in shape: a primed stream still
+// drains, a hole in it is still concealed at playout time (counted as loss),
+// and frames past the hole still play.
+void testDecodeOnArrivalDrainsAcrossHole() {
+    PeerAudioManager mgr;
+    mgr.setDecodeOnArrival(true);
+    CHECK(mgr.decodeOnArrival());
+    mgr.registerPeer(kMacA);
+    CHECK(mgr.startMixerThread());
+
+    const auto target = mgr.getTelemetry(kMacA).jitterTargetDepth;
+    uint32_t seq = 200;
+    for (uint32_t i = 0; i < target; ++i, ++seq) {
+        CHECK(mgr.onVoiceFramePushed(kMacA, seq, freshSenderTs(), kFakeOpus,
+                                     kFakeOpusLen));
+    }
+    CHECK(waitFor([&] { return mgr.getTelemetry(kMacA).jitterCurrentDepth == 0; },
+                  1000));
+
+    // Now primed: these decode on arrival, except behind the hole at seq+1.
+    const auto lostBefore = mgr.getTelemetry(kMacA).lostFrameCount;
+    for (uint32_t i = 0; i < target + 2; ++i) {
+        if (i == 1) continue;
+        CHECK(mgr.onVoiceFramePushed(kMacA, seq + i, freshSenderTs(), kFakeOpus,
+                                     kFakeOpusLen));
+    }
+    CHECK(waitFor([&] { return mgr.getTelemetry(kMacA).jitterCurrentDepth == 0; },
+                  1000));
+    CHECK(mgr.getTelemetry(kMacA).lostFrameCount > lostBefore);
+
+    mgr.clear();
+    std::cout << "Test Decode On Arrival Drains Across Hole: PASSED" << std::endl;
+}
+
+// A frame stamped `transitMs` before now on the local steady clock — the
+// same clock the receive path reads — so its raw transit is known.
+uint32_t senderTsWithTransit(int64_t transitMs) {
+    const int64_t nowMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+                              std::chrono::steady_clock::now().time_since_epoch())
+                              .count();
+    return static_cast<uint32_t>(nowMs - transitMs);
+}
+
+// A reconnect keeps the previous link's transit baseline, so the first frame
+// of the new link already reads its excess; a baseline from a different
+// clock epoch is refused.
+void testWarmStartCarriesLagBaselineAcrossReconnect() {
+    PeerAudioManager mgr;
+    mgr.registerPeer(kMacA);
+    CHECK(mgr.startMixerThread());
+    CHECK(mgr.onVoiceFramePushed(kMacA, 10, senderTsWithTransit(0), kFakeOpus,
+                                 kFakeOpusLen));
+    // Fast start: a single frame plays, priming the link.
+    CHECK(waitFor([&] {
+        const auto t = mgr.getTelemetry(kMacA);
+        return t.recvCount == 1 && t.jitterCurrentDepth == 0;
+    }, 1000));
+
+    mgr.unregisterPeer(kMacA);
+    mgr.registerPeer(kMacA);
+    CHECK(mgr.onVoiceFramePushed(kMacA, 500, senderTsWithTransit(300), kFakeOpus,
+                                 kFakeOpusLen));
+    CHECK(waitFor([&] { return mgr.getTelemetry(kMacA).currentLagMs >= 250; },
+                  1000));
+    CHECK(waitFor([&] { return mgr.getTelemetry(kMacA).jitterCurrentDepth == 0; },
+                  1000));
+
+    // Sender rebooted: its timestamps moved by far more than the tolerance.
+    mgr.registerPeer(kMacA);
+    CHECK(mgr.onVoiceFramePushed(kMacA, 7, senderTsWithTransit(100000),
+                                 kFakeOpus, kFakeOpusLen));
+    CHECK(waitFor([&] { return mgr.getTelemetry(kMacA).currentLagMs == 0; },
+                  1000));
+
+    mgr.clear();
+    std::cout << "Test Warm Start Carries Lag Baseline Across Reconnect: PASSED"
+              << std::endl;
+}
+
+// The integer handle registerPeer() returns reaches the same peer as its
+// MAC, survives re-register, and goes dead (without aliasing a newer peer)
+// once the peer unregisters.
+void testHandleApiResolvesAndRetires() {
+    PeerAudioManager mgr;
+    const int h = mgr.registerPeer(kMacA);
+    CHECK(h > 0);
+    CHECK(mgr.registerPeer(kMacA) == h);
+
+    CHECK(pushAccepted(mgr, h, 1));
+    CHECK(!pushAccepted(mgr, h, 1));
+    CHECK(mgr.getTelemetry(h).valid);
+    CHECK(mgr.getTelemetry(h).recvCount == mgr.getTelemetry(kMacA).recvCount);
+    CHECK(mgr.setPeerBitrate(h, audio_config::kBitrateLow) ==
+          audio_config::kBitrateLow);
+    // A hint is a ceiling: lowering it cuts at once, raising it leaves the
+    // climb to the controller.
+    CHECK(mgr.setPeerBitrate(h, audio_config::kBitrateHigh) ==
+          audio_config::kBitrateLow);
+
+    // The outbound ring outlives the peer for a writer holding it, and
+    // unregistration tells that writer to let go.
+    auto ring = mgr.outboundRing(h);
+    CHECK(ring != nullptr);
+    CHECK(ring->peek(0) == OutboundFrameRing::kEmpty);
+
+    mgr.unregisterPeer(kMacA);
+    CHECK(ring->peek(0) == OutboundFrameRing::kClosed);
+    CHECK(mgr.outboundRing(h) == nullptr);
+    CHECK(!mgr.getTelemetry(h).valid);
+    CHECK(!pushAccepted(mgr, h, 2));
+    CHECK(mgr.setPeerBitrate(h, audio_config::kBitrateLow) == -1);
+    CHECK(!mgr.getTelemetry(-1).valid);
+    CHECK(!mgr.getTelemetry(0).valid);
+
+    // Fill every slot: each new peer gets a distinct live handle, none equal
+    // to the retired one, and the table refuses one more.
+    for (size_t i = 0; i < audio_config::kPeerHandleSlots; ++i) {
+        const int hi = mgr.registerPeer("peer-" + std::to_string(i));
+        CHECK(hi > 0 && hi != h);
+        CHECK(mgr.getTelemetry(hi).valid);
+    }
+    CHECK(mgr.registerPeer("one-too-many") == -1);
+
+    // A handle Kotlin still holds from before a clear, or from the manager
+    // a re-init replaced, never resolves to a newer peer.
+    mgr.clear();
+    const int afterClear = mgr.registerPeer(kMacB);
+    CHECK(afterClear > h && !mgr.getTelemetry(h).valid);
+    PeerAudioManager reinit;
+    CHECK(reinit.registerPeer(kMacA) > afterClear);
+    CHECK(!reinit.getTelemetry(h).valid && !reinit.getTelemetry(afterClear).valid);
+
+    reinit.clear();
+    mgr.clear();
+    std::cout << "Test Handle Api Resolves And Retires: PASSED" << std::endl;
+}
+
+// The mixer publishes every registered peer to the telemetry board; one
+// lock-free snapshot reads the whole room, and a peer that unregisters drops
+// out of it immediately.
+void testTelemetrySnapshotCoversRoom() {
+    PeerAudioManager mgr;
+    const int hA = mgr.registerPeer(kMacA);
+    const int hB = mgr.registerPeer(kMacB);
+    constexpr size_t kRecordInts = PeerAudioManager::kTelemetryRecordInts;
+    constexpr size_t kRecvCountField = 8;  // see marshalTelemetry()
+    int32_t records[audio_config::kPeerHandleSlots * kRecordInts];
+    CHECK(mgr.snapshotTelemetry(records, audio_config::kPeerHandleSlots) == 0);
+
+    CHECK(mgr.startMixerThread());
+    CHECK(mgr.onVoiceFramePushed(hA, 1, freshSenderTs(), kFakeOpus, kFakeOpusLen));
+    CHECK(waitFor([&] {
+        const size_t n =
+            mgr.snapshotTelemetry(records, audio_config::kPeerHandleSlots);
+        bool sawA = false;
+        bool sawB = false;
+        for (size_t i = 0; i < n; ++i) {
+            const int32_t* r = records + i * kRecordInts;
+            if (r[0] == hA) sawA = r[1 + kRecvCountField] == 1;
+            if (r[0] == hB) sawB = true;
+        }
+        return n == 2 && sawA && sawB;
+    }, 1000));
+    // An idle host tick is far under budget: full complexity, level 0.
+    constexpr size_t kComplexityField = 24;
+    CHECK(records[1 + kComplexityField] == audio_config::kGovernorComplexity[0]);
+    CHECK(records[1 + kComplexityField + 1] == 0);
+    // Room for one record only: nothing is written past it.
+    CHECK(mgr.snapshotTelemetry(records, 1) == 1);
+
+    mgr.unregisterPeer(kMacB);
+    CHECK(mgr.snapshotTelemetry(records, audio_config::kPeerHandleSlots) == 1);
+    CHECK(records[0] == hA);
+
+    mgr.clear();
+    CHECK(mgr.snapshotTelemetry(records, audio_config::kPeerHandleSlots) == 0);
+    std::cout << "Test Telemetry Snapshot Covers Room: PASSED" << std::endl;
+}
+
+// With nobody draining a peer's outbound ring, the tick stops encoding for
+// it once the backlog reaches the congestion mark — the ring never fills —
+// and resumes once the writer catches up.
+void testCongestedOutboundSkipsEncode() {
+    PeerAudioManager mgr;
+    const int h = mgr.registerPeer(kMacA);
+    auto ring = mgr.outboundRing(h);
+    CHECK(mgr.startMixerThread());
+    mgr.noteLocalActivity();
+    CHECK(waitFor([&] { return ring->congestionSkipCount() >= 2; }, 1000));
+    CHECK(ring->depth() == audio_config::kOutboundCongestedFrames);
+    CHECK(ring->fullDropCount() == 0);
+
+    while (ring->peek(0) >= 0) ring->release();
+    mgr.noteLocalActivity();
+    CHECK(waitFor([&] { return ring->depth() > 0; }, 1000));
+    CHECK(ring->peek(0) >= 0);
+
+    mgr.clear();
+    std::cout << "Test Congested Outbound Skips Encode: PASSED" << std::endl;
+}
+
+// A bundled VoiceFrame lands as one arrival per frame, under consecutive
+// seqs; a malformed one is refused whole.
+void testBundleUnpacksPerSeq() {
+    PeerAudioManager mgr;
+    mgr.registerPeer(kMacA);
+
+    BundleAccumulator acc;
+    for (uint32_t i = 0; i < 3; ++i) {
+        std::memcpy(acc.nextFrame(), kFakeOpus, kFakeOpusLen);
+        acc.add(10 + i, 0, kFakeOpusLen);
+    }
+    uint8_t bundle[OutboundFrameRing::kMaxPayloadBytes];
+    const int len = static_cast<int>(acc.flush(bundle));
+    CHECK(mgr.onVoiceFramePushed(kMacA, 10, freshSenderTs(), bundle, len));
+    CHECK(mgr.drainArrivals(kMacA) == 3);
+    CHECK(mgr.getTelemetry(kMacA).recvCount == 3);
+    CHECK(mgr.getTelemetry(kMacA).lastSeq == 12);
+
+    bundle[2] = 0;  // frame count 0
+    CHECK(!mgr.onVoiceFramePushed(kMacA, 13, freshSenderTs(), bundle, len));
+    CHECK(mgr.drainArrivals(kMacA) == 0);
+
+    mgr.clear();
+    std::cout << "Test Bundle Unpacks Per Seq: PASSED" << std::endl;
+}
+
+// The first things a link sends are header-only bundle and compact-header
+// offers, and a peer's offer is recorded (clamped) without touching its
+// voice stream.
+void testLinkOffersBundles() {
+    PeerAudioManager mgr;
+    const int h = mgr.registerPeer(kMacA);
+    auto ring = mgr.outboundRing(h);
+    CHECK(mgr.startMixerThread());
+    mgr.noteLocalActivity();
+    CHECK(waitFor([&] { return ring->depth() > 0; }, 1000));
+    const int offset = ring->peek(0);
+    CHECK(offset >= 0);
+    const uint8_t* frame = ring->storage() + offset;
+    CHECK(frame[0] == 0 && frame[1] == audio_config::kVoiceFrameHeaderBytes);
+    CHECK(frame[5] == audio_config::kLinkControlBundleOffer);
+    CHECK(frame[9] == audio_config::kMaxBundleFrames);
+    ring->release();
+    CHECK(waitFor([&] { return ring->peek(0) >= 0; }, 1000));
+    frame = ring->storage() + ring->peek(0);
+    CHECK(frame[5] == audio_config::kLinkControlCompactHeaderOffer);
+    CHECK(frame[9] == audio_config::kCompactHeaderVersion);
+
+    mgr.onLinkControlFrame(h, audio_config::kLinkControlBundleOffer, 99);
+    mgr.onLinkControlFrame(h, 0xFFFF, 1);
+    CHECK(mgr.getTelemetry(kMacA).recvCount == 0);
+    CHECK(mgr.getTelemetry(kMacA).outboundFramesPerPacket == 1);
+
+    mgr.clear();
+    std::cout << "Test Link Offers Bundles: PASSED" << std::endl;
+}
+
+// With the room kept awake but this peer's mix silent, silence suppression
+// stops sending it frames after the hangover and says so with a
+// talkspurt-end frame; with suppression off, the silent mix keeps flowing.
+void testSilentMixEndsTalkspurt() {
+    // Drain `ring` while keeping the room active for `ms`. Returns how many
+    // voice frames went out, and stores whether a talkspurt end did.
+    auto drain = [](PeerAudioManager& mgr, OutboundFrameRing& ring, int ms,
+                    bool* ended) {
+        int voice = 0;
+        const auto deadline =
+            std::chrono::steady_clock::now() + std::chrono::milliseconds(ms);
+        while (std::chrono::steady_clock::now() < deadline) {
+            mgr.noteLocalActivity();
+            for (int offset; (offset = ring.peek(0)) >= 0; ring.release()) {
+                const uint8_t* frame = ring.storage() + offset;
+                const bool control = frame[0] == 0 &&
+                                     frame[1] == audio_config::kVoiceFrameHeaderBytes;
+                if (!control) {
+                    ++voice;
+                } else if (frame[5] == audio_config::kLinkControlTalkspurtEnd) {
+                    *ended = true;
+                }
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+        return voice;
+    };
+    const int hangoverMs =
+        audio_config::kTalkspurtHangoverTicks * audio_config::kMixerTickIntervalMs;
+
+    PeerAudioManager mgr;
+    const int h = mgr.registerPeer(kMacA);
+    auto ring = mgr.outboundRing(h);
+    CHECK(mgr.silenceSuppression());
+    CHECK(mgr.startMixerThread());
+    bool ended = false;
+    CHECK(drain(mgr, *ring, hangoverMs * 3, &ended) > 0);
+    CHECK(ended);
+    // Gated: nothing more while the mix stays silent.
+    ended = false;
+    CHECK(drain(mgr, *ring, hangoverMs, &ended) == 0);
+    CHECK(!ended);
+
+    mgr.setSilenceSuppression(false);
+    CHECK(drain(mgr, *ring, hangoverMs * 2, &ended) > 0);
+    CHECK(!ended);
+
+    mgr.clear();
+    std::cout << "Test Silent Mix Ends Talkspurt: PASSED" << std::endl;
+}
+
+// A talkspurt-end frame from the peer is an announced pause: the receiver
+// drains what it has without counting an underrun.
+void testAnnouncedPauseIsNotAnUnderrun() {
+    PeerAudioManager mgr;
+    const int h = mgr.registerPeer(kMacA);
+    for (uint32_t seq = 1; seq <= audio_config::kJitterInitialDepth; ++seq) {
+        CHECK(pushAccepted(mgr, kMacA, seq));
+    }
+    mgr.onLinkControlFrame(h, audio_config::kLinkControlTalkspurtEnd,
+                           audio_config::kJitterInitialDepth + 1);
+    CHECK(mgr.drainArrivals(kMacA) == 0);
+    CHECK(mgr.startMixerThread());
+    CHECK(waitFor([&] { return mgr.getTelemetry(kMacA).jitterCurrentDepth == 0; }, 1000));
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    CHECK(mgr.getTelemetry(kMacA).underrunCount == 0);
+
+    mgr.clear();
+    std::cout << "Test Announced Pause Is Not An Underrun: PASSED" << std::endl;
+}
+
+// The low-latency profile asks a peer for 10 ms frames once the rest of the
+// room has asked us, and runs on them only once every peer has; withdrawing
+// it, or any peer's withdrawal, puts the room back on 20 ms frames.
+void testLowLatencyNeedsWholeRoom() {
+    // The frame duration the last low-latency offer on `ring` asked for, or
+    // 0 if none went out. Drains the ring.
+    auto lowLatencyAsk = [](OutboundFrameRing& ring) {
+        int ask = 0;
+        for (int offset; (offset = ring.peek(0)) >= 0; ring.release()) {
+            const uint8_t* frame = ring.storage() + offset;
+            if (frame[0] == 0 && frame[1] == audio_config::kVoiceFrameHeaderBytes &&
+                frame[5] == audio_config::kLinkControlLowLatencyOffer) {
+                ask = frame[9];
+            }
+        }
+        return ask;
+    };
+
+    PeerAudioManager mgr;
+    const int hA = mgr.registerPeer(kMacA);
+    const int hB = mgr.registerPeer(kMacB);
+    auto ringA = mgr.outboundRing(hA);
+    auto ringB = mgr.outboundRing(hB);
+    CHECK(!mgr.lowLatencyProfile());
+    mgr.setLowLatencyProfile(true);
+    mgr.onLinkControlFrame(hA, audio_config::kLinkControlLowLatencyOffer,
+                           audio_config::kLowLatencyFrameDurationMs);
+    CHECK(mgr.startMixerThread());
+    mgr.noteLocalActivity();
+
+    // A has asked, so B is asked; B hasn't, so A isn't, and the room stays
+    // on 20 ms frames.
+    int askB = 0;
+    CHECK(waitFor([&] {
+        askB = lowLatencyAsk(*ringB);
+        return askB != 0;
+    }, 1000));
+    CHECK(askB == audio_config::kLowLatencyFrameDurationMs);
+    CHECK(lowLatencyAsk(*ringA) == 0);
+    CHECK(mgr.frameDurationMs() == audio_config::kFrameDurationMs);
+
+    mgr.onLinkControlFrame(hB, audio_config::kLinkControlLowLatencyOffer,
+                           audio_config::kLowLatencyFrameDurationMs);
+    CHECK(waitFor([&] {
+        mgr.noteLocalActivity();
+        return mgr.frameDurationMs() == audio_config::kLowLatencyFrameDurationMs;
+    }, 1000));
+
+    mgr.onLinkControlFrame(hB, audio_config::kLinkControlLowLatencyOffer,
+                           audio_config::kFrameDurationMs);
+    CHECK(waitFor([&] {
+        mgr.noteLocalActivity();
+        return mgr.frameDurationMs() == audio_config::kFrameDurationMs;
+    }, 1000));
+
+    mgr.clear();
+    std::cout << "Test Low Latency Needs Whole Room: PASSED" << std::endl;
+}
+
+// A peer that reconnects under the same MAC starts from 20 ms frames: the
+// 10 ms ask its old link made no longer holds the room on 10 ms.
+void testReRegisterDropsLowLatencyAsk() {
+    PeerAudioManager mgr;
+    const int hA = mgr.registerPeer(kMacA);
+    const int hB = mgr.registerPeer(kMacB);
+    mgr.setLowLatencyProfile(true);
+    mgr.onLinkControlFrame(hA, audio_config::kLinkControlLowLatencyOffer,
+                           audio_config::kLowLatencyFrameDurationMs);
+    mgr.onLinkControlFrame(hB, audio_config::kLinkControlLowLatencyOffer,
+                           audio_config::kLowLatencyFrameDurationMs);
+    CHECK(mgr.startMixerThread());
+    CHECK(waitFor([&] {
+        mgr.noteLocalActivity();
+        return mgr.frameDurationMs() == audio_config::kLowLatencyFrameDurationMs;
+    }, 1000));
+
+    CHECK(mgr.registerPeer(kMacB) == hB);
+    CHECK(waitFor([&] {
+        mgr.noteLocalActivity();
+        return mgr.frameDurationMs() == audio_config::kFrameDurationMs;
+    }, 1000));
+
+    mgr.clear();
+    std::cout << "Test Re-Register Drops Low Latency Ask: PASSED" << std::endl;
+}
+
+// A talkspurt that opens deep in the jitter buffer plays out whole unless
+// the peer has offered pre-roll; once it has, the next one crossfade-merges
+// its announced frames away, the first on the talkspurt's first tick.
+void testCatchUpNeedsPreRollOffer() {
+    PeerAudioManager mgr;
+    const int h = mgr.registerPeer(kMacA);
+    const uint32_t burst = audio_config::kJitterInitialDepth + audio_config::kPreRollFrames;
+    uint32_t seq = 1;
+    for (; seq <= burst; ++seq) CHECK(pushAccepted(mgr, kMacA, seq));
+    mgr.onLinkControlFrame(h, audio_config::kLinkControlTalkspurtEnd, seq);
+    CHECK(mgr.startMixerThread());
+    CHECK(waitFor([&] { return mgr.getTelemetry(kMacA).jitterCurrentDepth == 0; }, 1000));
+    CHECK(mgr.catchUpMergeCount(h) == 0);
+    mgr.stopMixerThread();
+
+    mgr.onLinkControlFrame(h, audio_config::kLinkControlPreRollOffer,
+                           audio_config::kPreRollFrames);
+    for (const uint32_t end = seq + burst; seq < end; ++seq) {
+        CHECK(pushAccepted(mgr, kMacA, seq));
+    }
+    CHECK(mgr.startMixerThread());
+    CHECK(waitFor([&] { return mgr.catchUpMergeCount(h) > 0; }, 1000));
+    CHECK(mgr.catchUpMergeCount(h) <= audio_config::kPreRollFrames);
+
+    mgr.clear();
+    std::cout << "Test Catch Up Needs Pre-Roll Offer: PASSED" << std::endl;
+}
+
+// A talkspurt that opens on keyed local voice goes out behind a back-dated
+// pre-roll, on the same seq run, in no more packets than the writer's queue
+// has room for, and the burst doesn't read as congestion.
+void testPreRollFitsWriterQueue() {
+    struct Voice {
+        uint32_t seq;
+        uint32_t tsMs;
+    };
+    auto be32 = [](const uint8_t* p) {
+        return static_cast<uint32_t>(p[0]) << 24 | static_cast<uint32_t>(p[1]) << 16 |
+               static_cast<uint32_t>(p[2]) << 8 | p[3];
+    };
+    // Drain `ring` like its writer while keeping the room active for `ms`,
+    // appending the voice frames that went out and stopping early at a
+    // talkspurt end if `untilEnd`.
+    auto drain = [&](PeerAudioManager& mgr, OutboundFrameRing& ring, int ms,
+                     bool untilEnd, std::vector<Voice>* voice) {
+        const auto deadline =
+            std::chrono::steady_clock::now() + std::chrono::milliseconds(ms);
+        while (std::chrono::steady_clock::now() < deadline) {
+            mgr.noteLocalActivity();
+            for (int offset; (offset = ring.peek(0)) >= 0; ring.release()) {
+                const uint8_t* frame = ring.storage() + offset;
+                if (frame[0] != 0 || frame[1] != audio_config::kVoiceFrameHeaderBytes) {
+                    voice->push_back({be32(frame + 2), be32(frame + 6)});
+                } else if (untilEnd && frame[5] == audio_config::kLinkControlTalkspurtEnd) {
+                    return true;
+                }
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+        return false;
+    };
+    const int hangoverMs =
+        audio_config::kTalkspurtHangoverTicks * audio_config::kMixerTickIntervalMs;
+
+    auto mixer = std::make_shared<AudioMixer>();
+    std::vector<int16_t> history(audio_config::kPreRollRingSamples, 100);
+    mixer->localPreRoll().write(history.data(), history.size(), true);
+    std::atomic_store(&g_audioMixer, mixer);
+
+    PeerAudioManager mgr;
+    const int h = mgr.registerPeer(kMacA);
+    auto ring = mgr.outboundRing(h);
+    CHECK(mgr.startMixerThread());
+    // The link's silent first talkspurt, up to the gate closing it.
+    std::vector<Voice> before;
+    CHECK(drain(mgr, *ring, hangoverMs * 3, true, &before));
+    CHECK(!before.empty());
+
+    // With the gate open again, the next one opens with a pre-roll: one
+    // frame per packet on this link, so kOutboundQueueFrames - 2 of them,
+    // one fewer if a control frame was queued.
+    const uint64_t skips = ring->congestionSkipCount();
+    mgr.setPreRoll(true);
+    mgr.setSilenceSuppression(false);
+    std::vector<Voice> after;
+    drain(mgr, *ring, 200, false, &after);
+    const size_t preRoll = audio_config::kOutboundQueueFrames - 2;
+    CHECK(after.size() > preRoll + 1);
+    for (size_t i = 0; i < after.size(); ++i) {
+        CHECK(after[i].seq == before.back().seq + 1 + i);
+    }
+    const uint32_t frameMs = static_cast<uint32_t>(audio_config::kFrameDurationMs);
+    for (size_t i = 1; i + 1 < preRoll; ++i) {
+        CHECK(after[i].tsMs - after[i - 1].tsMs == frameMs);
+    }
+    CHECK(after[preRoll].tsMs - after[0].tsMs >= (preRoll - 1) * frameMs);
+    CHECK(after[preRoll + 1].tsMs - after[preRoll].tsMs < 2 * frameMs);
+    CHECK(ring->congestionSkipCount() == skips);
+
+    mgr.clear();
+    std::atomic_store(&g_audioMixer, std::shared_ptr<AudioMixer>{});
+    std::cout << "Test Pre-Roll Fits Writer Queue: PASSED" << std::endl;
+}
+
 int main() {
     try {
         testUnregisteredPeerReturnsFalse();
@@ -246,7 +917,25 @@ int main() {
         testDuplicateRejected();
         testReRegisterSameDeviceIdAndResetsJitter();
         testMultiplePeersAreIndependent();
+        testJoinsDrawFromWarmPool();
         testPeerVadInitiallyNotTalking();
+        testSilentPeerGoesDormantAndResumes();
+        testDecodeOnArrivalDrainsAcrossHole();
+        testWarmStartCarriesLagBaselineAcrossReconnect();
+        testArrivalsQueueUntilDrained();
+        testHandleApiResolvesAndRetires();
+        testTelemetrySnapshotCoversRoom();
+        testCongestedOutboundSkipsEncode();
+        testBundleUnpacksPerSeq();
+        testLinkOffersBundles();
+        testSilentMixEndsTalkspurt();
+        testAnnouncedPauseIsNotAnUnderrun();
+        testLowLatencyNeedsWholeRoom();
+        testReRegisterDropsLowLatencyAsk();
+        testCatchUpNeedsPreRollOffer();
+        testPreRollFitsWriterQueue();
+        testIdleMixerParksAndWakesOnFrame();
+        testParkedMixerWakesOnLocalActivityAndStops();
         std::cout << "All PeerAudioManager tests passed!" << std::endl;
     } catch (const std::exception& e) {
         std::cerr << "Test failed: " << e.what() << std::endl;
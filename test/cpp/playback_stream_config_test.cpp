@@ -58,12 +58,19 @@ void testPlayoutAvoidsMmapFastPath() {
            oboe::SharingMode::Exclusive);
 }
 
+void testPlayoutBufferIsDoubleBuffered() {
+    // One burst playing and one being filled: shallower underruns on every
+    // callback, deeper is latency the full-duplex callback doesn't need.
+    assert(audio_engine_config::kPlaybackBufferBursts == 2);
+}
+
 }  // namespace
 
 int main() {
     try {
         testPlayoutUsesVoiceCallStream();
         testPlayoutAvoidsMmapFastPath();
+        testPlayoutBufferIsDoubleBuffered();
         std::cout << "All playback_stream_config tests passed!" << std::endl;
     } catch (const std::exception& e) {
         std::cerr << "Test failed: " << e.what() << std::endl;
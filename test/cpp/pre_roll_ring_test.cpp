@@ -0,0 +1,107 @@
+// Host-buildable test for pre_roll_ring.h (header-only).
+//
+// Compile (see scripts/run_native_cpp_tests.sh):
+//   g++ -std=c++17 -Wall -Wextra -pthread -I android/app/src/main/cpp
+//       test/cpp/pre_roll_ring_test.cpp -o build/cpp_test/pre_roll_ring_test
+
+#include "pre_roll_ring.h"
+
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#define CHECK(cond)                                                          \
+    do {                                                                     \
+        if (!(cond)) {                                                       \
+            std::cerr << "CHECK failed: " #cond                              \
+                      << " (" << __FILE__ << ":" << __LINE__ << ")"          \
+                      << std::endl;                                          \
+            std::exit(1);                                                    \
+        }                                                                    \
+    } while (0)
+
+namespace {
+
+// Write `n` samples counting up from `first`, as one capture burst.
+void writeRamp(PreRollRing& ring, int first, size_t n, bool keyed = true) {
+    std::vector<int16_t> burst(n);
+    for (size_t i = 0; i < n; ++i) burst[i] = static_cast<int16_t>(first + i);
+    ring.write(burst.data(), n, keyed);
+}
+
+}  // namespace
+
+// The copy ends skipNewest samples before the newest, oldest first.
+void testCopyBeforeSkipsNewest() {
+    auto ring = std::make_unique<PreRollRing>();
+    writeRamp(*ring, 0, 480);
+    writeRamp(*ring, 480, 480);
+    int16_t out[100];
+    CHECK(ring->copyBefore(out, 100, 0) == 100);
+    CHECK(out[0] == 860 && out[99] == 959);
+    CHECK(ring->copyBefore(out, 100, 300) == 100);
+    CHECK(out[0] == 560 && out[99] == 659);
+    std::cout << "Test Copy Before Skips Newest: PASSED" << std::endl;
+}
+
+// Not enough history yet, or more than the ring holds: nothing, rather than
+// a copy padded with whatever was there before.
+void testShortHistoryCopiesNothing() {
+    auto ring = std::make_unique<PreRollRing>();
+    int16_t out[PreRollRing::kCapacity];
+    CHECK(ring->copyBefore(out, 10, 0) == 0);
+    writeRamp(*ring, 0, 480);
+    CHECK(ring->copyBefore(out, 400, 100) == 0);
+    CHECK(ring->copyBefore(out, 380, 100) == 380);
+    CHECK(ring->copyBefore(out, 0, 0) == 0);
+    for (int i = 0; i < 20; ++i) writeRamp(*ring, 480 * (i + 1), 480);
+    CHECK(ring->copyBefore(out, PreRollRing::kCapacity, 1) == 0);
+    CHECK(ring->copyBefore(out, PreRollRing::kCapacity, 0) == PreRollRing::kCapacity);
+    std::cout << "Test Short History Copies Nothing: PASSED" << std::endl;
+}
+
+// Across the ring's end, the samples come back in capture order.
+void testWrapAroundKeepsOrder() {
+    auto ring = std::make_unique<PreRollRing>();
+    const size_t burst = 480;
+    const size_t bursts = PreRollRing::kCapacity / burst + 3;
+    for (size_t b = 0; b < bursts; ++b) {
+        writeRamp(*ring, static_cast<int>(b * burst) % 30000, burst);
+    }
+    const size_t n = 2880;  // straddles the wrap for this burst count
+    std::vector<int16_t> out(n);
+    CHECK(ring->copyBefore(out.data(), n, 0) == n);
+    const size_t newest = bursts * burst - 1;
+    for (size_t i = 0; i < n; ++i) {
+        const size_t sample = newest - (n - 1 - i);
+        const int burstStart = static_cast<int>((sample / burst) * burst) % 30000;
+        CHECK(out[i] == static_cast<int16_t>(burstStart + sample % burst));
+    }
+    std::cout << "Test Wrap Around Keeps Order: PASSED" << std::endl;
+}
+
+// keyed() follows the latest write; a fresh ring doesn't hold anyone back.
+void testKeyedFollowsLatestWrite() {
+    auto ring = std::make_unique<PreRollRing>();
+    CHECK(ring->keyed());
+    writeRamp(*ring, 0, 480, false);
+    CHECK(!ring->keyed());
+    writeRamp(*ring, 480, 480, true);
+    CHECK(ring->keyed());
+    // Muted history is still history: the pre-roll reaches back past the key.
+    int16_t out[960];
+    CHECK(ring->copyBefore(out, 960, 0) == 960);
+    CHECK(out[0] == 0);
+    std::cout << "Test Keyed Follows Latest Write: PASSED" << std::endl;
+}
+
+int main() {
+    testCopyBeforeSkipsNewest();
+    testShortHistoryCopiesNothing();
+    testWrapAroundKeepsOrder();
+    testKeyedFollowsLatestWrite();
+    std::cout << "All pre_roll_ring tests passed!" << std::endl;
+    return 0;
+}
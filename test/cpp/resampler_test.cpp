@@ -216,6 +216,111 @@ void testResetClearsHistory() {
     std::cout << "Test Reset Clears History: PASSED" << std::endl;
 }
 
+// At unity step the drift resampler is a pure two-sample delay: every frame
+// written yields exactly one frame out, bit-exact.
+void testVariableRatioUnityIsExact() {
+    VariableRatioResampler r;
+    const int n = audio_config::kCodecFrameSize;
+    std::vector<int16_t> in = makeSine(n * 3, 440.0, audio_config::kCodecSampleRate);
+    std::vector<int16_t> out(n * 3, 0);
+    int total = 0;
+    for (int f = 0; f < 3; ++f) {
+        assert(r.inputNeeded(n) == n);
+        assert(r.write(in.data() + f * n, n) == n);
+        assert(r.inputNeeded(n) <= 0);
+        const int got = r.read(out.data() + total, n);
+        assert(got == n);
+        total += got;
+    }
+    assert(out[0] == 0 && out[1] == 0);
+    for (int i = 2; i < total; ++i) {
+        assert(out[i] == in[i - 2]);
+    }
+    std::cout << "Test Variable Ratio Unity Is Exact: PASSED" << std::endl;
+}
+
+// A fast sender (step > 1) must be consumed faster: over many ticks of one
+// pull per tick, the reservoir eventually asks for a second frame. A slow
+// sender (step < 1) eventually leaves a whole surplus frame to skip a pull.
+void testVariableRatioPullCadence() {
+    const int n = audio_config::kCodecFrameSize;
+    std::vector<int16_t> in(n, 1000);
+    std::vector<int16_t> out(n, 0);
+
+    VariableRatioResampler fast;
+    fast.setStep(1.0 + 500e-6);
+    int writes = 0;
+    for (int tick = 0; tick < 5000; ++tick) {
+        while (fast.inputNeeded(n) > 0) {
+            fast.write(in.data(), n);
+            ++writes;
+        }
+        assert(fast.read(out.data(), n) == n);
+    }
+    // 5000 ticks at +500 ppm consume ~2.5 extra frames.
+    assert(writes >= 5002 && writes <= 5004);
+
+    VariableRatioResampler slow;
+    slow.setStep(1.0 - 500e-6);
+    writes = 0;
+    for (int tick = 0; tick < 5000; ++tick) {
+        if (slow.inputNeeded(n) > 0) {
+            slow.write(in.data(), n);
+            ++writes;
+        }
+        assert(slow.read(out.data(), n) == n);
+    }
+    assert(writes >= 4996 && writes <= 4998);
+    std::cout << "Test Variable Ratio Pull Cadence: PASSED" << std::endl;
+}
+
+// A tone resampled at a few hundred ppm keeps its level and shows no
+// discontinuities across frame boundaries.
+void testVariableRatioPreservesTone() {
+    const int n = audio_config::kCodecFrameSize;
+    VariableRatioResampler r;
+    r.setStep(1.0 + 300e-6);
+    std::vector<int16_t> src = makeSine(n * 60, 1000.0, audio_config::kCodecSampleRate);
+    std::vector<int16_t> dst;
+    std::vector<int16_t> out(n, 0);
+    size_t srcPos = 0;
+    for (int tick = 0; tick < 50; ++tick) {
+        while (r.inputNeeded(n) > 0 && srcPos + n <= src.size()) {
+            r.write(src.data() + srcPos, n);
+            srcPos += n;
+        }
+        const int got = r.read(out.data(), n);
+        dst.insert(dst.end(), out.begin(), out.begin() + got);
+    }
+    const double srcRms = rms(src.data() + n, n * 40);
+    const double dstRms = rms(dst.data() + n, n * 40);
+    assert(std::fabs(dstRms / srcRms - 1.0) < 0.01);
+    // Max step between adjacent samples of a 1 kHz half-scale sine at 24 kHz
+    // is ~16384·2π·1000/24000 ≈ 4300; a splice glitch would blow past it.
+    int maxStep = 0;
+    for (size_t i = n + 1; i < dst.size(); ++i) {
+        maxStep = std::max(maxStep, std::abs(dst[i] - dst[i - 1]));
+    }
+    assert(maxStep < 4500);
+    std::cout << "Test Variable Ratio Preserves Tone: PASSED" << std::endl;
+}
+
+void testVariableRatioReset() {
+    const int n = audio_config::kCodecFrameSize;
+    VariableRatioResampler r;
+    r.setStep(1.0003);
+    std::vector<int16_t> loud(n, 20000);
+    r.write(loud.data(), n);
+    r.reset();
+    assert(r.step() == 1.0);
+    std::vector<int16_t> silence(n, 0);
+    std::vector<int16_t> out(n, 1);
+    r.write(silence.data(), n);
+    assert(r.read(out.data(), n) == n);
+    for (int i = 0; i < n; ++i) assert(out[i] == 0);
+    std::cout << "Test Variable Ratio Reset: PASSED" << std::endl;
+}
+
 }  // namespace
 
 int main() {
@@ -227,6 +332,10 @@ int main() {
         testDecimatorDcGainUnity();
         testRoundTripPreservesLowFreq();
         testResetClearsHistory();
+        testVariableRatioUnityIsExact();
+        testVariableRatioPullCadence();
+        testVariableRatioPreservesTone();
+        testVariableRatioReset();
         std::cout << "All Resampler tests passed!" << std::endl;
     } catch (const std::exception& e) {
         std::cerr << "Test failed: " << e.what() << std::endl;
@@ -0,0 +1,100 @@
+// Host-buildable test for TalkingState (header-only).
+//
+// Compile (see scripts/run_native_cpp_tests.sh):
+//   g++ -std=c++17 -Wall -Wextra -pthread -I android/app/src/main/cpp
+//       test/cpp/talking_state_test.cpp -o build/cpp_test/talking_state_test
+
+#include "talking_state.h"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+
+#define CHECK(cond)                                                          \
+    do {                                                                     \
+        if (!(cond)) {                                                       \
+            std::cerr << "CHECK failed: " #cond                              \
+                      << " (" << __FILE__ << ":" << __LINE__ << ")"          \
+                      << std::endl;                                          \
+            std::exit(1);                                                    \
+        }                                                                    \
+    } while (0)
+
+// publish() reports only real changes; levels are kept per slot.
+void testPublishReportsChanges() {
+    TalkingState ts;
+    CHECK(ts.mask() == 0);
+    CHECK(!ts.publish(0));
+    CHECK(ts.publish(0b101));
+    CHECK(!ts.publish(0b101));
+    CHECK(ts.mask() == 0b101);
+
+    ts.setLevel(2, 1234);
+    CHECK(ts.level(2) == 1234 && ts.level(3) == 0);
+    ts.reset();
+    CHECK(ts.mask() == 0 && ts.level(2) == 0);
+    std::cout << "Test Publish Reports Changes: PASSED" << std::endl;
+}
+
+// Edges published while the notifier is away collapse into one wake with
+// the latest mask; an edge that reverts before it looks sends nothing.
+void testNotifierCoalescesToLatest() {
+    TalkingState ts;
+    uint32_t mask = 0;
+    ts.publish(0b1);
+    ts.publish(0b11);
+    ts.publish(0b10);
+    CHECK(ts.waitForChange(0, &mask));
+    CHECK(mask == 0b10);
+
+    // Flip and flip back: nothing to send relative to 0b10. A stop() is the
+    // only thing that can end this wait.
+    ts.publish(0b0);
+    ts.publish(0b10);
+    std::thread stopper([&] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        ts.stop();
+    });
+    CHECK(!ts.waitForChange(0b10, &mask));
+    stopper.join();
+    std::cout << "Test Notifier Coalesces To Latest: PASSED" << std::endl;
+}
+
+// A publish from another thread wakes a parked notifier; a resend request
+// wakes it with an unchanged mask; restart() re-arms it after stop().
+void testWakesOnPublishAndResend() {
+    TalkingState ts;
+    uint32_t mask = 0;
+    std::thread mixer([&] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        ts.publish(0x8000);
+    });
+    CHECK(ts.waitForChange(0, &mask));
+    CHECK(mask == 0x8000);
+    mixer.join();
+
+    std::thread jni([&] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        ts.requestResend();
+    });
+    CHECK(ts.waitForChange(0x8000, &mask));
+    CHECK(mask == 0x8000);
+    jni.join();
+
+    ts.stop();
+    CHECK(!ts.waitForChange(0, &mask));
+    ts.restart();
+    ts.publish(0x1);
+    CHECK(ts.waitForChange(0x8000, &mask) && mask == 0x1);
+    std::cout << "Test Wakes On Publish And Resend: PASSED" << std::endl;
+}
+
+int main() {
+    testPublishReportsChanges();
+    testNotifierCoalescesToLatest();
+    testWakesOnPublishAndResend();
+    std::cout << "All TalkingState tests passed!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,133 @@
+// Host-buildable test for TickGovernor (header-only).
+//
+// Compile (see scripts/run_native_cpp_tests.sh):
+//   g++ -std=c++17 -Wall -Wextra -pthread -I android/app/src/main/cpp
+//       test/cpp/tick_governor_test.cpp -o build/cpp_test/tick_governor_test
+
+#include "tick_governor.h"
+
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+
+#define CHECK(cond)                                                          \
+    do {                                                                     \
+        if (!(cond)) {                                                       \
+            std::cerr << "CHECK failed: " #cond                              \
+                      << " (" << __FILE__ << ":" << __LINE__ << ")"          \
+                      << std::endl;                                          \
+            std::exit(1);                                                    \
+        }                                                                    \
+    } while (0)
+
+namespace {
+
+constexpr uint32_t kTickUs = audio_config::kMixerTickIntervalMs * 1000;
+constexpr uint32_t kOverUs = kTickUs * (audio_config::kGovernorBudgetPct + 10) / 100;
+constexpr uint32_t kCalmUs = kTickUs * (audio_config::kGovernorRecoverPct - 10) / 100;
+constexpr uint32_t kBandUs =
+    kTickUs * (audio_config::kGovernorBudgetPct + audio_config::kGovernorRecoverPct) / 200;
+
+// Feed one interval of ticks whose work totals `us`, split across the
+// phases. Returns what the interval's last record() said.
+bool interval(TickGovernor& g, uint32_t us) {
+    bool changed = false;
+    for (int i = 0; i < audio_config::kGovernorIntervalTicks; ++i) {
+        changed = g.record(us / 4, us / 4, us - us / 2);
+    }
+    return changed;
+}
+
+}  // namespace
+
+// Over budget steps down one level per interval, saturating at the bottom
+// of the ladder; the per-phase means are published.
+void testOverBudgetStepsDown() {
+    TickGovernor g;
+    for (int i = 1; i < audio_config::kGovernorIntervalTicks; ++i) {
+        CHECK(!g.record(kOverUs, 0, 0));
+    }
+    CHECK(g.level() == 0);
+    CHECK(g.record(kOverUs, 0, 0));
+    CHECK(g.level() == 1);
+    CHECK(g.meanDecodeUs() == kOverUs && g.meanEncodeUs() == 0);
+
+    for (int i = 0; i < 10; ++i) interval(g, kOverUs);
+    CHECK(g.level() == audio_config::kGovernorMaxLevel);
+    CHECK(!interval(g, kOverUs));
+    std::cout << "Test Over Budget Steps Down: PASSED" << std::endl;
+}
+
+// Between the thresholds the level holds; back up takes a run of calm
+// intervals, and a busy one in between restarts the count.
+void testRecoveryNeedsCalmRun() {
+    TickGovernor g;
+    interval(g, kOverUs);
+    interval(g, kOverUs);
+    CHECK(g.level() == 2);
+    for (int i = 0; i < 10; ++i) CHECK(!interval(g, kBandUs));
+    CHECK(g.level() == 2);
+
+    for (int i = 1; i < audio_config::kGovernorRecoverIntervals; ++i) {
+        CHECK(!interval(g, kCalmUs));
+    }
+    CHECK(!interval(g, kBandUs));  // not calm: the run starts over
+    for (int i = 1; i < audio_config::kGovernorRecoverIntervals; ++i) {
+        CHECK(!interval(g, kCalmUs));
+    }
+    CHECK(interval(g, kCalmUs));
+    CHECK(g.level() == 1);
+
+    for (int i = 0; i < 10 * audio_config::kGovernorRecoverIntervals; ++i) {
+        interval(g, kCalmUs);
+    }
+    CHECK(g.level() == 0);
+    g.reset();
+    CHECK(g.level() == 0 && g.meanMixUs() == 0);
+    std::cout << "Test Recovery Needs Calm Run: PASSED" << std::endl;
+}
+
+// The ladder: complexity falls level by level, FEC and the full-rate RMS go
+// part way down, and a protected peer trails — keeping FEC throughout.
+void testPlanProtectsPeers() {
+    TickGovernor::Plan p = TickGovernor::planFor(0, false);
+    CHECK(p.complexity == 10 && p.fec && p.rmsStride == 1);
+
+    int last = p.complexity;
+    for (int level = 1; level <= audio_config::kGovernorMaxLevel; ++level) {
+        p = TickGovernor::planFor(level, false);
+        CHECK(p.complexity < last);
+        last = p.complexity;
+        CHECK(p.fec == (level < audio_config::kGovernorFecOffLevel));
+        CHECK((p.rmsStride > 1) == (level >= audio_config::kGovernorRmsStrideLevel));
+
+        const TickGovernor::Plan guarded = TickGovernor::planFor(level, true);
+        CHECK(guarded.fec);
+        CHECK(guarded.complexity >= p.complexity);
+    }
+    CHECK(TickGovernor::planFor(audio_config::kGovernorProtectLevels, true).complexity == 10);
+    std::cout << "Test Plan Protects Peers: PASSED" << std::endl;
+}
+
+// The budget is a share of the tick actually run: work that sits in the
+// dead band at 20 ms ticks is over budget at the low-latency profile's 10 ms.
+void testBudgetFollowsTickInterval() {
+    TickGovernor g;
+    constexpr uint32_t kShortTickUs = audio_config::kLowLatencyFrameDurationMs * 1000;
+    interval(g, kBandUs);
+    CHECK(g.level() == 0);
+    for (int i = 0; i < audio_config::kGovernorIntervalTicks; ++i) {
+        g.record(kBandUs, 0, 0, kShortTickUs);
+    }
+    CHECK(g.level() == 1);
+    std::cout << "Test Budget Follows Tick Interval: PASSED" << std::endl;
+}
+
+int main() {
+    testOverBudgetStepsDown();
+    testRecoveryNeedsCalmRun();
+    testPlanProtectsPeers();
+    testBudgetFollowsTickInterval();
+    std::cout << "All TickGovernor tests passed!" << std::endl;
+    return 0;
+}
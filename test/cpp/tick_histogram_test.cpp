@@ -0,0 +1,112 @@
+// Host-buildable test for TickHistogram (header-only).
+//
+// Compile (see scripts/run_native_cpp_tests.sh):
+//   g++ -std=c++17 -Wall -Wextra -pthread -I android/app/src/main/cpp
+//       test/cpp/tick_histogram_test.cpp -o build/cpp_test/tick_histogram_test
+
+#include "tick_histogram.h"
+
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+
+#define CHECK(cond)                                                          \
+    do {                                                                     \
+        if (!(cond)) {                                                       \
+            std::cerr << "CHECK failed: " #cond                              \
+                      << " (" << __FILE__ << ":" << __LINE__ << ")"          \
+                      << std::endl;                                          \
+            std::exit(1);                                                    \
+        }                                                                    \
+    } while (0)
+
+void testEmptyReadsZero() {
+    TickHistogram h;
+    CHECK(h.count() == 0);
+    CHECK(h.percentileUs(0.99) == 0);
+    h.rollWindow();  // empty window publishes nothing
+    CHECK(h.publishedP99Us() == 0);
+    CHECK(h.publishedMaxUs() == 0);
+    std::cout << "Test Empty Reads Zero: PASSED" << std::endl;
+}
+
+// Percentiles resolve to the upper edge of the bucket holding the rank.
+void testPercentilesAtBucketResolution() {
+    TickHistogram h;
+    // 99 samples at 150 µs (bucket 1) and one at 2 050 µs (bucket 20).
+    for (int i = 0; i < 99; ++i) h.record(150);
+    h.record(2050);
+    CHECK(h.count() == 100);
+    CHECK(h.percentileUs(0.50) == 2 * TickHistogram::kBucketUs);
+    CHECK(h.percentileUs(0.99) == 2 * TickHistogram::kBucketUs);
+    CHECK(h.percentileUs(1.0) == 21 * TickHistogram::kBucketUs);
+    CHECK(h.windowMaxUs() == 2050);
+    std::cout << "Test Percentiles At Bucket Resolution: PASSED" << std::endl;
+}
+
+// Samples past the last linear bucket land in overflow and read as the max.
+void testOverflowReadsMax() {
+    TickHistogram h;
+    const uint32_t huge =
+        static_cast<uint32_t>(TickHistogram::kBuckets * TickHistogram::kBucketUs) * 5;
+    h.record(10);
+    h.record(huge);
+    CHECK(h.percentileUs(1.0) == huge);
+    CHECK(h.windowMaxUs() == huge);
+    std::cout << "Test Overflow Reads Max: PASSED" << std::endl;
+}
+
+void testRollWindowPublishesAndClears() {
+    TickHistogram h;
+    for (int i = 0; i < 100; ++i) h.record(i < 50 ? 40 : 940);
+    h.rollWindow();
+    CHECK(h.count() == 0);
+    CHECK(h.windowMaxUs() == 0);
+    CHECK(h.publishedP50Us() == TickHistogram::kBucketUs);
+    CHECK(h.publishedP99Us() == 10 * TickHistogram::kBucketUs);
+    CHECK(h.publishedMaxUs() == 940);
+
+    // The next window replaces the readout wholesale.
+    for (int i = 0; i < 10; ++i) h.record(250);
+    h.rollWindow();
+    CHECK(h.publishedP99Us() == 3 * TickHistogram::kBucketUs);
+    CHECK(h.publishedMaxUs() == 250);
+
+    h.reset();
+    CHECK(h.publishedP99Us() == 0);
+    std::cout << "Test Roll Window Publishes And Clears: PASSED" << std::endl;
+}
+
+// One writer recording and rolling while another thread reads the published
+// summary: no locks, so the reader must never block or see a value outside
+// what was recorded. (Run under TSan to check the atomics.)
+void testConcurrentReader() {
+    TickHistogram h;
+    std::atomic<bool> done{false};
+    std::thread reader([&] {
+        while (!done.load()) {
+            const uint32_t p99 = h.publishedP99Us();
+            CHECK(p99 == 0 || p99 == 5 * TickHistogram::kBucketUs);
+            CHECK(h.publishedMaxUs() <= 450);
+        }
+    });
+    for (int w = 0; w < 200; ++w) {
+        for (int i = 0; i < 250; ++i) h.record(450);
+        h.rollWindow();
+    }
+    done.store(true);
+    reader.join();
+    CHECK(h.publishedP99Us() == 5 * TickHistogram::kBucketUs);
+    std::cout << "Test Concurrent Reader: PASSED" << std::endl;
+}
+
+int main() {
+    testEmptyReadsZero();
+    testPercentilesAtBucketResolution();
+    testOverflowReadsMax();
+    testRollWindowPublishesAndClears();
+    testConcurrentReader();
+    std::cout << "All TickHistogram tests passed!" << std::endl;
+    return 0;
+}
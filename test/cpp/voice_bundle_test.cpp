@@ -0,0 +1,115 @@
+// Host-buildable test for voice_bundle.h (header-only).
+//
+// Compile (see scripts/run_native_cpp_tests.sh):
+//   g++ -std=c++17 -Wall -Wextra -pthread -I android/app/src/main/cpp
+//       test/cpp/voice_bundle_test.cpp -o build/cpp_test/voice_bundle_test
+
+#include "voice_bundle.h"
+
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#define CHECK(cond)                                                          \
+    do {                                                                     \
+        if (!(cond)) {                                                       \
+            std::cerr << "CHECK failed: " #cond                              \
+                      << " (" << __FILE__ << ":" << __LINE__ << ")"          \
+                      << std::endl;                                          \
+            std::exit(1);                                                    \
+        }                                                                    \
+    } while (0)
+
+namespace {
+
+using Frames = std::vector<std::vector<uint8_t>>;
+
+// Encode `frame` into the accumulator as the mixer tick would.
+void addFrame(BundleAccumulator& acc, uint32_t seq, uint32_t ts,
+              const std::vector<uint8_t>& frame) {
+    uint8_t* dst = acc.nextFrame();
+    CHECK(dst != nullptr);
+    std::copy(frame.begin(), frame.end(), dst);
+    acc.add(seq, ts, frame.size());
+}
+
+int unpackAll(const std::vector<uint8_t>& payload, Frames& out) {
+    return voice_bundle::unpack(
+        payload.data(), payload.size(),
+        [&](size_t i, const uint8_t* frame, size_t len) {
+            CHECK(i == out.size());
+            out.emplace_back(frame, frame + len);
+        });
+}
+
+}  // namespace
+
+// Three frames pack into one payload that unpacks to the same frames, in
+// order; the first frame's seq and timestamp head the VoiceFrame.
+void testRoundTrip() {
+    const Frames frames = {std::vector<uint8_t>(80, 0x11), {0x22},
+                           std::vector<uint8_t>(BundleAccumulator::kFrameCap, 0x33)};
+    BundleAccumulator acc;
+    for (size_t i = 0; i < frames.size(); ++i) {
+        addFrame(acc, 100 + static_cast<uint32_t>(i), 5000 + 20 * static_cast<uint32_t>(i),
+                 frames[i]);
+    }
+    CHECK(acc.nextFrame() == nullptr);
+    CHECK(acc.count() == 3 && acc.firstSeq() == 100 && acc.firstTsMs() == 5000);
+
+    std::vector<uint8_t> payload(acc.payloadBytes());
+    CHECK(payload.size() == voice_bundle::overheadBytes(3) + 81 +
+                                BundleAccumulator::kFrameCap);
+    CHECK(acc.flush(payload.data()) == payload.size());
+    CHECK(acc.count() == 0);
+    CHECK(voice_bundle::isBundle(payload.data(), payload.size()));
+
+    Frames out;
+    CHECK(unpackAll(payload, out) == 3);
+    CHECK(out == frames);
+    std::cout << "Test Round Trip: PASSED" << std::endl;
+}
+
+// One pending frame flushes as the bare Opus frame, which is not a bundle.
+void testSingleFramePassesThrough() {
+    BundleAccumulator acc;
+    addFrame(acc, 7, 7, {0x78, 0x01, 0x02});
+    std::vector<uint8_t> payload(acc.payloadBytes());
+    CHECK(acc.flush(payload.data()) == 3);
+    CHECK((payload == std::vector<uint8_t>{0x78, 0x01, 0x02}));
+    CHECK(!voice_bundle::isBundle(payload.data(), payload.size()));
+
+    uint8_t unused[1];
+    CHECK(acc.flush(unused) == 0);
+    std::cout << "Test Single Frame Passes Through: PASSED" << std::endl;
+}
+
+// Malformed bundles are rejected whole, before the sink sees any frame.
+void testMalformedRejected() {
+    const uint8_t m0 = audio_config::kBundleMagic0;
+    const uint8_t m1 = audio_config::kBundleMagic1;
+    const std::vector<std::vector<uint8_t>> bad = {
+        {m0, m1},                               // no count
+        {m0, m1, 1, 0xAA},                      // one frame
+        {m0, m1, 4, 0, 1, 0, 1, 0, 1, 1, 2, 3, 4},  // over kMaxBundleFrames
+        {m0, m1, 2, 0},                         // truncated length
+        {m0, m1, 2, 0, 0, 0xAA},                // empty first frame
+        {m0, m1, 2, 0, 2, 0xAA, 0xBB},          // no last frame
+        {m0, m1, 2, 0, 9, 0xAA},                // length overruns
+    };
+    for (const auto& payload : bad) {
+        Frames out;
+        CHECK(unpackAll(payload, out) == -1);
+        CHECK(out.empty());
+    }
+    std::cout << "Test Malformed Rejected: PASSED" << std::endl;
+}
+
+int main() {
+    testRoundTrip();
+    testSingleFramePassesThrough();
+    testMalformedRejected();
+    std::cout << "All voice_bundle tests passed!" << std::endl;
+    return 0;
+}
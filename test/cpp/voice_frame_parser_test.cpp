@@ -0,0 +1,194 @@
+// Host-buildable test for VoiceFrameParser (header-only).
+//
+// Compile (see scripts/run_native_cpp_tests.sh):
+//   g++ -std=c++17 -Wall -Wextra -pthread -I android/app/src/main/cpp
+//       test/cpp/voice_frame_parser_test.cpp -o build/cpp_test/voice_frame_parser_test
+
+#include "voice_frame_parser.h"
+
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <utility>
+#include <vector>
+
+#define CHECK(cond)                                                          \
+    do {                                                                     \
+        if (!(cond)) {                                                       \
+            std::cerr << "CHECK failed: " #cond                              \
+                      << " (" << __FILE__ << ":" << __LINE__ << ")"          \
+                      << std::endl;                                          \
+            std::exit(1);                                                    \
+        }                                                                    \
+    } while (0)
+
+namespace {
+
+struct Parsed {
+    uint32_t seq;
+    uint32_t senderTsMs;
+    std::vector<uint8_t> payload;
+};
+
+// Append one wire frame: length prefix, VoiceFrame header, payload.
+void appendFrame(std::vector<uint8_t>& wire, uint32_t seq, uint32_t ts,
+                 const std::vector<uint8_t>& payload) {
+    const size_t len = 8 + payload.size();
+    wire.push_back(static_cast<uint8_t>(len >> 8));
+    wire.push_back(static_cast<uint8_t>(len));
+    for (int shift = 24; shift >= 0; shift -= 8) wire.push_back(static_cast<uint8_t>(seq >> shift));
+    for (int shift = 24; shift >= 0; shift -= 8) wire.push_back(static_cast<uint8_t>(ts >> shift));
+    wire.insert(wire.end(), payload.begin(), payload.end());
+}
+
+int feedAll(VoiceFrameParser& p, const uint8_t* data, size_t n,
+            std::vector<Parsed>& out) {
+    return p.feed(data, n, [&](uint32_t seq, uint32_t ts, const uint8_t* payload,
+                               size_t len) {
+        out.push_back({seq, ts, std::vector<uint8_t>(payload, payload + len)});
+    });
+}
+
+}  // namespace
+
+void testSeveralFramesInOneFeed() {
+    std::vector<uint8_t> wire;
+    appendFrame(wire, 1, 0xA0B0C0D0u, {0x11, 0x22});
+    appendFrame(wire, 2, 7, {0x33});
+    appendFrame(wire, 0xFFFFFFFFu, 8, std::vector<uint8_t>(120, 0x44));
+
+    VoiceFrameParser p;
+    std::vector<Parsed> out;
+    CHECK(feedAll(p, wire.data(), wire.size(), out) == 3);
+    CHECK(out.size() == 3);
+    CHECK(out[0].seq == 1 && out[0].senderTsMs == 0xA0B0C0D0u);
+    CHECK(out[0].payload == std::vector<uint8_t>({0x11, 0x22}));
+    CHECK(out[1].seq == 2 && out[1].payload.size() == 1);
+    CHECK(out[2].seq == 0xFFFFFFFFu && out[2].payload.size() == 120);
+    std::cout << "Test Several Frames In One Feed: PASSED" << std::endl;
+}
+
+// Any split of the stream — down to one byte per read, including inside the
+// prefix — yields the same frames.
+void testFramesSplitAcrossFeeds() {
+    std::vector<uint8_t> wire;
+    for (uint32_t s = 0; s < 5; ++s) {
+        appendFrame(wire, s, s * 20, std::vector<uint8_t>(10 + s, static_cast<uint8_t>(s)));
+    }
+    for (size_t chunk : {size_t{1}, size_t{3}, size_t{17}}) {
+        VoiceFrameParser p;
+        std::vector<Parsed> out;
+        int total = 0;
+        for (size_t pos = 0; pos < wire.size(); pos += chunk) {
+            const size_t n = std::min(chunk, wire.size() - pos);
+            const int r = feedAll(p, wire.data() + pos, n, out);
+            CHECK(r >= 0);
+            total += r;
+        }
+        CHECK(total == 5);
+        for (uint32_t s = 0; s < 5; ++s) {
+            CHECK(out[s].seq == s && out[s].senderTsMs == s * 20);
+            CHECK(out[s].payload.size() == 10 + s);
+            CHECK(out[s].payload.back() == static_cast<uint8_t>(s));
+        }
+    }
+    std::cout << "Test Frames Split Across Feeds: PASSED" << std::endl;
+}
+
+// A VoiceFrame with no room for a header and payload is dropped, and the
+// frames after it still parse.
+void testShortFrameDroppedAndStreamContinues() {
+    std::vector<uint8_t> wire = {0x00, 0x03, 0x01, 0x02, 0x03};  // 3-byte frame
+    std::vector<uint8_t> headerOnly = {0x00, 0x08, 0, 0, 0, 9, 0, 0, 0, 9};
+    wire.insert(wire.end(), headerOnly.begin(), headerOnly.end());
+    appendFrame(wire, 42, 1, {0x55});
+
+    VoiceFrameParser p;
+    std::vector<Parsed> out;
+    CHECK(feedAll(p, wire.data(), wire.size(), out) == 1);
+    CHECK(out.size() == 1 && out[0].seq == 42);
+    CHECK(p.shortFrameCount() == 2);
+    std::cout << "Test Short Frame Dropped And Stream Continues: PASSED" << std::endl;
+}
+
+void testBadLengthIsFatalUntilReset() {
+    VoiceFrameParser p;
+    std::vector<Parsed> out;
+    const uint8_t zero[] = {0x00, 0x00, 0xAA};
+    CHECK(feedAll(p, zero, sizeof(zero), out) == -1);
+    CHECK(p.failed());
+    std::vector<uint8_t> good;
+    appendFrame(good, 1, 1, {0x01});
+    CHECK(feedAll(p, good.data(), good.size(), out) == -1);
+
+    p.reset();
+    CHECK(feedAll(p, good.data(), good.size(), out) == 1);
+
+    // Over the cap, delivered a byte at a time so the slow path checks it.
+    const uint8_t tooLong[] = {0x10, 0x01};  // 4097
+    CHECK(feedAll(p, tooLong, 1, out) == 0);
+    CHECK(feedAll(p, tooLong + 1, 1, out) == -1);
+    CHECK(out.size() == 1);
+    std::cout << "Test Bad Length Is Fatal Until Reset: PASSED" << std::endl;
+}
+
+// With a control sink, a header-only VoiceFrame is a link-control frame:
+// the sink gets its seq and timestamp fields, and it isn't counted as short.
+void testHeaderOnlyFrameGoesToControlSink() {
+    std::vector<uint8_t> wire = {0x00, 0x08, 0, 0, 0, 1, 0, 0, 0, 3};
+    appendFrame(wire, 42, 1, {0x55});
+
+    VoiceFrameParser p;
+    std::vector<Parsed> out;
+    std::vector<std::pair<uint32_t, uint32_t>> control;
+    CHECK(p.feed(wire.data(), wire.size(),
+                 [&](uint32_t seq, uint32_t ts, const uint8_t* payload, size_t len) {
+                     out.push_back({seq, ts, std::vector<uint8_t>(payload, payload + len)});
+                 },
+                 [&](uint32_t opcode, uint32_t arg) { control.emplace_back(opcode, arg); }) == 1);
+    CHECK(out.size() == 1 && out[0].seq == 42);
+    CHECK(control.size() == 1 && control[0].first == 1 && control[0].second == 3);
+    CHECK(p.shortFrameCount() == 0);
+    std::cout << "Test Header Only Frame Goes To Control Sink: PASSED" << std::endl;
+}
+
+// A flagged prefix carries a compact header, extended against the last full
+// header on the stream; with no full header yet, the frame is dropped.
+void testCompactHeaderExtended() {
+    std::vector<uint8_t> wire = {0x80, 0x04, 0x05, 0x00, 0x64, 0x11};  // seq 5, ts 100
+    appendFrame(wire, 0x000001FF, 0x0001FFF0, {0x22});
+    // Next seq 0x200 (low byte 0x00), ts 0x20004 (low 16 bits 0x0004):
+    // both carried over their low-bit boundary.
+    const std::vector<uint8_t> compact = {0x80, 0x04, 0x00, 0x00, 0x04, 0x33};
+    wire.insert(wire.end(), compact.begin(), compact.end());
+
+    VoiceFrameParser p;
+    std::vector<Parsed> out;
+    CHECK(feedAll(p, wire.data(), wire.size(), out) == 2);
+    CHECK(p.unanchoredFrameCount() == 1);
+    CHECK(out[0].seq == 0x1FF && out[0].senderTsMs == 0x1FFF0);
+    CHECK(out[1].seq == 0x200 && out[1].senderTsMs == 0x20004);
+    CHECK((out[1].payload == std::vector<uint8_t>{0x33}));
+
+    // Split a byte at a time, through the carry path.
+    std::vector<uint8_t> more = {0x80, 0x04, 0x01, 0x00, 0x18, 0x44};
+    for (uint8_t b : more) CHECK(feedAll(p, &b, 1, out) >= 0);
+    CHECK(out.size() == 3 && out[2].seq == 0x201 && out[2].senderTsMs == 0x20018);
+
+    // A reset forgets the reference along with the stream.
+    p.reset();
+    CHECK(feedAll(p, more.data(), more.size(), out) == 0);
+    CHECK(p.unanchoredFrameCount() == 2);
+    std::cout << "Test Compact Header Extended: PASSED" << std::endl;
+}
+
+int main() {
+    testSeveralFramesInOneFeed();
+    testFramesSplitAcrossFeeds();
+    testShortFrameDroppedAndStreamContinues();
+    testBadLengthIsFatalUntilReset();
+    testHeaderOnlyFrameGoesToControlSink();
+    testCompactHeaderExtended();
+    std::cout << "All VoiceFrameParser tests passed!" << std::endl;
+    return 0;
+}
@@ -30,6 +30,8 @@ void main() {
                 case 'startLoopbackTest':
                 case 'stopLoopbackTest':
                 case 'setMuted':
+                case 'setLowLatencyProfile':
+                case 'setPreRoll':
                 case 'setAudioOutput':
                 case 'connectVoiceClient':
                 case 'stopVoiceTransport':
@@ -151,6 +153,22 @@ void main() {
       ]);
     });
 
+    test('setLowLatencyProfile forwards the flag in the args', () async {
+      expect(await audioService.setLowLatencyProfile(true), true);
+      expect(await audioService.setLowLatencyProfile(false), true);
+      expect(log, <Matcher>[
+        isMethodCall('setLowLatencyProfile', arguments: {'enabled': true}),
+        isMethodCall('setLowLatencyProfile', arguments: {'enabled': false}),
+      ]);
+    });
+
+    test('setPreRoll forwards the flag in the args', () async {
+      expect(await audioService.setPreRoll(true), true);
+      expect(log, <Matcher>[
+        isMethodCall('setPreRoll', arguments: {'enabled': true}),
+      ]);
+    });
+
     test(
       'getConnectedDevices calls correct method and parses result',
       () async {
@@ -653,6 +671,16 @@ void main() {
         expect(await audioService.setMuted(true), false);
       });
 
+      test('setLowLatencyProfile returns false', () async {
+        installFailing();
+        expect(await audioService.setLowLatencyProfile(true), false);
+      });
+
+      test('setPreRoll returns false', () async {
+        installFailing();
+        expect(await audioService.setPreRoll(true), false);
+      });
+
       test('setAudioOutput returns false', () async {
         installFailing();
         expect(await audioService.setAudioOutput('speaker'), false);
@@ -746,6 +774,11 @@ void main() {
         expect(await audioService.getLinkTelemetry('AA:BB'), isNull);
       });
 
+      test('getRoomTelemetry returns empty', () async {
+        installFailing();
+        expect(await audioService.getRoomTelemetry(), isEmpty);
+      });
+
       test('getInitialLink returns null on error', () async {
         installFailing();
         expect(await audioService.getInitialLink(), isNull);
@@ -893,9 +926,14 @@ void main() {
 
       test('getLinkTelemetry returns parsed snapshot', () async {
         // Layout: [underrun, late, target, current, bitrate, lost, lagMs,
-        // staleDrops, recv, lastSeq, ringUnderReadCount, ringOverwriteCount].
+        // staleDrops, recv, lastSeq, ringUnderReadCount, ringOverwriteCount,
+        // clockDriftPpm, tickLateP99Us, tickWorkP99Us, tickOverrunCount,
+        // arrivalDropCount, outboundStaleDropCount, outboundFullDropCount,
+        // outboundDepth, outboundSkipCount, bitrateBackoffCount,
+        // expectedLossPct, outboundFramesPerPacket, encoderComplexity,
+        // governorLevel].
         handler = (_) async =>
-            [10, 5, 8, 4, 16000, 3, 120, 7, 2500, 4242, 99, 13];
+            [10, 5, 8, 4, 16000, 3, 120, 7, 2500, 4242, 99, 13, 42, 300, 1800, 6, 11, 12, 1, 2, 9, 4, 3, 2, 6, 2];
         final snap = await audioService.getLinkTelemetry('AA:BB');
         expect(snap, isNotNull);
         expect(snap!.underrunCount, 10);
@@ -910,6 +948,20 @@ void main() {
         expect(snap.lastSeq, 4242);
         expect(snap.ringUnderReadCount, 99);
         expect(snap.ringOverwriteCount, 13);
+        expect(snap.clockDriftPpm, 42);
+        expect(snap.tickLateP99Us, 300);
+        expect(snap.tickWorkP99Us, 1800);
+        expect(snap.tickOverrunCount, 6);
+        expect(snap.arrivalDropCount, 11);
+        expect(snap.outboundStaleDropCount, 12);
+        expect(snap.outboundFullDropCount, 1);
+        expect(snap.outboundDepth, 2);
+        expect(snap.outboundSkipCount, 9);
+        expect(snap.bitrateBackoffCount, 4);
+        expect(snap.expectedLossPct, 3);
+        expect(snap.outboundFramesPerPacket, 2);
+        expect(snap.encoderComplexity, 6);
+        expect(snap.governorLevel, 2);
       });
 
       test('getLinkTelemetry parses an Int32List payload', () async {
@@ -917,7 +969,7 @@ void main() {
         // plain List — the parser is written to accept either. Guard that
         // platform-typed-list path explicitly.
         handler = (_) async =>
-            Int32List.fromList([10, 5, 8, 4, 16000, 3, 120, 7, 2500, 4242, 99, 13]);
+            Int32List.fromList([10, 5, 8, 4, 16000, 3, 120, 7, 2500, 4242, 99, 13, 42, 300, 1800, 6, 0, 0, 0, 0, 0, 0, 0, 1, 10, 0]);
         final snap = await audioService.getLinkTelemetry('AA:BB');
         expect(snap, isNotNull);
         expect(snap!.underrunCount, 10);
@@ -937,24 +989,43 @@ void main() {
         const int negRecvCount = -100;
         const int negRingUnder = -42;
         handler = (_) async =>
-            [10, 5, 8, 4, 16000, 3, negLagMs, 7, negRecvCount, negLastSeq, negRingUnder, 0];
+            [10, 5, 8, 4, 16000, 3, negLagMs, 7, negRecvCount, negLastSeq, negRingUnder, 0, -35, 0, 0, -7, -3, 0, 0, 0, -5, 0, 0, 1, 10, 0];
         final snap = await audioService.getLinkTelemetry('AA:BB');
         expect(snap, isNotNull);
         expect(snap!.lastSeq, 0xFFFFFFFF);
         expect(snap.currentLagMs, 0x80000000);
         expect(snap.recvCount, 0xFFFFFF9C); // (-100).toUnsigned(32)
         expect(snap.ringUnderReadCount, 0xFFFFFFD6); // (-42).toUnsigned(32)
+        // clockDriftPpm is genuinely signed — a slow peer clock stays negative.
+        expect(snap.clockDriftPpm, -35);
+        expect(snap.tickOverrunCount, 0xFFFFFFF9); // (-7).toUnsigned(32)
+        expect(snap.arrivalDropCount, 0xFFFFFFFD); // (-3).toUnsigned(32)
+        expect(snap.outboundSkipCount, 0xFFFFFFFB); // (-5).toUnsigned(32)
       });
 
       test('getLinkTelemetry returns null on wrong shape (length)', () async {
-        handler = (_) async => [1, 2, 3]; // not 12 elements
+        handler = (_) async => [1, 2, 3]; // not 26 elements
         expect(await audioService.getLinkTelemetry('AA:BB'), isNull);
       });
 
       test('getLinkTelemetry returns null on wrong type element', () async {
-        // 12 elements so the length check passes and the element-type check
+        // 26 elements so the length check passes and the element-type check
         // is what rejects it.
         handler = (_) async => [
+          0,
+          0,
+          0,
+          0,
+          0,
+          0,
+          0,
+          0,
+          0,
+          0,
+          0,
+          0,
+          0,
+          0,
           1,
           2,
           3,
@@ -979,6 +1050,28 @@ void main() {
         },
       );
 
+      test('getRoomTelemetry parses every peer and drops bad entries', () async {
+        handler = (_) async => <dynamic, dynamic>{
+          'AA:BB': Int32List.fromList(
+            [1, 0, 4, 3, 32000, 0, 40, 0, 900, 77, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 1, 10, 0],
+          ),
+          'CC:DD': [2, 0, 4, 3, 32000, 0, 40, 0, 800, 66, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 10, 0],
+          'EE:FF': [1, 2, 3], // wrong shape: dropped, not fatal
+        };
+        log.clear();
+        final room = await audioService.getRoomTelemetry();
+        expect(log, [isMethodCall('getRoomTelemetry', arguments: null)]);
+        expect(room.keys, unorderedEquals(['AA:BB', 'CC:DD']));
+        expect(room['AA:BB']!.recvCount, 900);
+        expect(room['AA:BB']!.outboundDepth, 1);
+        expect(room['CC:DD']!.lastSeq, 66);
+      });
+
+      test('getRoomTelemetry returns empty on non-map', () async {
+        handler = (_) async => 'nope';
+        expect(await audioService.getRoomTelemetry(), isEmpty);
+      });
+
       test('getInitialLink returns freq string from native', () async {
         handler = (call) async {
           if (call.method == 'getInitialLink') return '104.3';